@@ -3,39 +3,107 @@
 // Authors: Matthieu Delaere
 /*=============================================================================*/
 // EBlackboard.h: Blackboard implementation
+// Every key name is registered once and gets a process-wide index, a blackboard keeps the offset of every key it has
+// at that index and the values themselves in one byte array. Resolve a BlackboardKey once (e.g. as a global) and the
+// lookups are two array accesses without hashing, strings or RTTI:
+//		const Elite::BlackboardKey<AgarioAgent*> AgentKey{ "Agent" };
+//		AgarioAgent* pAgent;
+//		if (!pBlackboard->GetData(AgentKey, pAgent)) ...
+// The name based functions do the same after looking the name up once, for existing code and debugging.
+// Values are copied in and out with memcpy, so only trivially copyable types (pointers, numbers, Vector2, ...) fit.
+// Every value has a version that goes up when ChangeData writes a value that isn't operator== to the current one (bytes
+// would also compare padding), observers (e.g. the conditionals of an event-driven FlatBehaviorTree) compare versions
+// instead of values to see what changed.
 /*=============================================================================*/
 #ifndef ELITE_BLACKBOARD
 #define ELITE_BLACKBOARD
 
 //Includes
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Elite
 {
 	//-----------------------------------------------------------------
-	// BLACKBOARD TYPES (BASE)
+	// BLACKBOARD KEYS
 	//-----------------------------------------------------------------
-	class IBlackBoardField
+	class BlackboardKeyRegistry final
 	{
 	public:
-		IBlackBoardField() = default;
-		virtual ~IBlackBoardField() = default;
+		static const unsigned int InvalidIndex = ~0u;
+
+		//Index of the name, registered on first use
+		static unsigned int GetIndex(const std::string& name)
+		{
+			BlackboardKeyRegistry& registry = GetInstance();
+			std::lock_guard<std::mutex> lock{ registry.m_Mutex };
+			const auto it = registry.m_Indices.find(name);
+			if (it != registry.m_Indices.end())
+				return it->second;
+
+			registry.m_Names.push_back(name);
+			return registry.m_Indices[name] = static_cast<unsigned int>(registry.m_Names.size() - 1);
+		}
+
+		//InvalidIndex when no key has that name
+		static unsigned int FindIndex(const std::string& name)
+		{
+			BlackboardKeyRegistry& registry = GetInstance();
+			std::lock_guard<std::mutex> lock{ registry.m_Mutex };
+			const auto it = registry.m_Indices.find(name);
+			return it != registry.m_Indices.end() ? it->second : InvalidIndex;
+		}
+
+		static std::string GetName(unsigned int index)
+		{
+			BlackboardKeyRegistry& registry = GetInstance();
+			std::lock_guard<std::mutex> lock{ registry.m_Mutex };
+			return index < registry.m_Names.size() ? registry.m_Names[index] : std::string{};
+		}
+
+	private:
+		//Keys are often globals, so the registry can't be one
+		static BlackboardKeyRegistry& GetInstance()
+		{
+			static BlackboardKeyRegistry registry{};
+			return registry;
+		}
+
+		std::mutex m_Mutex;
+		std::unordered_map<std::string, unsigned int> m_Indices;
+		std::vector<std::string> m_Names;
 	};
 
-	//BlackboardField does not take ownership of pointers whatsoever!
 	template<typename T>
-	class BlackboardField : public IBlackBoardField
+	class BlackboardKey final
 	{
 	public:
-		explicit BlackboardField(T data) : m_Data(data)
+		using ValueType = T;
+
+		explicit BlackboardKey(const std::string& name)
+			: m_Index(BlackboardKeyRegistry::GetIndex(name))
 		{}
-		T GetData() { return m_Data; };
-		void SetData(T data) { m_Data = data; }
+		unsigned int GetIndex() const { return m_Index; }
+		std::string GetName() const { return BlackboardKeyRegistry::GetName(m_Index); }
 
 	private:
-		T m_Data;
+		unsigned int m_Index;
 	};
 
+	//True when two const T can be compared with ==
+	template<typename T, typename = void>
+	struct IsEqualityComparable : std::false_type {};
+	template<typename T>
+	struct IsEqualityComparable<T, decltype(void(std::declval<const T&>() == std::declval<const T&>()))> : std::true_type {};
+
 	//-----------------------------------------------------------------
 	// BLACKBOARD (BASE)
 	//-----------------------------------------------------------------
@@ -43,12 +111,7 @@ namespace Elite
 	{
 	public:
 		Blackboard() = default;
-		~Blackboard()
-		{
-			for (auto el : m_BlackboardData)
-				SAFE_DELETE(el.second);
-			m_BlackboardData.clear();
-		}
+		~Blackboard() = default;
 
 		Blackboard(const Blackboard& other) = delete;
 		Blackboard& operator=(const Blackboard& other) = delete;
@@ -56,50 +119,158 @@ namespace Elite
 		Blackboard& operator=(Blackboard&& other) = delete;
 
 		//Add data to the blackboard
-		template<typename T> bool AddData(const std::string& name, T data)
+		template<typename T> bool AddData(const BlackboardKey<T>& key, const typename BlackboardKey<T>::ValueType& data)
 		{
-			auto it = m_BlackboardData.find(name);
-			if (it == m_BlackboardData.end())
+			static_assert(std::is_trivially_copyable<T>::value, "Blackboard data is copied with memcpy");
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Blackboard data can't be over-aligned");
+
+			const unsigned int index = key.GetIndex();
+			if (index < m_Slots.size() && m_Slots[index].offset != InvalidOffset)
 			{
-				m_BlackboardData[name] = new BlackboardField<T>(data);
-				return true;
+				printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", key.GetName().c_str(), typeid(T).name());
+				return false;
 			}
-			printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", name.c_str(), typeid(T).name());
-			return false;
+
+			if (index >= m_Slots.size())
+				m_Slots.resize(index + 1);
+
+			const size_t offset = (m_Data.size() + alignof(T) - 1) / alignof(T) * alignof(T);
+			m_Data.resize(offset + sizeof(T));
+			memcpy(m_Data.data() + offset, &data, sizeof(T));
+			m_Slots[index] = Slot{ static_cast<unsigned int>(offset), 0, GetTypeId<T>() };
+			return true;
 		}
 
 		//Change the data of the blackboard
-		template<typename T> bool ChangeData(const std::string& name, T data)
+		template<typename T> bool ChangeData(const BlackboardKey<T>& key, const typename BlackboardKey<T>::ValueType& data)
 		{
-			auto it = m_BlackboardData.find(name);
-			if (it != m_BlackboardData.end())
+			if (!ChangeSlotData(key.GetIndex(), data))
 			{
-				BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
-				if (p)
-				{
-					p->SetData(data);
-					return true;
-				}
+				printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", key.GetName().c_str(), typeid(T).name());
+				return false;
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
-			return false;
+			return true;
 		}
 
 		//Get the data from the blackboard
-		template<typename T> bool GetData(const std::string& name, T& data)
+		template<typename T> bool GetData(const BlackboardKey<T>& key, T& data) const
+		{
+			if (!GetSlotData(key.GetIndex(), data))
+			{
+				printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", key.GetName().c_str(), typeid(T).name());
+				return false;
+			}
+			return true;
+		}
+
+		//Name based versions, look the name up once per call (a single registry lock) and then take the key path
+		template<typename T> bool AddData(const std::string& name, T data)
+		{
+			return AddData(BlackboardKey<T>{ name }, data);
+		}
+
+		template<typename T> bool ChangeData(const std::string& name, T data)
 		{
-			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
-			if (p != nullptr)
+			if (!ChangeSlotData(BlackboardKeyRegistry::FindIndex(name), data))
 			{
-				data = p->GetData();
-				return true;
+				printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+				return false;
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
-			return false;
+			return true;
+		}
+
+		template<typename T> bool GetData(const std::string& name, T& data) const
+		{
+			if (!GetSlotData(BlackboardKeyRegistry::FindIndex(name), data))
+			{
+				printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+				return false;
+			}
+			return true;
+		}
+
+		//Number of times the data changed, zero when it's not on the blackboard
+		unsigned int GetVersion(unsigned int index) const
+		{
+			return index < m_Slots.size() ? m_Slots[index].version : 0;
+		}
+		template<typename T> unsigned int GetVersion(const BlackboardKey<T>& key) const
+		{
+			return GetVersion(key.GetIndex());
+		}
+
+		bool HasData(const std::string& name) const
+		{
+			const unsigned int index = BlackboardKeyRegistry::FindIndex(name);
+			return index < m_Slots.size() && m_Slots[index].offset != InvalidOffset;
+		}
+
+		//Names of all data on the blackboard, for debugging
+		std::vector<std::string> GetDataNames() const
+		{
+			std::vector<std::string> names{};
+			for (unsigned int index = 0; index < m_Slots.size(); ++index)
+			{
+				if (m_Slots[index].offset != InvalidOffset)
+					names.push_back(BlackboardKeyRegistry::GetName(index));
+			}
+			return names;
 		}
 
 	private:
-		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+		static const unsigned int InvalidOffset = ~0u;
+
+		struct Slot
+		{
+			unsigned int offset = InvalidOffset;
+			unsigned int version = 0;
+			const void* typeId = nullptr;
+		};
+
+		//Unique address per type, stands in for typeid on the lookups
+		template<typename T> static const void* GetTypeId()
+		{
+			static char id;
+			return &id;
+		}
+
+		//InvalidOffset when the blackboard has no data of type T at that index
+		template<typename T> unsigned int GetOffset(unsigned int index) const
+		{
+			if (index >= m_Slots.size() || m_Slots[index].typeId != GetTypeId<T>())
+				return InvalidOffset;
+			return m_Slots[index].offset;
+		}
+
+		//False when the blackboard has no data of type T at that index
+		template<typename T> bool ChangeSlotData(unsigned int index, const T& data)
+		{
+			static_assert(IsEqualityComparable<T>::value, "Blackboard data needs an operator== to see if ChangeData changed it");
+
+			const unsigned int offset = GetOffset<T>(index);
+			if (offset == InvalidOffset)
+				return false;
+
+			//An equal value keeps the version, so observers don't see a change. It's still written: operator== can have a tolerance (Vector2).
+			T current;
+			memcpy(&current, m_Data.data() + offset, sizeof(T));
+			if (!(current == data))
+				++m_Slots[index].version;
+			memcpy(m_Data.data() + offset, &data, sizeof(T));
+			return true;
+		}
+		template<typename T> bool GetSlotData(unsigned int index, T& data) const
+		{
+			const unsigned int offset = GetOffset<T>(index);
+			if (offset == InvalidOffset)
+				return false;
+
+			memcpy(&data, m_Data.data() + offset, sizeof(T));
+			return true;
+		}
+
+		std::vector<Slot> m_Slots; //By key index
+		std::vector<unsigned char> m_Data;
 	};
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,146 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EAIScheduler.cpp: Spreads the decision making of many agents over the frames, within a time budget per frame.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EAIScheduler.h"
+using namespace Elite;
+
+AIScheduler::AIScheduler(float budgetMs, std::vector<int> tierIntervals)
+	: m_BudgetMs(budgetMs)
+{
+	SetTierIntervals(std::move(tierIntervals));
+}
+
+void AIScheduler::SetTierIntervals(std::vector<int> tierIntervals)
+{
+	if (tierIntervals.empty())
+		tierIntervals.push_back(1);
+	for (int& interval : tierIntervals)
+		interval = std::max(interval, 1);
+	m_TierIntervals = std::move(tierIntervals);
+}
+
+void AIScheduler::Update(float deltaTime)
+{
+	ELITE_PROFILE_SCOPE("AIScheduler::Update");
+	const std::vector<ScheduledTick>& ticks{ Schedule(deltaTime) };
+
+	const auto start = std::chrono::high_resolution_clock::now();
+	const auto getUsedMs = [&start]()
+	{
+		return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	};
+
+	//The estimate can be off, whatever doesn't fit anymore still ticks (it was taken off the due list) but shows in the profiler
+	size_t idx{ 0 };
+	for (; idx < ticks.size() && getUsedMs() <= m_BudgetMs; ++idx)
+		ticks[idx].pDecisionMaking->Update(ticks[idx].deltaTime);
+	if (idx < ticks.size())
+	{
+		ELITE_PROFILE_SCOPE("AIScheduler::OverBudget");
+		for (; idx < ticks.size(); ++idx)
+			ticks[idx].pDecisionMaking->Update(ticks[idx].deltaTime);
+	}
+
+	EndFrame(getUsedMs());
+}
+
+const std::vector<AIScheduler::ScheduledTick>& AIScheduler::Schedule(float deltaTime)
+{
+	++m_FrameIdx;
+	m_ScheduledTicks.clear();
+	m_DueAgents.clear();
+	m_Stats = {};
+	m_Stats.nrOfAgents = GetSize();
+	m_Stats.budgetMs = m_BudgetMs;
+
+	//Agents ticking every frame go first, they tick over budget or not
+	for (const Agent& agent : m_Agents)
+	{
+		const int interval{ GetInterval(agent.tier) };
+		AgentState& state{ m_States[agent.pDecisionMaking->GetId()] };
+		if (state.lastFrame == 0)
+		{
+			//New agents are due straight away
+			state.framesSinceTick = interval;
+			state.timeSinceTick = deltaTime;
+		}
+		else
+		{
+			++state.framesSinceTick;
+			state.timeSinceTick += deltaTime;
+		}
+		state.lastFrame = m_FrameIdx;
+
+		if (!m_IsEnabled || interval == 1)
+			ScheduleTick(agent.pDecisionMaking, state);
+		else if (state.framesSinceTick >= interval)
+			m_DueAgents.push_back({ agent.priority + static_cast<float>(state.framesSinceTick - interval), agent.pDecisionMaking, &state });
+		else
+			m_Stats.maxFramesSinceTick = std::max(m_Stats.maxFramesSinceTick, state.framesSinceTick);
+	}
+	m_Stats.nrOfDue = static_cast<int>(m_ScheduledTicks.size() + m_DueAgents.size());
+
+	//As many of the other due agents as the estimate fits in what is left of the budget, at least one so they never stall.
+	//Without an estimate yet only one ticks, the estimate follows from its time.
+	int nrOfDueTicks{ std::min(static_cast<int>(m_DueAgents.size()), 1) };
+	if (m_AverageTickMs > 0.f && nrOfDueTicks > 0)
+	{
+		const float leftMs{ m_BudgetMs - m_ScheduledTicks.size() * m_AverageTickMs };
+		nrOfDueTicks = Clamp(static_cast<int>(leftMs / m_AverageTickMs), 1, static_cast<int>(m_DueAgents.size()));
+	}
+	if (nrOfDueTicks < static_cast<int>(m_DueAgents.size()))
+	{
+		std::nth_element(m_DueAgents.begin(), m_DueAgents.begin() + nrOfDueTicks, m_DueAgents.end(),
+			[](const DueAgent& a, const DueAgent& b) { return a.urgency > b.urgency; });
+	}
+	for (int i{ 0 }; i < nrOfDueTicks; ++i)
+		ScheduleTick(m_DueAgents[i].pDecisionMaking, *m_DueAgents[i].pState);
+
+	for (size_t i{ static_cast<size_t>(nrOfDueTicks) }; i < m_DueAgents.size(); ++i)
+		m_Stats.maxFramesSinceTick = std::max(m_Stats.maxFramesSinceTick, m_DueAgents[i].pState->framesSinceTick);
+	m_Stats.nrOfTicked = static_cast<int>(m_ScheduledTicks.size());
+	m_Stats.nrOfDeferred = m_Stats.nrOfDue - m_Stats.nrOfTicked;
+
+	//Drop the agents that weren't gathered, every gathered agent has an up to date state
+	if (m_States.size() > m_Agents.size())
+	{
+		for (auto it = m_States.begin(); it != m_States.end();)
+			it = it->second.lastFrame != m_FrameIdx ? m_States.erase(it) : std::next(it);
+	}
+
+	return m_ScheduledTicks;
+}
+
+void AIScheduler::EndFrame(float usedMs)
+{
+	m_Stats.usedMs = usedMs;
+	m_Stats.isOverBudget = usedMs > m_BudgetMs;
+
+	++m_NrOfFrames;
+	if (m_Stats.isOverBudget)
+	{
+		++m_NrOfOverBudgetFrames;
+		m_MaxOverBudgetMs = std::max(m_MaxOverBudgetMs, usedMs - m_BudgetMs);
+	}
+
+	if (m_Stats.nrOfTicked > 0)
+	{
+		const float tickMs{ usedMs / m_Stats.nrOfTicked };
+		m_AverageTickMs = m_AverageTickMs > 0.f ? Lerp(m_AverageTickMs, tickMs, 0.1f) : tickMs;
+	}
+}
+
+int AIScheduler::GetInterval(int tier) const
+{
+	return m_TierIntervals[Clamp(tier, 0, static_cast<int>(m_TierIntervals.size()) - 1)];
+}
+
+void AIScheduler::ScheduleTick(IDecisionMaking* pDecisionMaking, AgentState& state)
+{
+	m_ScheduledTicks.push_back({ pDecisionMaking, state.timeSinceTick });
+	state.framesSinceTick = 0;
+	state.timeSinceTick = 0.f;
+}
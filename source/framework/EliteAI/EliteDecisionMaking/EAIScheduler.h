@@ -0,0 +1,121 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EAIScheduler.h: Spreads the decision making of many agents over the frames, within a time budget per frame.
+// Every frame the agents are gathered with an LOD tier and a priority. The tier sets how often a decision is due
+// (by default tier 0 every frame, tier 1 every 4th and tier 2 every 16th frame). Agents with an interval of one frame
+// always tick. The other due agents tick in priority order for as long as the estimated cost fits the budget, at least
+// one per frame. A late agent gains one priority for every frame past its interval, so it can't starve.
+// Between ticks an agent keeps the steering its last decision set, so it keeps steering towards that target.
+// The stats of a frame tell whether it went over budget. In the profiler, the ticks past the budget show up under
+// "AIScheduler::OverBudget".
+/*=============================================================================*/
+#ifndef ELITE_AI_SCHEDULER
+#define ELITE_AI_SCHEDULER
+
+#include <unordered_map>
+#include <vector>
+#include "framework/EliteAI/EliteDecisionMaking/EDecisionMaking.h"
+
+namespace Elite
+{
+	struct AISchedulerStats final
+	{
+		int nrOfAgents = 0;
+		//Interval passed, or ticking every frame
+		int nrOfDue = 0;
+		int nrOfTicked = 0;
+		//Due but over budget, these are first in line next frame
+		int nrOfDeferred = 0;
+		//Age of the oldest decision after this frame
+		int maxFramesSinceTick = 0;
+		float usedMs = 0.f;
+		float budgetMs = 0.f;
+		bool isOverBudget = false;
+	};
+
+	class AIScheduler final
+	{
+	public:
+		struct ScheduledTick final
+		{
+			IDecisionMaking* pDecisionMaking;
+			//Time since the previous tick of this decision making
+			float deltaTime;
+		};
+
+		explicit AIScheduler(float budgetMs = 1.f, std::vector<int> tierIntervals = { 1, 4, 16 });
+
+		//The scheduler doesn't own the decision making, gather it again every frame.
+		//Tiers past the last interval use the last interval, a higher priority ticks first.
+		void Clear() { m_Agents.clear(); }
+		void Reserve(int size) { m_Agents.reserve(size); }
+		void Add(IDecisionMaking* pDecisionMaking, int tier = 0, float priority = 0.f) { m_Agents.push_back({ pDecisionMaking, tier, priority }); }
+		int GetSize() const { return static_cast<int>(m_Agents.size()); }
+
+		//Ticks the decision making that is due this frame
+		void Update(float deltaTime);
+
+		//For decision making that is ticked elsewhere (for instance in a BehaviorTreeBatch):
+		//Schedule picks the ticks of this frame and EndFrame takes the time they took
+		const std::vector<ScheduledTick>& Schedule(float deltaTime);
+		void EndFrame(float usedMs);
+
+		float GetBudgetMs() const { return m_BudgetMs; }
+		void SetBudgetMs(float budgetMs) { m_BudgetMs = budgetMs; }
+		const std::vector<int>& GetTierIntervals() const { return m_TierIntervals; }
+		void SetTierIntervals(std::vector<int> tierIntervals);
+		//Disabled, every agent ticks every frame
+		bool IsEnabled() const { return m_IsEnabled; }
+		void SetEnabled(bool isEnabled) { m_IsEnabled = isEnabled; }
+
+		const AISchedulerStats& GetStats() const { return m_Stats; }
+		int GetNrOfFrames() const { return m_NrOfFrames; }
+		int GetNrOfOverBudgetFrames() const { return m_NrOfOverBudgetFrames; }
+		float GetMaxOverBudgetMs() const { return m_MaxOverBudgetMs; }
+		void ResetOverBudgetFrames() { m_NrOfFrames = 0; m_NrOfOverBudgetFrames = 0; m_MaxOverBudgetMs = 0.f; }
+
+	private:
+		struct Agent final
+		{
+			IDecisionMaking* pDecisionMaking;
+			int tier;
+			float priority;
+		};
+		//Kept between frames by IDecisionMaking::GetId (a new decision making can reuse the address of a deleted one),
+		//dropped once the decision making isn't gathered anymore
+		struct AgentState final
+		{
+			int framesSinceTick = 0;
+			float timeSinceTick = 0.f;
+			unsigned int lastFrame = 0;
+		};
+		struct DueAgent final
+		{
+			float urgency;
+			IDecisionMaking* pDecisionMaking;
+			AgentState* pState;
+		};
+
+		int GetInterval(int tier) const;
+		void ScheduleTick(IDecisionMaking* pDecisionMaking, AgentState& state);
+
+		std::vector<Agent> m_Agents = {};
+		std::unordered_map<unsigned int, AgentState> m_States = {};
+		std::vector<DueAgent> m_DueAgents = {};
+		std::vector<ScheduledTick> m_ScheduledTicks = {};
+
+		float m_BudgetMs = 1.f;
+		std::vector<int> m_TierIntervals = {};
+		bool m_IsEnabled = true;
+
+		unsigned int m_FrameIdx = 0;
+		//Moving average of the time per tick, to estimate how many ticks fit in the budget
+		float m_AverageTickMs = 0.f;
+		AISchedulerStats m_Stats = {};
+		int m_NrOfFrames = 0;
+		int m_NrOfOverBudgetFrames = 0;
+		float m_MaxOverBudgetMs = 0.f;
+	};
+}
+#endif
@@ -9,16 +9,31 @@
 
 /* --- Data --- */
 //General Interface
+#include <atomic>
+
 namespace Elite
 {
 	class IDecisionMaking
 	{
 	public:
-		IDecisionMaking() = default;
+		IDecisionMaking() : m_Id(CreateId()) {}
+		IDecisionMaking(const IDecisionMaking&) : m_Id(CreateId()) {}
+		IDecisionMaking& operator=(const IDecisionMaking&) { return *this; }
 		virtual ~IDecisionMaking() = default;
 
 		virtual void Update(float deltaT) = 0;
 
+		//Unique for every decision making ever created, unlike its address (which a new one can get once it's deleted)
+		unsigned int GetId() const { return m_Id; }
+
+	private:
+		static unsigned int CreateId()
+		{
+			static std::atomic<unsigned int> nextId{ 1 };
+			return nextId++;
+		}
+
+		unsigned int m_Id;
 	};
 }
 
@@ -30,6 +45,11 @@ namespace Elite
 //FSM & BT
 #include "framework/EliteAI/EliteDecisionMaking/EliteFiniteStateMachine/EFiniteStateMachine.h"
 #include "framework/EliteAI/EliteDecisionMaking/EliteBehaviorTree/EBehaviorTree.h"
+#include "framework/EliteAI/EliteDecisionMaking/EliteBehaviorTree/EFlatBehaviorTree.h"
+#include "framework/EliteAI/EliteDecisionMaking/EliteBehaviorTree/EBehaviorTreeBatch.h"
+
+/* --- Scheduling --- */
+#include "framework/EliteAI/EliteDecisionMaking/EAIScheduler.h"
 
 
 #endif
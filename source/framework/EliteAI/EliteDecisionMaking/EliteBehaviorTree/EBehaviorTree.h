@@ -12,6 +12,8 @@
 
 namespace Elite
 {
+	class FlatBehaviorTree;
+
 	//-----------------------------------------------------------------
 	// BEHAVIOR TREE HELPERS
 	//-----------------------------------------------------------------
@@ -57,6 +59,8 @@ namespace Elite
 
 	protected:
 		std::vector<IBehavior*> m_ChildBehaviors = {};
+
+		friend class FlatBehaviorTree;
 	};
 
 	//--- SELECTOR ---
@@ -103,10 +107,17 @@ namespace Elite
 	{
 	public:
 		explicit BehaviorConditional(std::function<bool(Blackboard*)> fp) : m_fpConditional(fp) {}
+		//An event-driven FlatBehaviorTree keeps the result until one of the observed keys changes
+		template<typename... T_Values>
+		BehaviorConditional(std::function<bool(Blackboard*)> fp, const BlackboardKey<T_Values>&... observedKeys)
+			: m_fpConditional(fp), m_ObservedKeys{ observedKeys.GetIndex()... } {}
 		virtual BehaviorState Execute(Blackboard* pBlackBoard) override;
 
 	private:
 		std::function<bool(Blackboard*)> m_fpConditional = nullptr;
+		std::vector<unsigned int> m_ObservedKeys = {};
+
+		friend class FlatBehaviorTree;
 	};
 
 	//-----------------------------------------------------------------
@@ -120,6 +131,8 @@ namespace Elite
 
 	private:
 		std::function<BehaviorState(Blackboard*)> m_fpAction = nullptr;
+
+		friend class FlatBehaviorTree;
 	};
 
 	//-----------------------------------------------------------------
@@ -138,6 +151,7 @@ namespace Elite
 
 		virtual void Update(float deltaTime) override
 		{
+			ELITE_PROFILE_SCOPE("BehaviorTree::Update");
 			if (m_pRootBehavior == nullptr)
 			{
 				m_CurrentState = BehaviorState::Failure;
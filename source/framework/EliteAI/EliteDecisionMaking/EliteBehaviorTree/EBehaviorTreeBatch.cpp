@@ -0,0 +1,27 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EBehaviorTreeBatch.cpp: Ticks the behavior trees of many agents at once, spread over the job system.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EBehaviorTreeBatch.h"
+using namespace Elite;
+
+void BehaviorTreeBatch::Tick()
+{
+	ELITE_PROFILE_SCOPE("BehaviorTreeBatch::Tick");
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	const auto tickRange = [this](int begin, int end)
+	{
+		for (int i{ begin }; i < end; ++i)
+			m_pInstances[i]->Tick();
+	};
+
+	if (m_IsMultithreaded)
+		JOBSYSTEM->ParallelFor(GetSize(), m_GrainSize, tickRange);
+	else
+		tickRange(0, GetSize());
+
+	m_LastTickMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
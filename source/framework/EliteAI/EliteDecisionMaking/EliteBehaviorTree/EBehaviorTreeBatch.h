@@ -0,0 +1,43 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EBehaviorTreeBatch.h: Ticks the behavior trees of many agents at once, spread over the job system.
+// Trees of a batch run concurrently, so their conditions may only read shared data and their actions may only write
+// their own blackboard (for instance a command that is applied to the agent after the batch).
+/*=============================================================================*/
+#ifndef ELITE_BEHAVIOR_TREE_BATCH
+#define ELITE_BEHAVIOR_TREE_BATCH
+
+//--- Includes ---
+#include "EFlatBehaviorTree.h"
+
+namespace Elite
+{
+	class BehaviorTreeBatch final
+	{
+	public:
+		explicit BehaviorTreeBatch(int grainSize = 32) : m_GrainSize(grainSize) {}
+
+		//The batch doesn't own the instances, gather them again every frame
+		void Clear() { m_pInstances.clear(); }
+		void Reserve(int size) { m_pInstances.reserve(size); }
+		void Add(BehaviorTreeInstance* pInstance) { m_pInstances.push_back(pInstance); }
+		int GetSize() const { return static_cast<int>(m_pInstances.size()); }
+
+		bool IsMultithreaded() const { return m_IsMultithreaded; }
+		void SetMultithreaded(bool isMultithreaded) { m_IsMultithreaded = isMultithreaded; }
+		int GetGrainSize() const { return m_GrainSize; }
+		void SetGrainSize(int grainSize) { m_GrainSize = grainSize; }
+
+		//Returns once every instance ticked
+		void Tick();
+		float GetLastTickMs() const { return m_LastTickMs; }
+
+	private:
+		std::vector<BehaviorTreeInstance*> m_pInstances = {};
+		int m_GrainSize = 32;
+		bool m_IsMultithreaded = true;
+		float m_LastTickMs = 0.f;
+	};
+}
+#endif
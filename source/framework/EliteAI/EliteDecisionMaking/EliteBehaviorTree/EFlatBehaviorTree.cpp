@@ -0,0 +1,279 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EFlatBehaviorTree.cpp: Behavior tree flattened into one node array, shared by every agent running it.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EFlatBehaviorTree.h"
+using namespace Elite;
+
+FlatBehaviorTree::FlatBehaviorTree(const IBehavior& rootBehavior)
+{
+	Flatten(rootBehavior, -1);
+	m_RunningNodeSlot = m_StateSize++;
+	m_KeysVersionSlot = m_StateSize++;
+}
+
+BehaviorState FlatBehaviorTree::Tick(Blackboard* pBlackboard, unsigned int* pState) const
+{
+	pState[m_RunningNodeSlot] = 0;
+	return ExecuteNode(0, TickContext{ pBlackboard, pState, false });
+}
+
+BehaviorState FlatBehaviorTree::TickEventDriven(Blackboard* pBlackboard, unsigned int* pState) const
+{
+	const TickContext context{ pBlackboard, pState, true };
+
+	//Versions only go up, so the sum changes when any observed key changed
+	unsigned int keysVersion{ 0 };
+	for (const unsigned int key : m_TreeObservedKeys)
+		keysVersion += pBlackboard->GetVersion(key);
+	const bool hasKeyChanged{ keysVersion != pState[m_KeysVersionSlot] };
+	pState[m_KeysVersionSlot] = keysVersion;
+
+	//Changed data can change the path through the tree, so that goes back to the root (the unchanged conditionals are cached)
+	const int runningNode{ GetRunningNode(pState) };
+	if (runningNode < 0 || hasKeyChanged)
+	{
+		pState[m_RunningNodeSlot] = 0;
+		return ExecuteNode(0, context);
+	}
+
+	return Resume(runningNode, context);
+}
+
+void FlatBehaviorTree::Flatten(const IBehavior& behavior, int parent)
+{
+	const int idx{ static_cast<int>(m_Nodes.size()) };
+	m_Nodes.push_back({});
+
+	//Derived types first, a partial sequence is a sequence
+	FlatBehaviorNode node{};
+	node.parent = parent;
+	if (const auto pComposite = dynamic_cast<const BehaviorComposite*>(&behavior))
+	{
+		if (dynamic_cast<const BehaviorPartialSequence*>(pComposite))
+		{
+			node.type = FlatBehaviorType::PartialSequence;
+			node.dataIdx = m_StateSize++;
+		}
+		else if (dynamic_cast<const BehaviorSequence*>(pComposite))
+			node.type = FlatBehaviorType::Sequence;
+		else if (dynamic_cast<const BehaviorSelector*>(pComposite))
+			node.type = FlatBehaviorType::Selector;
+		else
+			throw Elite_Exception("FlatBehaviorTree: unknown composite behavior");
+
+		for (const IBehavior* pChild : pComposite->m_ChildBehaviors)
+			Flatten(*pChild, idx);
+	}
+	else if (const auto pConditional = dynamic_cast<const BehaviorConditional*>(&behavior))
+	{
+		Conditional conditional{};
+		if (const auto ppFunction = pConditional->m_fpConditional.target<bool(*)(Blackboard*)>())
+			conditional.fp = *ppFunction;
+		if (!conditional.fp)
+			conditional.function = pConditional->m_fpConditional;
+
+		if (!pConditional->m_ObservedKeys.empty())
+		{
+			conditional.firstObservedKey = static_cast<int>(m_ObservedKeys.size());
+			conditional.nrOfObservedKeys = static_cast<int>(pConditional->m_ObservedKeys.size());
+			conditional.cacheSlot = m_StateSize;
+			m_StateSize += 2;
+
+			for (const unsigned int key : pConditional->m_ObservedKeys)
+			{
+				m_ObservedKeys.push_back(key);
+				if (std::find(m_TreeObservedKeys.begin(), m_TreeObservedKeys.end(), key) == m_TreeObservedKeys.end())
+					m_TreeObservedKeys.push_back(key);
+			}
+		}
+
+		node.type = FlatBehaviorType::Conditional;
+		node.dataIdx = static_cast<int>(m_Conditionals.size());
+		m_Conditionals.push_back(conditional);
+	}
+	else if (const auto pAction = dynamic_cast<const BehaviorAction*>(&behavior))
+	{
+		Action action{};
+		if (const auto ppFunction = pAction->m_fpAction.target<BehaviorState(*)(Blackboard*)>())
+			action.fp = *ppFunction;
+		if (!action.fp)
+			action.function = pAction->m_fpAction;
+
+		node.type = FlatBehaviorType::Action;
+		node.dataIdx = static_cast<int>(m_Actions.size());
+		m_Actions.push_back(action);
+	}
+	else
+		throw Elite_Exception("FlatBehaviorTree: unknown behavior");
+
+	node.skip = static_cast<int>(m_Nodes.size()) - idx;
+	m_Nodes[idx] = node;
+}
+
+inline BehaviorState FlatBehaviorTree::ExecuteChild(int idx, const TickContext& context) const
+{
+	//Leaves are the bulk of the nodes, running them in place saves the call and the switch over every node type
+	const FlatBehaviorType type{ m_Nodes[idx].type };
+	if (type == FlatBehaviorType::Conditional || type == FlatBehaviorType::Action)
+		return ExecuteLeaf(idx, context);
+	return ExecuteNode(idx, context);
+}
+
+inline BehaviorState FlatBehaviorTree::ExecuteConditional(const Conditional& conditional, Blackboard* pBlackboard) const
+{
+	if (conditional.fp)
+		return conditional.fp(pBlackboard) ? BehaviorState::Success : BehaviorState::Failure;
+	if (conditional.function)
+		return conditional.function(pBlackboard) ? BehaviorState::Success : BehaviorState::Failure;
+	return BehaviorState::Failure;
+}
+
+inline BehaviorState FlatBehaviorTree::ExecuteLeaf(int idx, const TickContext& context) const
+{
+	const FlatBehaviorNode& node{ m_Nodes[idx] };
+	if (node.type == FlatBehaviorType::Conditional)
+	{
+		const Conditional& conditional{ m_Conditionals[node.dataIdx] };
+		if (!context.isEventDriven || conditional.cacheSlot < 0)
+			return ExecuteConditional(conditional, context.pBlackboard);
+
+		unsigned int* pCache{ context.pState + conditional.cacheSlot };
+		const auto getKeysVersion = [this, &conditional, &context]()
+		{
+			unsigned int keysVersion{ 0 };
+			for (int i{ 0 }; i < conditional.nrOfObservedKeys; ++i)
+				keysVersion += context.pBlackboard->GetVersion(m_ObservedKeys[conditional.firstObservedKey + i]);
+			return keysVersion;
+		};
+
+		if (pCache[1] != 0 && pCache[0] == getKeysVersion())
+			return static_cast<BehaviorState>(pCache[1] - 1);
+
+		//Versioned after the evaluation, a conditional writing a key it observes doesn't invalidate itself
+		const BehaviorState state{ ExecuteConditional(conditional, context.pBlackboard) };
+		pCache[0] = getKeysVersion();
+		pCache[1] = static_cast<unsigned int>(state) + 1;
+		return state;
+	}
+
+	const Action& action{ m_Actions[node.dataIdx] };
+	BehaviorState state{ BehaviorState::Failure };
+	if (action.fp)
+		state = action.fp(context.pBlackboard);
+	else if (action.function)
+		state = action.function(context.pBlackboard);
+
+	if (state == BehaviorState::Running)
+		context.pState[m_RunningNodeSlot] = idx + 1;
+	return state;
+}
+
+//Same results as the Execute of the matching IBehavior
+BehaviorState FlatBehaviorTree::ExecuteNode(int idx, const TickContext& context) const
+{
+	const FlatBehaviorNode& node{ m_Nodes[idx] };
+
+	switch (node.type)
+	{
+	case FlatBehaviorType::Selector:
+		return ExecuteSelector(idx, idx + 1, context);
+
+	case FlatBehaviorType::Sequence:
+		return ExecuteSequence(idx, idx + 1, context);
+
+	case FlatBehaviorType::PartialSequence:
+	{
+		//The state slot holds the offset of the current child from the first one, so the child is found without walking its siblings
+		unsigned int& runningIdx{ context.pState[node.dataIdx] };
+		const int child{ idx + 1 + static_cast<int>(runningIdx) };
+		if (child < idx + node.skip)
+			return FinishPartialSequenceChild(idx, child, ExecuteChild(child, context), context);
+
+		runningIdx = 0;
+		return BehaviorState::Success;
+	}
+
+	case FlatBehaviorType::Conditional:
+	case FlatBehaviorType::Action:
+		return ExecuteLeaf(idx, context);
+	}
+
+	return BehaviorState::Failure;
+}
+
+BehaviorState FlatBehaviorTree::ExecuteSelector(int idx, int child, const TickContext& context) const
+{
+	const int end{ idx + m_Nodes[idx].skip };
+	for (; child < end; child += m_Nodes[child].skip)
+	{
+		const BehaviorState state{ ExecuteChild(child, context) };
+		if (state != BehaviorState::Failure)
+			return state;
+	}
+	return BehaviorState::Failure;
+}
+
+BehaviorState FlatBehaviorTree::ExecuteSequence(int idx, int child, const TickContext& context) const
+{
+	const int end{ idx + m_Nodes[idx].skip };
+	for (; child < end; child += m_Nodes[child].skip)
+	{
+		const BehaviorState state{ ExecuteChild(child, context) };
+		if (state != BehaviorState::Success)
+			return state;
+	}
+	return BehaviorState::Success;
+}
+
+BehaviorState FlatBehaviorTree::FinishPartialSequenceChild(int idx, int child, BehaviorState childState, const TickContext& context) const
+{
+	unsigned int& runningIdx{ context.pState[m_Nodes[idx].dataIdx] };
+	switch (childState)
+	{
+	case BehaviorState::Failure:
+		runningIdx = 0;
+		return BehaviorState::Failure;
+	case BehaviorState::Success:
+		//The next child runs next tick, so the partial sequence itself is the running node
+		runningIdx = static_cast<unsigned int>(child + m_Nodes[child].skip - idx - 1);
+		context.pState[m_RunningNodeSlot] = idx + 1;
+		return BehaviorState::Running;
+	case BehaviorState::Running:
+		return BehaviorState::Running;
+	}
+	return BehaviorState::Failure;
+}
+
+BehaviorState FlatBehaviorTree::Resume(int idx, const TickContext& context) const
+{
+	context.pState[m_RunningNodeSlot] = 0;
+	BehaviorState state{ ExecuteNode(idx, context) };
+
+	//Every composite above continues after the child that was running, like it would have if it ran this tick
+	for (int child{ idx }; state != BehaviorState::Running && m_Nodes[child].parent >= 0; child = m_Nodes[child].parent)
+	{
+		const int parent{ m_Nodes[child].parent };
+		const int nextChild{ child + m_Nodes[child].skip };
+		switch (m_Nodes[parent].type)
+		{
+		case FlatBehaviorType::Selector:
+			if (state == BehaviorState::Failure)
+				state = ExecuteSelector(parent, nextChild, context);
+			break;
+		case FlatBehaviorType::Sequence:
+			if (state == BehaviorState::Success)
+				state = ExecuteSequence(parent, nextChild, context);
+			break;
+		case FlatBehaviorType::PartialSequence:
+			state = FinishPartialSequenceChild(parent, child, state, context);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return state;
+}
@@ -0,0 +1,157 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EFlatBehaviorTree.h: Behavior tree flattened into one node array, shared by every agent running it.
+// The nodes are stored depth-first, every node knows the size of its subtree, so the next sibling is node + skip.
+// Everything a tree keeps between ticks (running children of partial sequences, the running node, cached conditionals)
+// lives per agent in a BehaviorTreeInstance (or any array of GetStateSize() zeroes).
+// Tick re-evaluates the tree from the root. TickEventDriven resumes at the node that was running and only goes back to
+// the root when a key observed by one of the conditionals changed, conditionals with observed keys keep their result
+// until one of those keys changes. Conditionals without observed keys are evaluated whenever they are reached.
+// This is an approximation of Tick: the conditionals above a running node are not checked again when it resumes, and a
+// cached conditional only sees what its keys capture. When a conditional's inputs change without one of its keys changing
+// (e.g. movement within a coarse cell that a hashed key stands for), its old result stands and the tick can differ from Tick.
+// Choose observed keys that capture everything a conditional reads, the Agario BT benchmark asserts that its keys do.
+/*=============================================================================*/
+#ifndef ELITE_FLAT_BEHAVIOR_TREE
+#define ELITE_FLAT_BEHAVIOR_TREE
+
+//--- Includes ---
+#include <memory>
+#include "EBehaviorTree.h"
+
+namespace Elite
+{
+	enum class FlatBehaviorType : unsigned char
+	{
+		Selector,
+		Sequence,
+		PartialSequence,
+		Conditional,
+		Action
+	};
+
+	struct FlatBehaviorNode final
+	{
+		FlatBehaviorType type = FlatBehaviorType::Action;
+		//Nodes in the subtree of this node, itself included
+		int skip = 1;
+		//-1 for the root
+		int parent = -1;
+		//Conditional or action index for leaves, state slot of the running child for partial sequences
+		int dataIdx = -1;
+	};
+
+	//-----------------------------------------------------------------
+	// FLAT BEHAVIOR TREE (shared tree definition)
+	//-----------------------------------------------------------------
+	class FlatBehaviorTree final
+	{
+	public:
+		//Copies the structure and callbacks of the tree, the behaviors stay owned by the caller
+		explicit FlatBehaviorTree(const IBehavior& rootBehavior);
+
+		//pState points to GetStateSize() values of the agent, zero on the first tick
+		BehaviorState Tick(Blackboard* pBlackboard, unsigned int* pState) const;
+		BehaviorState TickEventDriven(Blackboard* pBlackboard, unsigned int* pState) const;
+
+		int GetNrOfNodes() const { return static_cast<int>(m_Nodes.size()); }
+		int GetStateSize() const { return m_StateSize; }
+		const FlatBehaviorNode& GetNode(int idx) const { return m_Nodes[idx]; }
+		//-1 when no node was running after the last tick
+		int GetRunningNode(const unsigned int* pState) const { return static_cast<int>(pState[m_RunningNodeSlot]) - 1; }
+
+	private:
+		//Plain function pointers are called directly, anything else through the std::function
+		struct Conditional final
+		{
+			bool(*fp)(Blackboard*) = nullptr;
+			std::function<bool(Blackboard*)> function = nullptr;
+			//m_ObservedKeys[firstObservedKey...], the result is cached in two state slots (keys version, result + 1)
+			int firstObservedKey = 0;
+			int nrOfObservedKeys = 0;
+			int cacheSlot = -1;
+		};
+		struct Action final
+		{
+			BehaviorState(*fp)(Blackboard*) = nullptr;
+			std::function<BehaviorState(Blackboard*)> function = nullptr;
+		};
+		struct TickContext final
+		{
+			Blackboard* pBlackboard;
+			unsigned int* pState;
+			bool isEventDriven;
+		};
+
+		void Flatten(const IBehavior& behavior, int parent);
+
+		BehaviorState ExecuteNode(int idx, const TickContext& context) const;
+		BehaviorState ExecuteChild(int idx, const TickContext& context) const;
+		BehaviorState ExecuteLeaf(int idx, const TickContext& context) const;
+		BehaviorState ExecuteConditional(const Conditional& conditional, Blackboard* pBlackboard) const;
+		//Runs the children of a selector or sequence from child on
+		BehaviorState ExecuteSelector(int idx, int child, const TickContext& context) const;
+		BehaviorState ExecuteSequence(int idx, int child, const TickContext& context) const;
+		BehaviorState FinishPartialSequenceChild(int idx, int child, BehaviorState childState, const TickContext& context) const;
+		//Executes the node that was running, then finishes the composites above it
+		BehaviorState Resume(int idx, const TickContext& context) const;
+
+		std::vector<FlatBehaviorNode> m_Nodes = {};
+		std::vector<Conditional> m_Conditionals = {};
+		std::vector<Action> m_Actions = {};
+		std::vector<unsigned int> m_ObservedKeys = {};
+		//Every observed key once
+		std::vector<unsigned int> m_TreeObservedKeys = {};
+
+		int m_StateSize = 0;
+		int m_RunningNodeSlot = -1;
+		int m_KeysVersionSlot = -1;
+	};
+
+	//-----------------------------------------------------------------
+	// BEHAVIOR TREE INSTANCE (one agent running a FlatBehaviorTree)
+	//-----------------------------------------------------------------
+	class BehaviorTreeInstance final : public Elite::IDecisionMaking
+	{
+	public:
+		explicit BehaviorTreeInstance(Blackboard* pBlackBoard, std::shared_ptr<const FlatBehaviorTree> pTree)
+			: m_pBlackBoard(pBlackBoard), m_pTree(std::move(pTree)), m_State(m_pTree ? m_pTree->GetStateSize() : 0) {};
+		~BehaviorTreeInstance()
+		{
+			SAFE_DELETE(m_pBlackBoard); //Takes ownership of passed blackboard!
+		};
+
+		virtual void Update(float deltaTime) override
+		{
+			ELITE_PROFILE_SCOPE("BehaviorTree::Update");
+			Tick();
+		}
+		//Update without profiler zone, for batches that tick thousands of instances
+		void Tick()
+		{
+			if (m_pTree == nullptr)
+			{
+				m_CurrentState = BehaviorState::Failure;
+				return;
+			}
+
+			m_CurrentState = m_IsEventDriven ? m_pTree->TickEventDriven(m_pBlackBoard, m_State.data()) : m_pTree->Tick(m_pBlackBoard, m_State.data());
+		}
+		Blackboard* GetBlackboard() const
+		{ return m_pBlackBoard; }
+		BehaviorState GetCurrentState() const
+		{ return m_CurrentState; }
+
+		bool IsEventDriven() const { return m_IsEventDriven; }
+		void SetEventDriven(bool isEventDriven) { m_IsEventDriven = isEventDriven; }
+
+	private:
+		BehaviorState m_CurrentState = BehaviorState::Failure;
+		Blackboard* m_pBlackBoard = nullptr;
+		std::shared_ptr<const FlatBehaviorTree> m_pTree = nullptr;
+		std::vector<unsigned int> m_State = {};
+		bool m_IsEventDriven = false;
+	};
+}
+#endif
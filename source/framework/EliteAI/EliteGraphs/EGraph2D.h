@@ -82,6 +82,8 @@ namespace Elite
 				connection->SetCost(abs(Distance(posFrom, posTo)));
 			}
 		}
+
+		OnGraphModified(false, true);
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
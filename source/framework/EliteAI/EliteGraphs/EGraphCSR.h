@@ -0,0 +1,88 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGraphCSR.h: Immutable "baked" graph in compressed sparse row layout.
+// The connections of node i are stored contiguously in [offsets[i], offsets[i + 1]) of the target and cost arrays.
+// Bake it from any graph that follows the neighbour-iteration concept (IGraph, GridGraph, Graph2D, ...):
+//		int GetNrOfNodes() const;
+//		bool IsNodeActive(int idx) const;
+//		Vector2 GetNodePos(int idx) const;
+//		void ForEachNeighbor(int idx, T_Func func) const; // calls func(int toIdx, float cost)
+// CSRGraph follows the same concept, so the index based searches (IndexedAStar, IndexedBFS, ...) accept both.
+/*=============================================================================*/
+#pragma once
+
+#include <vector>
+#include "EGraphEnums.h"
+
+namespace Elite
+{
+	class CSRGraph final
+	{
+	public:
+		CSRGraph() = default;
+		template<class T_GraphType>
+		explicit CSRGraph(const T_GraphType& graph) { Bake(graph); }
+
+		template<class T_GraphType>
+		void Bake(const T_GraphType& graph);
+
+		int GetNrOfNodes() const { return (int)m_Positions.size(); }
+		int GetNrOfConnections() const { return (int)m_Targets.size(); }
+		bool IsEmpty() const { return m_Positions.empty(); }
+
+		bool IsNodeValid(int idx) const { return idx >= 0 && idx < GetNrOfNodes(); }
+		bool IsNodeActive(int idx) const { return m_IsActive[idx] != 0; }
+		Vector2 GetNodePos(int idx) const { return m_Positions[idx]; }
+
+		// Raw access to the connection range of a node
+		int GetFirstConnection(int idx) const { return m_Offsets[idx]; }
+		int GetEndConnection(int idx) const { return m_Offsets[idx + 1]; }
+		int GetNrOfNodeConnections(int idx) const { return m_Offsets[idx + 1] - m_Offsets[idx]; }
+		int GetConnectionTo(int connectionIdx) const { return m_Targets[connectionIdx]; }
+		float GetConnectionCost(int connectionIdx) const { return m_Costs[connectionIdx]; }
+
+		template<class T_Func>
+		void ForEachNeighbor(int idx, T_Func func) const
+		{
+			const int end = m_Offsets[idx + 1];
+			for (int c = m_Offsets[idx]; c < end; ++c)
+				func(m_Targets[c], m_Costs[c]);
+		}
+
+	private:
+		std::vector<int> m_Offsets; // nrOfNodes + 1 entries
+		std::vector<int> m_Targets;
+		std::vector<float> m_Costs;
+		std::vector<Vector2> m_Positions;
+		std::vector<char> m_IsActive;
+	};
+
+	template<class T_GraphType>
+	inline void CSRGraph::Bake(const T_GraphType& graph)
+	{
+		const int nrOfNodes = graph.GetNrOfNodes();
+
+		m_Offsets.assign(nrOfNodes + 1, 0);
+		m_Positions.assign(nrOfNodes, ZeroVector2);
+		m_IsActive.assign(nrOfNodes, 0);
+		m_Targets.clear();
+		m_Costs.clear();
+
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+		{
+			m_Offsets[idx] = (int)m_Targets.size();
+			if (!graph.IsNodeActive(idx))
+				continue;
+
+			m_IsActive[idx] = 1;
+			m_Positions[idx] = graph.GetNodePos(idx);
+			graph.ForEachNeighbor(idx, [this](int toIdx, float cost)
+			{
+				m_Targets.push_back(toIdx);
+				m_Costs.push_back(cost);
+			});
+		}
+		m_Offsets[nrOfNodes] = (int)m_Targets.size();
+	}
+}
@@ -27,6 +27,12 @@ namespace Elite
 
 		int GetRows() const { return m_NrOfRows; }
 		int GetColumns() const { return m_NrOfColumns; }
+		bool IsConnectedDiagonally() const { return m_IsConnectedDiagonally; }
+		float GetDefaultCostStraight() const { return m_DefaultCostStraight; }
+		float GetDefaultCostDiagonal() const { return m_DefaultCostDiagonal; }
+
+		// Only available for node types that carry a terrain (GridTerrainNode)
+		TerrainType GetTerrainType(int idx) const { return m_Nodes[idx]->GetTerrainType(); }
 
 		bool IsWithinBounds(int col, int row) const;
 		int GetIndex(int col, int row) const { return row * m_NrOfColumns + col; }
@@ -44,6 +50,14 @@ namespace Elite
 
 		void AddConnectionsToAdjacentCells(int col, int row);
 		void AddConnectionsToAdjacentCells(int idx);
+
+		// Hides IGraph::RemoveConnectionsToAdjacentNodes, to keep track of the modified cells
+		void RemoveConnectionsToAdjacentNodes(int idx);
+
+		// Cells whose connections were added or removed since the last ClearModifiedNodes (e.g. by the GraphEditor),
+		// lets derived data such as an HPAStar abstraction update only the affected parts
+		const std::vector<int>& GetModifiedNodes() const { return m_ModifiedNodes; }
+		void ClearModifiedNodes() { m_ModifiedNodes.clear(); }
 	private:
 		
 		int m_NrOfColumns;
@@ -54,6 +68,8 @@ namespace Elite
 		float m_DefaultCostStraight;
 		float m_DefaultCostDiagonal;
 
+		std::vector<int> m_ModifiedNodes;
+
 		const std::vector<Vector2> m_StraightDirections = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
 		const std::vector<Vector2> m_DiagonalDirections = { { 1, 1 }, { -1, 1 }, { -1, -1 }, { 1, -1 } };
 
@@ -133,6 +149,7 @@ namespace Elite
 				AddConnectionsToAdjacentCells(c, r);
 			}
 		}
+		ClearModifiedNodes();
 	}
 
 	template<class T_NodeType, class T_ConnectionType>
@@ -155,6 +172,7 @@ namespace Elite
 			AddConnectionsInDirections(idx, col, row, m_DiagonalDirections);
 		}
 
+		m_ModifiedNodes.push_back(idx);
 		OnGraphModified(false, true);
 	}
 
@@ -165,6 +183,13 @@ namespace Elite
 		AddConnectionsToAdjacentCells((int)colRow.x, (int)colRow.y);
 	}
 
+	template<class T_NodeType, class T_ConnectionType>
+	inline void GridGraph<T_NodeType, T_ConnectionType>::RemoveConnectionsToAdjacentNodes(int idx)
+	{
+		m_ModifiedNodes.push_back(idx);
+		IGraph::RemoveConnectionsToAdjacentNodes(idx);
+	}
+
 	template<class T_NodeType, class T_ConnectionType>
 	void GridGraph<T_NodeType, T_ConnectionType>::AddConnectionsInDirections(int idx, int col, int row, std::vector<Elite::Vector2> directions)
 	{
@@ -31,6 +31,7 @@ namespace Elite
 		// -------------------------
 		T_NodeType* GetNode(int idx) const;
 		bool IsNodeValid(int idx) const;
+		bool IsNodeActive(int idx) const { return m_Nodes[idx]->GetIndex() != invalid_node_index; }
 		NodeVector GetAllNodes() const;
 
 		T_ConnectionType* GetConnection(int from, int to) const;
@@ -38,6 +39,14 @@ namespace Elite
 		const ConnectionList& GetNodeConnections(int idx) const;
 		const ConnectionList& GetNodeConnections(T_NodeType* pNode) const { return GetNodeConnections(pNode->GetIndex()); }
 
+		// Neighbour-iteration concept shared with CSRGraph: calls func(int toIdx, float cost) for every connection of the node
+		template<class T_Func>
+		void ForEachNeighbor(int idx, T_Func func) const
+		{
+			for (auto pConnection : m_Connections[idx])
+				func(pConnection->GetTo(), pConnection->GetCost());
+		}
+
 		int GetNextFreeNodeIndex() const { return m_NextNodeIndex; }
 		int AddNode(T_NodeType* pNode);
 		void RemoveNode(int node);
@@ -0,0 +1,96 @@
+#include "stdafx.h"
+#include "EImplicitGridGraph.h"
+#include "EliteGraphUtilities/EGraphVisuals.h"
+
+using namespace Elite;
+
+// Same order as GridGraph: straight directions, then diagonal directions
+const int ImplicitGridGraph::m_DirectionsCol[8]{ 1, 0, -1, 0, 1, -1, -1, 1 };
+const int ImplicitGridGraph::m_DirectionsRow[8]{ 0, 1, 0, -1, 1, 1, -1, -1 };
+const TerrainType ImplicitGridGraph::m_TerrainTypes[3]{ TerrainType::Ground, TerrainType::Mud, TerrainType::Water };
+
+ImplicitGridGraph::ImplicitGridGraph(int columns, int rows, int cellSize, bool isConnectedDiagonally, float costStraight /*= 1.f*/, float costDiagonal /*= 1.5f*/)
+{
+	InitializeGrid(columns, rows, cellSize, isConnectedDiagonally, costStraight, costDiagonal);
+}
+
+void ImplicitGridGraph::InitializeGrid(int columns, int rows, int cellSize, bool isConnectedDiagonally, float costStraight /*= 1.f*/, float costDiagonal /*= 1.5f*/)
+{
+	m_NrOfColumns = columns;
+	m_NrOfRows = rows;
+	m_CellSize = cellSize;
+	m_IsConnectedDiagonally = isConnectedDiagonally;
+	m_DefaultCostStraight = costStraight;
+	m_DefaultCostDiagonal = costDiagonal;
+
+	m_Terrain.assign(columns * rows, TerrainCode::Ground);
+}
+
+Vector2 ImplicitGridGraph::GetNodeWorldPos(int col, int row) const
+{
+	Vector2 cellCenterOffset = { m_CellSize / 2.f, m_CellSize / 2.f };
+	return Vector2{ (float)col * m_CellSize, (float)row * m_CellSize } + cellCenterOffset;
+}
+
+int ImplicitGridGraph::GetNodeIdxAtWorldPos(const Elite::Vector2& pos) const
+{
+	if (pos.x < 0 || pos.y < 0)
+		return invalid_node_index;
+
+	const int c = int(pos.x / m_CellSize);
+	const int r = int(pos.y / m_CellSize);
+
+	if (!IsWithinBounds(c, r))
+		return invalid_node_index;
+
+	return GetIndex(c, r);
+}
+
+TerrainType ImplicitGridGraph::GetTerrainType(int idx) const
+{
+	return m_TerrainTypes[m_Terrain[idx]];
+}
+
+void ImplicitGridGraph::SetTerrainType(int idx, TerrainType terrain)
+{
+	switch (terrain)
+	{
+	case TerrainType::Mud:
+		m_Terrain[idx] = TerrainCode::Mud;
+		break;
+	case TerrainType::Water:
+		m_Terrain[idx] = TerrainCode::Water;
+		break;
+	default:
+		m_Terrain[idx] = TerrainCode::Ground;
+		break;
+	}
+}
+
+Elite::Color ImplicitGridGraph::GetNodeColor(int idx) const
+{
+	switch (m_Terrain[idx])
+	{
+	case TerrainCode::Mud:
+		return MUD_NODE_COLOR;
+	case TerrainCode::Water:
+		return WATER_NODE_COLOR;
+	default:
+		return GROUND_NODE_COLOR;
+	}
+}
+
+float ImplicitGridGraph::CalculateConnectionCost(int fromIdx, int toIdx) const
+{
+	float cost = m_DefaultCostStraight;
+
+	if (fromIdx / m_NrOfColumns != toIdx / m_NrOfColumns &&
+		fromIdx % m_NrOfColumns != toIdx % m_NrOfColumns)
+	{
+		cost = m_DefaultCostDiagonal;
+	}
+
+	cost *= (int(GetTerrainType(fromIdx)) + int(GetTerrainType(toIdx))) / 2.0f;
+
+	return cost;
+}
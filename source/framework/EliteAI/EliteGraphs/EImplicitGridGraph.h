@@ -0,0 +1,102 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EImplicitGridGraph.h: Grid graph that only stores one terrain byte per cell.
+// Nodes and connections are never materialized, neighbours and their costs are generated while searching
+// (same rules as GridGraph<GridTerrainNode, GraphConnection>). Follows the neighbour-iteration concept (see EGraphCSR.h).
+/*=============================================================================*/
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "EGraphEnums.h"
+
+namespace Elite
+{
+	class ImplicitGridGraph final
+	{
+	public:
+		ImplicitGridGraph() = default;
+		ImplicitGridGraph(int columns, int rows, int cellSize, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5f);
+		void InitializeGrid(int columns, int rows, int cellSize, bool isConnectedDiagonally, float costStraight = 1.f, float costDiagonal = 1.5f);
+
+		int GetRows() const { return m_NrOfRows; }
+		int GetColumns() const { return m_NrOfColumns; }
+		int GetCellSize() const { return m_CellSize; }
+		bool IsConnectedDiagonally() const { return m_IsConnectedDiagonally; }
+		float GetDefaultCostStraight() const { return m_DefaultCostStraight; }
+		float GetDefaultCostDiagonal() const { return m_DefaultCostDiagonal; }
+
+		bool IsWithinBounds(int col, int row) const { return (col >= 0 && col < m_NrOfColumns && row >= 0 && row < m_NrOfRows); }
+		int GetIndex(int col, int row) const { return row * m_NrOfColumns + col; }
+
+		int GetNrOfNodes() const { return (int)m_Terrain.size(); }
+		bool IsNodeValid(int idx) const { return idx >= 0 && idx < GetNrOfNodes(); }
+		bool IsNodeActive(int idx) const { return true; }
+
+		// returns the column and row of the node in a Vector2
+		Vector2 GetNodePos(int idx) const { return Vector2{ float(idx % m_NrOfColumns), float(idx / m_NrOfColumns) }; }
+
+		// returns the actual world position of the node
+		Vector2 GetNodeWorldPos(int col, int row) const;
+		Vector2 GetNodeWorldPos(int idx) const { return GetNodeWorldPos(idx % m_NrOfColumns, idx / m_NrOfColumns); }
+		int GetNodeIdxAtWorldPos(const Elite::Vector2& pos) const;
+
+		TerrainType GetTerrainType(int idx) const;
+		void SetTerrainType(int idx, TerrainType terrain);
+		Elite::Color GetNodeColor(int idx) const;
+
+		float CalculateConnectionCost(int fromIdx, int toIdx) const;
+
+		// Calls func(int toIdx, float cost) for every traversable neighbour: straight directions first, then diagonals
+		template<class T_Func>
+		void ForEachNeighbor(int idx, T_Func func) const;
+
+		size_t GetMemoryFootprint() const { return sizeof(*this) + m_Terrain.capacity() * sizeof(uint8_t); }
+
+	private:
+		enum TerrainCode : uint8_t
+		{
+			Ground = 0,
+			Mud = 1,
+			Water = 2
+		};
+
+		int m_NrOfColumns = 0;
+		int m_NrOfRows = 0;
+		int m_CellSize = 5;
+
+		bool m_IsConnectedDiagonally = true;
+		float m_DefaultCostStraight = 1.f;
+		float m_DefaultCostDiagonal = 1.5f;
+
+		std::vector<uint8_t> m_Terrain; // one TerrainCode per cell
+
+		static const int m_DirectionsCol[8];
+		static const int m_DirectionsRow[8];
+		static const TerrainType m_TerrainTypes[3];
+	};
+
+	template<class T_Func>
+	inline void ImplicitGridGraph::ForEachNeighbor(int idx, T_Func func) const
+	{
+		const int col = idx % m_NrOfColumns;
+		const int row = idx / m_NrOfColumns;
+		const int nrOfDirections = m_IsConnectedDiagonally ? 8 : 4;
+
+		for (int d = 0; d < nrOfDirections; ++d)
+		{
+			const int neighborCol = col + m_DirectionsCol[d];
+			const int neighborRow = row + m_DirectionsRow[d];
+			if (!IsWithinBounds(neighborCol, neighborRow))
+				continue;
+
+			const int neighborIdx = GetIndex(neighborCol, neighborRow);
+			const float connectionCost = CalculateConnectionCost(idx, neighborIdx);
+
+			//Extra check for different terrain types (same rule as GridGraph::AddConnectionsInDirections)
+			if (connectionCost < 100000)
+				func(neighborIdx, connectionCost);
+		}
+	}
+}
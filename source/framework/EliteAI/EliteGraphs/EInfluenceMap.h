@@ -2,6 +2,8 @@
 #include "EIGraph.h"
 #include "EGraphNodeTypes.h"
 #include "EGraphConnectionTypes.h"
+#include "EGraphCSR.h"
+#include "EInfluencePropagator.h"
 
 namespace Elite
 {
@@ -18,6 +20,17 @@ namespace Elite
 		void Render() const {}
 		void SetNodeColorsBasedOnInfluence();
 
+		// Flat propagation over the job system (default), or the node based kernel it replaces
+		bool IsUsingFlatPropagation() const { return m_IsUsingFlatPropagation; }
+		void SetUseFlatPropagation(bool useFlatPropagation);
+
+		// Flat propagation of only the nodes that didn't converge yet, see InfluencePropagator::SetIncremental
+		bool IsUsingIncrementalPropagation() const { return m_IsUsingIncrementalPropagation; }
+		void SetUseIncrementalPropagation(bool useIncrementalPropagation) { m_IsUsingIncrementalPropagation = useIncrementalPropagation; }
+		float GetConvergenceEpsilon() const { return m_ConvergenceEpsilon; }
+		void SetConvergenceEpsilon(float convergenceEpsilon) { m_ConvergenceEpsilon = convergenceEpsilon; }
+		int GetNrOfPropagatingNodes() const;
+
 		float GetMomentum() const { return m_Momentum; }
 		void SetMomentum(float momentum) { m_Momentum = momentum; }
 
@@ -31,6 +44,9 @@ namespace Elite
 		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) override;
 
 	private:
+		// The flat propagation keeps the influences in an InfluencePropagator, the nodes it wrote are copied back after every step
+		void WritePropagatedInfluences();
+
 		Elite::Color m_NegativeColor{ 1.f, 0.2f, 0.f};
 		Elite::Color m_NeutralColor{ 0.f, 0.f, 0.f };
 		Elite::Color m_PositiveColor{ 0.f, 0.2f, 1.f};
@@ -44,6 +60,16 @@ namespace Elite
 		float m_TimeSinceLastPropagation = 0.0f;
 
 		std::vector<float> m_InfluenceDoubleBuffer;
+
+		// Contiguous copy of the connections used by the propagation, rebaked when the graph is modified
+		CSRGraph m_BakedGraph;
+		bool m_IsBakedGraphDirty = true;
+
+		InfluencePropagator m_Propagator;
+		bool m_IsUsingFlatPropagation = true;
+
+		bool m_IsUsingIncrementalPropagation = false;
+		float m_ConvergenceEpsilon = 0.01f; // changes up to this don't wake up a node
 	};
 
 	template <class T_GraphType>
@@ -53,29 +79,59 @@ namespace Elite
 		m_TimeSinceLastPropagation += deltaTime;
 		if (m_TimeSinceLastPropagation < m_PropagationInterval) return;
 		m_TimeSinceLastPropagation = 0.f;
+		ELITE_PROFILE_SCOPE("InfluenceMap::PropagateInfluence");
+
+		if (m_IsBakedGraphDirty)
+		{
+			m_BakedGraph.Bake(*this);
+			m_IsBakedGraphDirty = false;
+
+			if (m_IsUsingFlatPropagation)
+			{
+				m_Propagator.SetIncremental(m_IsUsingIncrementalPropagation, m_ConvergenceEpsilon);
+				m_Propagator.Initialize(m_BakedGraph, m_Decay);
+				for (int idx = 0; idx < m_BakedGraph.GetNrOfNodes(); ++idx)
+				{
+					if (m_BakedGraph.IsNodeActive(idx))
+						m_Propagator.SetInfluence(idx, GetNode(idx)->GetInfluence());
+				}
+			}
+		}
+
+		if (m_IsUsingFlatPropagation)
+		{
+			m_Propagator.SetIncremental(m_IsUsingIncrementalPropagation, m_ConvergenceEpsilon);
+			m_Propagator.SetDecay(m_Decay);
+			m_Propagator.Propagate(m_Momentum, &JOBSYSTEM->GetThreadPool());
+			WritePropagatedInfluences();
+			return;
+		}
 
-		// Clear our buffer
-		m_InfluenceDoubleBuffer.clear();
+		const int nrOfNodes = m_BakedGraph.GetNrOfNodes();
+		m_InfluenceDoubleBuffer.resize(nrOfNodes);
 
-		for (const auto& node : GetAllNodes())
+		for (int idx = 0; idx < nrOfNodes; ++idx)
 		{
+			if (!m_BakedGraph.IsNodeActive(idx))
+				continue;
+
 			float highestInfluence{0.f};
-			for (const auto& connection : GetNodeConnections(node))
+			m_BakedGraph.ForEachNeighbor(idx, [&](int toIdx, float cost)
 			{
 				// Get influence of this connection and set as 
-				const float newInfluence = GetNode(connection->GetTo())->GetInfluence() * expf(-connection->GetCost() * m_Decay);
+				const float newInfluence = GetNode(toIdx)->GetInfluence() * expf(-cost * m_Decay);
 				if (abs(newInfluence) > abs(highestInfluence))
 					highestInfluence = newInfluence;
-			}
-
+			});
 
 			// Lerp between current and new influence based on momentum
-			m_InfluenceDoubleBuffer.emplace_back(Lerp(highestInfluence, node->GetInfluence(), m_Momentum));
+			m_InfluenceDoubleBuffer[idx] = Lerp(highestInfluence, GetNode(idx)->GetInfluence(), m_Momentum);
 		}
 
-		for(int i = 0; i < m_InfluenceDoubleBuffer.size(); i++)
+		for (int idx = 0; idx < nrOfNodes; ++idx)
 		{
-			GetNode(i)->SetInfluence(m_InfluenceDoubleBuffer[i]);
+			if (m_BakedGraph.IsNodeActive(idx))
+				GetNode(idx)->SetInfluence(m_InfluenceDoubleBuffer[idx]);
 		}
 	}
 
@@ -84,7 +140,54 @@ namespace Elite
 	{
 		auto idx = GetNodeIdxAtWorldPos(pos);
 		if (IsNodeValid(idx))
+		{
 			GetNode(idx)->SetInfluence(influence);
+
+			// A dirty propagator picks the influences up from the nodes when it's rebuilt
+			if (m_IsUsingFlatPropagation && !m_IsBakedGraphDirty && idx < m_Propagator.GetNrOfNodes())
+				m_Propagator.SetInfluence(idx, influence);
+		}
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::WritePropagatedInfluences()
+	{
+		const int nrOfNodes = std::min(m_Propagator.GetNrOfNodes(), GetNrOfNodes());
+		const auto writeInfluence = [this, nrOfNodes](int idx)
+		{
+			if (idx < nrOfNodes && m_Propagator.IsNodeActive(idx) && IsNodeActive(idx))
+				GetNode(idx)->SetInfluence(m_Propagator.GetInfluence(idx));
+		};
+
+		// An incremental step only touched its dirty nodes
+		if (m_Propagator.HasPropagatedAllNodes())
+		{
+			for (int idx = 0; idx < nrOfNodes; ++idx)
+				writeInfluence(idx);
+		}
+		else
+		{
+			for (const int idx : m_Propagator.GetPropagatedNodes())
+				writeInfluence(idx);
+		}
+	}
+
+	template<class T_GraphType>
+	inline int InfluenceMap<T_GraphType>::GetNrOfPropagatingNodes() const
+	{
+		if (!m_IsUsingFlatPropagation || !m_Propagator.IsIncremental())
+			return m_BakedGraph.GetNrOfNodes();
+		return m_Propagator.GetNrOfDirtyNodes();
+	}
+
+	template<class T_GraphType>
+	inline void InfluenceMap<T_GraphType>::SetUseFlatPropagation(bool useFlatPropagation)
+	{
+		if (useFlatPropagation == m_IsUsingFlatPropagation)
+			return;
+
+		m_IsUsingFlatPropagation = useFlatPropagation;
+		m_IsBakedGraphDirty = true;
 	}
 
 	template<class T_GraphType>
@@ -122,6 +225,8 @@ namespace Elite
 	template<class T_GraphType>
 	inline void InfluenceMap<T_GraphType>::OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged)
 	{
+		// The propagator is rebuilt from the nodes, which always hold the latest influences
 		InitializeBuffer();
+		m_IsBakedGraphDirty = true;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,366 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EInfluencePropagator.cpp: Flat influence propagation over a baked (CSR) graph.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EInfluencePropagator.h"
+#include "framework/EliteThreading/EThreadPool.h"
+
+#include <emmintrin.h>
+
+using namespace Elite;
+
+namespace
+{
+	// More offsets than the 8 neighbors of a grid cell isn't worth a stencil
+	const int MaxNrOfStencilOffsets{ 8 };
+	// Nodes per chunk of a parallel propagation, a multiple of the 4 nodes of an SSE register
+	const int PropagationGrainSize{ 4096 };
+	// Dirty nodes per chunk of an incremental propagation, smaller because these go over their connections one node at a time
+	const int IncrementalGrainSize{ 1024 };
+	// An incremental step with more than 1 / DenseDivisor of the nodes dirty propagates all nodes, which is cheaper than going over the dirty ones
+	const int DenseDivisor{ 8 };
+}
+
+void InfluencePropagator::Initialize(const CSRGraph& graph, float decay)
+{
+	m_NrOfNodes = graph.GetNrOfNodes();
+
+	m_ActiveMasks.resize(m_NrOfNodes);
+	m_Offsets.resize(m_NrOfNodes + 1);
+	m_Targets.resize(graph.GetNrOfConnections());
+	m_Costs.resize(graph.GetNrOfConnections());
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+	{
+		m_ActiveMasks[idx] = graph.IsNodeActive(idx) ? ~0 : 0;
+		m_Offsets[idx] = graph.GetFirstConnection(idx);
+		for (int c = graph.GetFirstConnection(idx); c < graph.GetEndConnection(idx); ++c)
+		{
+			m_Targets[c] = graph.GetConnectionTo(c);
+			m_Costs[c] = graph.GetConnectionCost(c);
+		}
+	}
+	m_Offsets[m_NrOfNodes] = graph.GetNrOfConnections();
+
+	if (!TryBuildStencil(graph))
+	{
+		m_StencilOffsets.clear();
+		m_StencilIsConnected.clear();
+		m_StencilCosts.clear();
+		m_Padding = 0;
+	}
+
+	for (auto& buffer : m_Buffers)
+		buffer.assign(m_NrOfNodes + 2 * m_Padding, 0.f);
+	m_pInfluences = m_Buffers[0].data() + m_Padding;
+	m_pNextInfluences = m_Buffers[1].data() + m_Padding;
+
+	m_Decay = decay;
+	CalculateFactors();
+
+	//All influences are zero, which is already converged
+	m_DirtyNodes.clear();
+	m_IsNodeDirty.assign(m_NrOfNodes, 0);
+	if (m_IsIncremental)
+		BuildReaders();
+}
+
+void InfluencePropagator::SetDecay(float decay)
+{
+	if (decay == m_Decay)
+		return;
+
+	m_Decay = decay;
+	CalculateFactors();
+
+	if (m_IsIncremental)
+		MarkAllNodesDirty();
+}
+
+void InfluencePropagator::SetIncremental(bool isIncremental, float epsilon)
+{
+	m_Epsilon = epsilon;
+	if (isIncremental == m_IsIncremental)
+		return;
+
+	//Nothing is known about the nodes that converged during full propagation
+	m_IsIncremental = isIncremental;
+	if (m_IsIncremental)
+	{
+		BuildReaders();
+		MarkAllNodesDirty();
+	}
+	else
+	{
+		m_DirtyNodes.clear();
+		m_IsNodeDirty.assign(m_NrOfNodes, 0);
+	}
+}
+
+void InfluencePropagator::Propagate(float momentum, ThreadPool* pThreadPool)
+{
+	if (m_IsIncremental)
+		PropagateIncremental(momentum, pThreadPool);
+	else
+		PropagateAll(momentum, pThreadPool);
+}
+
+void InfluencePropagator::PropagateAll(float momentum, ThreadPool* pThreadPool)
+{
+	auto propagateRange = [this, momentum](int begin, int end)
+	{
+		if (IsStencil())
+			PropagateStencil(begin, end, momentum);
+		else
+			PropagateConnections(begin, end, momentum);
+	};
+
+	if (pThreadPool)
+		pThreadPool->ParallelFor(m_NrOfNodes, PropagationGrainSize, propagateRange);
+	else
+		propagateRange(0, m_NrOfNodes);
+
+	//Every node was written, so the buffers only swap roles
+	std::swap(m_pInfluences, m_pNextInfluences);
+	m_HasPropagatedAllNodes = true;
+}
+
+void InfluencePropagator::PropagateStencil(int begin, int end, float momentum)
+{
+	const int nrOfDirections = static_cast<int>(m_StencilOffsets.size());
+	const float* const pInfluences = m_pInfluences;
+	float* const pNextInfluences = m_pNextInfluences;
+
+	//Same operations as the scalar loop below: strictly stronger influences replace the current one, in connection order
+	const __m128 signMask = _mm_set1_ps(-0.f);
+	const __m128 momentum4 = _mm_set1_ps(momentum);
+	const __m128 oneMinusMomentum4 = _mm_set1_ps(1 - momentum);
+
+	int idx = begin;
+	for (; idx + 4 <= end; idx += 4)
+	{
+		__m128 highest = _mm_setzero_ps();
+		__m128 highestAbs = _mm_setzero_ps();
+		for (int d = 0; d < nrOfDirections; ++d)
+		{
+			const __m128 neighbor = _mm_loadu_ps(pInfluences + idx + m_StencilOffsets[d]);
+			const __m128 factor = _mm_loadu_ps(&m_StencilFactors[d * m_NrOfNodes + idx]);
+			const __m128 influence = _mm_mul_ps(neighbor, factor);
+			const __m128 influenceAbs = _mm_andnot_ps(signMask, influence);
+
+			const __m128 isStronger = _mm_cmpgt_ps(influenceAbs, highestAbs);
+			highest = _mm_or_ps(_mm_and_ps(isStronger, influence), _mm_andnot_ps(isStronger, highest));
+			highestAbs = _mm_or_ps(_mm_and_ps(isStronger, influenceAbs), _mm_andnot_ps(isStronger, highestAbs));
+		}
+
+		const __m128 current = _mm_loadu_ps(pInfluences + idx);
+		const __m128 lerped = _mm_add_ps(_mm_mul_ps(oneMinusMomentum4, highest), _mm_mul_ps(momentum4, current));
+		const __m128 isActive = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_ActiveMasks[idx])));
+		_mm_storeu_ps(pNextInfluences + idx, _mm_or_ps(_mm_and_ps(isActive, lerped), _mm_andnot_ps(isActive, current)));
+	}
+
+	for (; idx < end; ++idx)
+	{
+		if (!m_ActiveMasks[idx])
+		{
+			pNextInfluences[idx] = pInfluences[idx];
+			continue;
+		}
+
+		float highestInfluence = 0.f;
+		for (int d = 0; d < nrOfDirections; ++d)
+		{
+			const float newInfluence = pInfluences[idx + m_StencilOffsets[d]] * m_StencilFactors[d * m_NrOfNodes + idx];
+			if (abs(newInfluence) > abs(highestInfluence))
+				highestInfluence = newInfluence;
+		}
+
+		pNextInfluences[idx] = Lerp(highestInfluence, pInfluences[idx], momentum);
+	}
+}
+
+void InfluencePropagator::PropagateConnections(int begin, int end, float momentum)
+{
+	for (int idx = begin; idx < end; ++idx)
+		m_pNextInfluences[idx] = CalculateInfluence(idx, momentum);
+}
+
+void InfluencePropagator::PropagateIncremental(float momentum, ThreadPool* pThreadPool)
+{
+	//Every node depends on the momentum
+	if (momentum != m_Momentum)
+	{
+		m_Momentum = momentum;
+		MarkAllNodesDirty();
+	}
+
+	if (GetNrOfDirtyNodes() > m_NrOfNodes / DenseDivisor)
+	{
+		PropagateAll(momentum, pThreadPool);
+
+		//The buffers swapped, the next influences hold the previous ones now
+		m_DirtyNodes.clear();
+		std::fill(m_IsNodeDirty.begin(), m_IsNodeDirty.end(), char(0));
+		for (int idx = 0; idx < m_NrOfNodes; ++idx)
+		{
+			if (abs(m_pInfluences[idx] - m_pNextInfluences[idx]) <= m_Epsilon)
+				continue;
+
+			MarkNodeChanged(idx);
+			if (GetNrOfDirtyNodes() > m_NrOfNodes / DenseDivisor)
+			{
+				MarkAllNodesDirty();
+				break;
+			}
+		}
+		return;
+	}
+
+	//A node that isn't dirty would calculate the influence it already has, so only the dirty ones are propagated
+	m_PropagatingNodes.swap(m_DirtyNodes);
+	m_DirtyNodes.clear();
+	m_HasPropagatedAllNodes = false;
+	for (const int idx : m_PropagatingNodes)
+		m_IsNodeDirty[idx] = 0;
+
+	const int nrOfPropagatingNodes = static_cast<int>(m_PropagatingNodes.size());
+	m_PropagatedInfluences.resize(nrOfPropagatingNodes);
+	auto propagateRange = [this, momentum](int begin, int end)
+	{
+		for (int i = begin; i < end; ++i)
+			m_PropagatedInfluences[i] = CalculateInfluence(m_PropagatingNodes[i], momentum);
+	};
+
+	if (pThreadPool)
+		pThreadPool->ParallelFor(nrOfPropagatingNodes, IncrementalGrainSize, propagateRange);
+	else
+		propagateRange(0, nrOfPropagatingNodes);
+
+	//All new influences are calculated from the old ones, so they can be written in place now.
+	//Changes up to epsilon are kept, but don't wake up the node and its readers: those nodes converged.
+	for (int i = 0; i < nrOfPropagatingNodes; ++i)
+	{
+		const int idx = m_PropagatingNodes[i];
+		if (abs(m_PropagatedInfluences[i] - m_pInfluences[idx]) > m_Epsilon)
+			MarkNodeChanged(idx);
+		m_pInfluences[idx] = m_PropagatedInfluences[i];
+	}
+}
+
+float InfluencePropagator::CalculateInfluence(int idx, float momentum) const
+{
+	if (!m_ActiveMasks[idx])
+		return m_pInfluences[idx];
+
+	float highestInfluence = 0.f;
+	for (int c = m_Offsets[idx]; c < m_Offsets[idx + 1]; ++c)
+	{
+		const float newInfluence = m_pInfluences[m_Targets[c]] * m_Factors[c];
+		if (abs(newInfluence) > abs(highestInfluence))
+			highestInfluence = newInfluence;
+	}
+
+	return Lerp(highestInfluence, m_pInfluences[idx], momentum);
+}
+
+bool InfluencePropagator::TryBuildStencil(const CSRGraph& graph)
+{
+	//The directions are taken in the connection order of the best connected node, for a grid every node follows that order
+	int bestConnectedIdx = -1;
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+	{
+		if (bestConnectedIdx == -1 || graph.GetNrOfNodeConnections(idx) > graph.GetNrOfNodeConnections(bestConnectedIdx))
+			bestConnectedIdx = idx;
+	}
+	if (bestConnectedIdx == -1 || graph.GetNrOfNodeConnections(bestConnectedIdx) > MaxNrOfStencilOffsets)
+		return false;
+
+	m_StencilOffsets.clear();
+	m_Padding = 0;
+	for (int c = graph.GetFirstConnection(bestConnectedIdx); c < graph.GetEndConnection(bestConnectedIdx); ++c)
+	{
+		const int offset = graph.GetConnectionTo(c) - bestConnectedIdx;
+		m_StencilOffsets.push_back(offset);
+		m_Padding = std::max(m_Padding, abs(offset));
+	}
+
+	const int nrOfDirections = static_cast<int>(m_StencilOffsets.size());
+	m_StencilIsConnected.assign(nrOfDirections * m_NrOfNodes, 0);
+	m_StencilCosts.assign(nrOfDirections * m_NrOfNodes, 0.f);
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+	{
+		for (int c = graph.GetFirstConnection(idx); c < graph.GetEndConnection(idx); ++c)
+		{
+			const int offset = graph.GetConnectionTo(c) - idx;
+			const auto it = std::find(m_StencilOffsets.begin(), m_StencilOffsets.end(), offset);
+			if (it == m_StencilOffsets.end())
+				return false;
+
+			//A second connection in the same direction doesn't fit either
+			const int stencilIdx = static_cast<int>(it - m_StencilOffsets.begin()) * m_NrOfNodes + idx;
+			if (m_StencilIsConnected[stencilIdx])
+				return false;
+
+			m_StencilIsConnected[stencilIdx] = 1;
+			m_StencilCosts[stencilIdx] = graph.GetConnectionCost(c);
+		}
+	}
+	return true;
+}
+
+void InfluencePropagator::CalculateFactors()
+{
+	m_Factors.resize(m_Costs.size());
+	for (size_t c = 0; c < m_Costs.size(); ++c)
+		m_Factors[c] = expf(-m_Costs[c] * m_Decay);
+
+	m_StencilFactors.resize(m_StencilCosts.size());
+	for (size_t i = 0; i < m_StencilCosts.size(); ++i)
+		m_StencilFactors[i] = m_StencilIsConnected[i] ? expf(-m_StencilCosts[i] * m_Decay) : 0.f;
+}
+
+void InfluencePropagator::BuildReaders()
+{
+	//Counting sort of the connections on their target
+	m_ReaderOffsets.assign(m_NrOfNodes + 1, 0);
+	for (const int toIdx : m_Targets)
+		++m_ReaderOffsets[toIdx + 1];
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+		m_ReaderOffsets[idx + 1] += m_ReaderOffsets[idx];
+
+	m_Readers.resize(m_Targets.size());
+	std::vector<int> nextReaders{ m_ReaderOffsets.begin(), m_ReaderOffsets.end() - 1 };
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+	{
+		for (int c = m_Offsets[idx]; c < m_Offsets[idx + 1]; ++c)
+			m_Readers[nextReaders[m_Targets[c]]++] = idx;
+	}
+}
+
+void InfluencePropagator::MarkNodeChanged(int idx)
+{
+	auto markDirty = [this](int dirtyIdx)
+	{
+		if (m_IsNodeDirty[dirtyIdx])
+			return;
+
+		m_IsNodeDirty[dirtyIdx] = 1;
+		m_DirtyNodes.push_back(dirtyIdx);
+	};
+
+	markDirty(idx);
+	for (int r = m_ReaderOffsets[idx]; r < m_ReaderOffsets[idx + 1]; ++r)
+		markDirty(m_Readers[r]);
+}
+
+void InfluencePropagator::MarkAllNodesDirty()
+{
+	m_DirtyNodes.clear();
+	for (int idx = 0; idx < m_NrOfNodes; ++idx)
+	{
+		m_IsNodeDirty[idx] = m_ActiveMasks[idx] ? 1 : 0;
+		if (m_IsNodeDirty[idx])
+			m_DirtyNodes.push_back(idx);
+	}
+}
@@ -0,0 +1,115 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EInfluencePropagator.h: Flat influence propagation over a baked (CSR) graph.
+// Influences live in two float buffers that swap roles every step, the falloff expf(-cost * decay) is precomputed per connection.
+// Graphs whose connections only use a few fixed index offsets (grids) are propagated as a stencil, 4 nodes at a time with SSE,
+// other graphs per node over their connections. Both split the nodes in chunks over a ThreadPool.
+// The incremental mode only recalculates the dirty nodes: nodes whose own influence or the influence of a node they read
+// changed more than an epsilon in the previous step. Nodes that converged drop out, so a step costs the active area of the map.
+/*=============================================================================*/
+#ifndef ELITE_INFLUENCE_PROPAGATOR
+#define	ELITE_INFLUENCE_PROPAGATOR
+
+#include <vector>
+#include "EGraphCSR.h"
+
+namespace Elite
+{
+	class ThreadPool;
+
+	class InfluencePropagator final
+	{
+	public:
+		InfluencePropagator() = default;
+		InfluencePropagator(InfluencePropagator&&) = default;
+		InfluencePropagator& operator=(InfluencePropagator&&) = default;
+
+		// Takes over the layout of the graph, all influences start at zero
+		void Initialize(const CSRGraph& graph, float decay);
+		// Recalculates the falloff factors when the decay changed
+		void SetDecay(float decay);
+
+		// With an epsilon of zero the incremental mode gives the same result as propagating every node
+		bool IsIncremental() const { return m_IsIncremental; }
+		float GetEpsilon() const { return m_Epsilon; }
+		void SetIncremental(bool isIncremental, float epsilon = 0.f);
+		int GetNrOfDirtyNodes() const { return static_cast<int>(m_DirtyNodes.size()); }
+		// The nodes the last Propagate wrote: every node, or only the propagated ones of an incremental step
+		bool HasPropagatedAllNodes() const { return m_HasPropagatedAllNodes; }
+		const std::vector<int>& GetPropagatedNodes() const { return m_PropagatingNodes; }
+
+		int GetNrOfNodes() const { return m_NrOfNodes; }
+		bool IsNodeActive(int idx) const { return m_ActiveMasks[idx] != 0; }
+		bool IsStencil() const { return !m_StencilOffsets.empty(); }
+
+		float GetInfluence(int idx) const { return m_pInfluences[idx]; }
+		void SetInfluence(int idx, float influence)
+		{
+			if (m_IsIncremental && influence != m_pInfluences[idx])
+				MarkNodeChanged(idx);
+			m_pInfluences[idx] = influence;
+		}
+
+		// Every active node takes the strongest influence of its neighbors (after falloff), lerped with its own by momentum.
+		// This is the rule of InfluenceMap's node based propagation, App_InfluenceMap's benchmark reports the nodes where both differ.
+		// The chunks run on pThreadPool, or one after the other on the calling thread when it is nullptr.
+		void Propagate(float momentum, ThreadPool* pThreadPool);
+
+	private:
+		void PropagateStencil(int begin, int end, float momentum);
+		void PropagateConnections(int begin, int end, float momentum);
+		void PropagateAll(float momentum, ThreadPool* pThreadPool);
+		void PropagateIncremental(float momentum, ThreadPool* pThreadPool);
+		float CalculateInfluence(int idx, float momentum) const;
+		bool TryBuildStencil(const CSRGraph& graph);
+		void CalculateFactors();
+		void BuildReaders();
+
+		// The node and every node reading it are recalculated in the next incremental step
+		void MarkNodeChanged(int idx);
+		void MarkAllNodesDirty();
+
+		int m_NrOfNodes = 0;
+		float m_Decay = -1.f;
+
+		// Double buffer, both padded so stencil reads past the first and last node stay in bounds (and read zero)
+		std::vector<float> m_Buffers[2];
+		float* m_pInfluences = nullptr;
+		float* m_pNextInfluences = nullptr;
+		int m_Padding = 0;
+
+		// All bits set for active nodes, inactive nodes keep their influence
+		std::vector<int> m_ActiveMasks;
+
+		// Connections of every node, same layout as the CSRGraph
+		std::vector<int> m_Offsets;
+		std::vector<int> m_Targets;
+		std::vector<float> m_Costs;
+		std::vector<float> m_Factors;
+
+		// Stencil: when m_StencilIsConnected[d * m_NrOfNodes + idx] is set, node idx is connected to idx + m_StencilOffsets[d].
+		// The factors of missing connections are zero, so every node can read every offset.
+		std::vector<int> m_StencilOffsets;
+		std::vector<char> m_StencilIsConnected;
+		std::vector<float> m_StencilCosts;
+		std::vector<float> m_StencilFactors;
+
+		// Incremental mode, m_Readers[m_ReaderOffsets[idx]...] are the nodes with a connection to idx
+		bool m_IsIncremental = false;
+		float m_Epsilon = 0.f;
+		float m_Momentum = -1.f;
+		std::vector<int> m_ReaderOffsets;
+		std::vector<int> m_Readers;
+		std::vector<int> m_DirtyNodes;
+		std::vector<char> m_IsNodeDirty;
+		std::vector<int> m_PropagatingNodes;
+		std::vector<float> m_PropagatedInfluences;
+		bool m_HasPropagatedAllNodes = true;
+
+		// The influence pointers point into the own buffers
+		InfluencePropagator(const InfluencePropagator&) = delete;
+		InfluencePropagator& operator=(const InfluencePropagator&) = delete;
+	};
+}
+#endif
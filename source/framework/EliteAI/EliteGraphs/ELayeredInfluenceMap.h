@@ -0,0 +1,538 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ELayeredInfluenceMap.h: Influence map with several layers over one graph (e.g. threat, food and allies).
+// Source layers are propagated like InfluenceMap, each with its own momentum and decay. Derived layers combine two
+// source layers (tension, vulnerability, frontier) and are only calculated when queried, per region of the map that
+// changed since. Regions are the cells of a uniform grid over the node positions, which also serves the radius queries.
+/*=============================================================================*/
+#pragma once
+#include "EIGraph.h"
+#include "EGraphNodeTypes.h"
+#include "EGraphConnectionTypes.h"
+#include "EGraphCSR.h"
+#include "EInfluencePropagator.h"
+
+namespace Elite
+{
+	// How a derived layer combines its two source layers a and b
+	enum class DerivedInfluence
+	{
+		Sum, // a + b, e.g. tension: threat and allies are both strong
+		Difference, // a - b, e.g. vulnerability: the threat outweighs the allies
+		Frontier // |a - b| on nodes where the stronger layer differs from a neighbor's, zero elsewhere
+	};
+
+	// Shape of a stamp over its radius
+	enum class InfluenceFalloff
+	{
+		Constant,
+		Linear,
+		Quadratic
+	};
+
+	template<class T_GraphType>
+	class LayeredInfluenceMap final : public T_GraphType
+	{
+	public:
+		struct WeightedLayer
+		{
+			int layer;
+			float weight;
+		};
+
+		LayeredInfluenceMap(bool isDirectional) : T_GraphType(isDirectional) {}
+
+		// Both return the index of the new layer
+		int AddLayer(float momentum = 0.8f, float decay = 0.1f);
+		int AddDerivedLayer(DerivedInfluence type, int sourceLayerA, int sourceLayerB);
+		int GetNrOfLayers() const { return static_cast<int>(m_Layers.size()); }
+		bool IsDerivedLayer(int layer) const { return m_Layers[layer].isDerived; }
+
+		float GetMomentum(int layer) const { return m_Layers[layer].momentum; }
+		void SetMomentum(int layer, float momentum) { m_Layers[layer].momentum = momentum; } // a higher momentum means a higher tendency to retain the current influence
+
+		float GetDecay(int layer) const { return m_Layers[layer].decay; }
+		void SetDecay(int layer, float decay) { m_Layers[layer].decay = decay; } // determines the decay in influence over distance
+
+		float GetPropagationInterval() const { return m_PropagationInterval; }
+		void SetPropagationInterval(float propagationInterval) { m_PropagationInterval = propagationInterval; }
+
+		// Propagates every source layer once per interval
+		void PropagateInfluence(float deltaTime);
+
+		float GetInfluence(int layer, int idx);
+		float GetInfluenceAtPosition(int layer, const Vector2& pos);
+		void SetInfluence(int layer, int idx, float influence);
+		void ClearLayer(int layer);
+
+		// Writes influence * falloff(distance / radius) into the nodes within radius of pos, where it's stronger than their current influence
+		void StampInfluence(int layer, const Vector2& pos, float influence, float radius, InfluenceFalloff falloff = InfluenceFalloff::Linear);
+
+		// Node within radius of pos with the highest weighted sum of the layers, invalid_node_index when there is none
+		int FindBestNode(const Vector2& pos, float radius, const std::vector<WeightedLayer>& weightedLayers);
+
+		// Copies the layer into the influence of the nodes (shown by the GraphRenderer) and colors them by it
+		void SetNodeColorsBasedOnLayer(int layer);
+
+	protected:
+		virtual void OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged) override;
+
+	private:
+		struct Layer
+		{
+			bool isDerived = false;
+
+			// Source layer
+			float momentum = 0.8f;
+			float decay = 0.1f;
+			InfluencePropagator propagator;
+
+			// Derived layer, values are only valid in the cells that aren't dirty
+			DerivedInfluence type = DerivedInfluence::Sum;
+			int sourceLayerA = -1;
+			int sourceLayerB = -1;
+			std::vector<float> values;
+			std::vector<char> dirtyCells;
+		};
+
+		Elite::Color m_NegativeColor{ 1.f, 0.2f, 0.f };
+		Elite::Color m_NeutralColor{ 0.f, 0.f, 0.f };
+		Elite::Color m_PositiveColor{ 0.f, 0.2f, 1.f };
+		float m_MaxAbsInfluence = 100.f;
+
+		float m_PropagationInterval = .05f; //in Seconds
+		float m_TimeSinceLastPropagation = 0.0f;
+
+		std::vector<Layer> m_Layers;
+
+		CSRGraph m_BakedGraph;
+		bool m_IsBakedGraphDirty = true;
+
+		// Uniform grid over the world positions of the active nodes, nodes of cell c are [m_CellStartIndices[c], m_CellStartIndices[c + 1]) of m_CellNodes
+		Vector2 m_CellsOrigin = ZeroVector2;
+		float m_CellSize = 1.f;
+		int m_NrOfCols = 1;
+		int m_NrOfRows = 1;
+		std::vector<int> m_CellStartIndices;
+		std::vector<int> m_CellNodes;
+		std::vector<int> m_NodeCells;
+		std::vector<Vector2> m_NodeWorldPositions;
+
+		// Influences of the source layer before its last propagation
+		std::vector<float> m_PreviousInfluences;
+
+		void UpdateBakedGraph();
+		void BuildCells();
+		int PositionToCol(float x) const { return Clamp(static_cast<int>((x - m_CellsOrigin.x) / m_CellSize), 0, m_NrOfCols - 1); }
+		int PositionToRow(float y) const { return Clamp(static_cast<int>((y - m_CellsOrigin.y) / m_CellSize), 0, m_NrOfRows - 1); }
+
+		// Marks the cells of the derived layers that depend on the source layer dirty, for a change of node idx
+		bool HasDerivedLayers(int sourceLayer) const;
+		void MarkNodeChanged(int sourceLayer, int idx);
+		// Marks the nodes whose influence differs from m_PreviousInfluences, of the nodes the last propagation wrote
+		void MarkPropagatedNodesChanged(int sourceLayer);
+		void UpdateDerivedCell(Layer& layer, int cell);
+		float CalculateDerivedInfluence(const Layer& layer, int idx) const;
+
+		template<class T_Func>
+		void ForEachNodeInRadius(const Vector2& pos, float radius, T_Func func) const;
+	};
+
+	template<class T_GraphType>
+	inline int LayeredInfluenceMap<T_GraphType>::AddLayer(float momentum, float decay)
+	{
+		Layer layer{};
+		layer.momentum = momentum;
+		layer.decay = decay;
+		m_Layers.push_back(std::move(layer));
+
+		m_IsBakedGraphDirty = true;
+		return GetNrOfLayers() - 1;
+	}
+
+	template<class T_GraphType>
+	inline int LayeredInfluenceMap<T_GraphType>::AddDerivedLayer(DerivedInfluence type, int sourceLayerA, int sourceLayerB)
+	{
+		assert(!IsDerivedLayer(sourceLayerA) && !IsDerivedLayer(sourceLayerB) && "<LayeredInfluenceMap::AddDerivedLayer>: derived layers combine source layers");
+
+		Layer layer{};
+		layer.isDerived = true;
+		layer.type = type;
+		layer.sourceLayerA = sourceLayerA;
+		layer.sourceLayerB = sourceLayerB;
+		m_Layers.push_back(std::move(layer));
+
+		m_IsBakedGraphDirty = true;
+		return GetNrOfLayers() - 1;
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::PropagateInfluence(float deltaTime)
+	{
+		// Only update influence once per interval
+		m_TimeSinceLastPropagation += deltaTime;
+		if (m_TimeSinceLastPropagation < m_PropagationInterval) return;
+		m_TimeSinceLastPropagation = 0.f;
+		ELITE_PROFILE_SCOPE("LayeredInfluenceMap::PropagateInfluence");
+
+		UpdateBakedGraph();
+
+		for (int layerIdx = 0; layerIdx < GetNrOfLayers(); ++layerIdx)
+		{
+			Layer& layer = m_Layers[layerIdx];
+			if (layer.isDerived)
+				continue;
+
+			// Only the nodes the propagation changed make cells of the derived layers dirty
+			InfluencePropagator& propagator = layer.propagator;
+			const bool hasDerivedLayers = HasDerivedLayers(layerIdx);
+			if (hasDerivedLayers)
+			{
+				m_PreviousInfluences.resize(propagator.GetNrOfNodes());
+				for (int idx = 0; idx < propagator.GetNrOfNodes(); ++idx)
+					m_PreviousInfluences[idx] = propagator.GetInfluence(idx);
+			}
+
+			propagator.SetDecay(layer.decay);
+			propagator.Propagate(layer.momentum, &JOBSYSTEM->GetThreadPool());
+			if (hasDerivedLayers)
+				MarkPropagatedNodesChanged(layerIdx);
+		}
+	}
+
+	template<class T_GraphType>
+	inline float LayeredInfluenceMap<T_GraphType>::GetInfluence(int layer, int idx)
+	{
+		UpdateBakedGraph();
+
+		Layer& influenceLayer = m_Layers[layer];
+		if (!influenceLayer.isDerived)
+			return influenceLayer.propagator.GetInfluence(idx);
+
+		const int cell = m_NodeCells[idx];
+		if (cell != invalid_node_index && influenceLayer.dirtyCells[cell])
+			UpdateDerivedCell(influenceLayer, cell);
+		return influenceLayer.values[idx];
+	}
+
+	template<class T_GraphType>
+	inline float LayeredInfluenceMap<T_GraphType>::GetInfluenceAtPosition(int layer, const Vector2& pos)
+	{
+		const int idx = GetNodeIdxAtWorldPos(pos);
+		return IsNodeValid(idx) ? GetInfluence(layer, idx) : 0.f;
+	}
+
+	template<class T_GraphType>
+	inline void LayeredInfluenceMap<T_GraphType>::SetInfluence(int layer, int idx, float influence)
+	{
+		assert(!IsDerivedLayer(layer) && "<LayeredInfluenceMap::SetInfluence>: derived layers can't be set");
+		UpdateBakedGraph();
+
+		m_Layers[layer].propagator.SetInfluence(idx, influence);
+		MarkNodeChanged(layer, idx);
+	}
+
+	template<class T_GraphType>
+	inline void LayeredInfluenceMap<T_GraphType>::ClearLayer(int layer)
+	{
+		assert(!IsDerivedLayer(layer) && "<LayeredInfluenceMap::ClearLayer>: derived layers can't be set");
+		UpdateBakedGraph();
+
+		InfluencePropagator& propagator = m_Layers[layer].propagator;
+		for (int idx = 0; idx < propagator.GetNrOfNodes(); ++idx)
+		{
+			if (propagator.GetInfluence(idx) == 0.f)
+				continue;
+
+			propagator.SetInfluence(idx, 0.f);
+			MarkNodeChanged(layer, idx);
+		}
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::StampInfluence(int layer, const Vector2& pos, float influence, float radius, InfluenceFalloff falloff)
+	{
+		assert(!IsDerivedLayer(layer) && "<LayeredInfluenceMap::StampInfluence>: derived layers can't be set");
+		UpdateBakedGraph();
+
+		InfluencePropagator& propagator = m_Layers[layer].propagator;
+		ForEachNodeInRadius(pos, radius, [&](int idx, float distanceSquared)
+		{
+			const float remaining = radius > 0.f ? 1.f - sqrtf(distanceSquared) / radius : 1.f;
+			float weight = 1.f;
+			if (falloff == InfluenceFalloff::Linear)
+				weight = remaining;
+			else if (falloff == InfluenceFalloff::Quadratic)
+				weight = remaining * remaining;
+
+			const float stampedInfluence = influence * weight;
+			if (abs(stampedInfluence) > abs(propagator.GetInfluence(idx)))
+			{
+				propagator.SetInfluence(idx, stampedInfluence);
+				MarkNodeChanged(layer, idx);
+			}
+		});
+	}
+
+	template<class T_GraphType>
+	int LayeredInfluenceMap<T_GraphType>::FindBestNode(const Vector2& pos, float radius, const std::vector<WeightedLayer>& weightedLayers)
+	{
+		UpdateBakedGraph();
+
+		int bestIdx = invalid_node_index;
+		float bestScore = 0.f;
+		ForEachNodeInRadius(pos, radius, [&](int idx, float)
+		{
+			float score = 0.f;
+			for (const auto& weightedLayer : weightedLayers)
+				score += weightedLayer.weight * GetInfluence(weightedLayer.layer, idx);
+
+			if (bestIdx == invalid_node_index || score > bestScore)
+			{
+				bestIdx = idx;
+				bestScore = score;
+			}
+		});
+		return bestIdx;
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::SetNodeColorsBasedOnLayer(int layer)
+	{
+		UpdateBakedGraph();
+
+		for (int idx = 0; idx < m_BakedGraph.GetNrOfNodes(); ++idx)
+		{
+			if (!m_BakedGraph.IsNodeActive(idx))
+				continue;
+
+			const float influence = GetInfluence(layer, idx);
+			const float relativeInfluence = abs(influence) / m_MaxAbsInfluence;
+			const Color& extremeColor = influence < 0 ? m_NegativeColor : m_PositiveColor;
+
+			auto pNode = GetNode(idx);
+			pNode->SetInfluence(influence);
+			pNode->SetColor(Elite::Color{
+				Lerp(m_NeutralColor.r, extremeColor.r, relativeInfluence),
+				Lerp(m_NeutralColor.g, extremeColor.g, relativeInfluence),
+				Lerp(m_NeutralColor.b, extremeColor.b, relativeInfluence)
+				});
+		}
+	}
+
+	template<class T_GraphType>
+	inline void LayeredInfluenceMap<T_GraphType>::OnGraphModified(bool nrOfNodesChanged, bool nrOfConnectionsChanged)
+	{
+		m_IsBakedGraphDirty = true;
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::UpdateBakedGraph()
+	{
+		if (!m_IsBakedGraphDirty)
+			return;
+		m_IsBakedGraphDirty = false;
+
+		m_BakedGraph.Bake(*this);
+		BuildCells();
+
+		// Source layers keep the influence of the nodes that are still there
+		const int nrOfNodes = m_BakedGraph.GetNrOfNodes();
+		std::vector<float> influences{};
+		for (auto& layer : m_Layers)
+		{
+			if (layer.isDerived)
+			{
+				layer.values.assign(nrOfNodes, 0.f);
+				layer.dirtyCells.assign(m_NrOfCols * m_NrOfRows, 1);
+				continue;
+			}
+
+			const int nrOfKeptNodes = std::min(nrOfNodes, layer.propagator.GetNrOfNodes());
+			influences.resize(nrOfKeptNodes);
+			for (int idx = 0; idx < nrOfKeptNodes; ++idx)
+				influences[idx] = layer.propagator.GetInfluence(idx);
+
+			layer.propagator.Initialize(m_BakedGraph, layer.decay);
+			for (int idx = 0; idx < nrOfKeptNodes; ++idx)
+			{
+				if (m_BakedGraph.IsNodeActive(idx))
+					layer.propagator.SetInfluence(idx, influences[idx]);
+			}
+		}
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::BuildCells()
+	{
+		const int nrOfNodes = m_BakedGraph.GetNrOfNodes();
+		m_NodeWorldPositions.resize(nrOfNodes);
+		m_NodeCells.assign(nrOfNodes, invalid_node_index);
+
+		// Bounds of the active nodes, about one node per cell
+		Vector2 min{ FLT_MAX, FLT_MAX };
+		Vector2 max{ -FLT_MAX, -FLT_MAX };
+		int nrOfActiveNodes = 0;
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+		{
+			if (!m_BakedGraph.IsNodeActive(idx))
+				continue;
+
+			m_NodeWorldPositions[idx] = GetNodeWorldPos(idx);
+			min = Vector2{ std::min(min.x, m_NodeWorldPositions[idx].x), std::min(min.y, m_NodeWorldPositions[idx].y) };
+			max = Vector2{ std::max(max.x, m_NodeWorldPositions[idx].x), std::max(max.y, m_NodeWorldPositions[idx].y) };
+			++nrOfActiveNodes;
+		}
+
+		m_CellsOrigin = nrOfActiveNodes > 0 ? min : ZeroVector2;
+		const Vector2 size = nrOfActiveNodes > 0 ? max - min : ZeroVector2;
+		m_CellSize = std::max(sqrtf(size.x * size.y / std::max(1, nrOfActiveNodes)), std::max(size.x, size.y) / 1024.f);
+		m_CellSize = std::max(m_CellSize, FLT_EPSILON);
+		m_NrOfCols = static_cast<int>(size.x / m_CellSize) + 1;
+		m_NrOfRows = static_cast<int>(size.y / m_CellSize) + 1;
+
+		// Counting sort of the active nodes into their cells
+		m_CellStartIndices.assign(m_NrOfCols * m_NrOfRows + 1, 0);
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+		{
+			if (!m_BakedGraph.IsNodeActive(idx))
+				continue;
+
+			m_NodeCells[idx] = PositionToRow(m_NodeWorldPositions[idx].y) * m_NrOfCols + PositionToCol(m_NodeWorldPositions[idx].x);
+			++m_CellStartIndices[m_NodeCells[idx] + 1];
+		}
+		for (size_t cell = 1; cell < m_CellStartIndices.size(); ++cell)
+			m_CellStartIndices[cell] += m_CellStartIndices[cell - 1];
+
+		m_CellNodes.resize(nrOfActiveNodes);
+		std::vector<int> cellEnds{ m_CellStartIndices.begin() + 1, m_CellStartIndices.end() };
+		for (int idx = nrOfNodes - 1; idx >= 0; --idx)
+		{
+			if (m_NodeCells[idx] != invalid_node_index)
+				m_CellNodes[--cellEnds[m_NodeCells[idx]]] = idx;
+		}
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::MarkNodeChanged(int sourceLayer, int idx)
+	{
+		for (auto& layer : m_Layers)
+		{
+			if (!layer.isDerived || (layer.sourceLayerA != sourceLayer && layer.sourceLayerB != sourceLayer))
+				continue;
+
+			if (m_NodeCells[idx] != invalid_node_index)
+				layer.dirtyCells[m_NodeCells[idx]] = 1;
+
+			// The frontier of a node depends on its neighbors too
+			if (layer.type == DerivedInfluence::Frontier)
+			{
+				m_BakedGraph.ForEachNeighbor(idx, [&](int toIdx, float)
+				{
+					if (m_NodeCells[toIdx] != invalid_node_index)
+						layer.dirtyCells[m_NodeCells[toIdx]] = 1;
+				});
+			}
+		}
+	}
+
+	template<class T_GraphType>
+	bool LayeredInfluenceMap<T_GraphType>::HasDerivedLayers(int sourceLayer) const
+	{
+		for (const auto& layer : m_Layers)
+		{
+			if (layer.isDerived && (layer.sourceLayerA == sourceLayer || layer.sourceLayerB == sourceLayer))
+				return true;
+		}
+		return false;
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::MarkPropagatedNodesChanged(int sourceLayer)
+	{
+		const InfluencePropagator& propagator = m_Layers[sourceLayer].propagator;
+		auto markIfChanged = [&](int idx)
+		{
+			if (propagator.GetInfluence(idx) != m_PreviousInfluences[idx])
+				MarkNodeChanged(sourceLayer, idx);
+		};
+
+		if (propagator.HasPropagatedAllNodes())
+		{
+			for (int idx = 0; idx < propagator.GetNrOfNodes(); ++idx)
+				markIfChanged(idx);
+		}
+		else
+		{
+			for (const int idx : propagator.GetPropagatedNodes())
+				markIfChanged(idx);
+		}
+	}
+
+	template<class T_GraphType>
+	void LayeredInfluenceMap<T_GraphType>::UpdateDerivedCell(Layer& layer, int cell)
+	{
+		for (int i = m_CellStartIndices[cell]; i < m_CellStartIndices[cell + 1]; ++i)
+		{
+			const int idx = m_CellNodes[i];
+			layer.values[idx] = CalculateDerivedInfluence(layer, idx);
+		}
+		layer.dirtyCells[cell] = 0;
+	}
+
+	template<class T_GraphType>
+	float LayeredInfluenceMap<T_GraphType>::CalculateDerivedInfluence(const Layer& layer, int idx) const
+	{
+		const InfluencePropagator& a = m_Layers[layer.sourceLayerA].propagator;
+		const InfluencePropagator& b = m_Layers[layer.sourceLayerB].propagator;
+		const float difference = a.GetInfluence(idx) - b.GetInfluence(idx);
+
+		switch (layer.type)
+		{
+		case DerivedInfluence::Sum:
+			return a.GetInfluence(idx) + b.GetInfluence(idx);
+		case DerivedInfluence::Difference:
+			return difference;
+		case DerivedInfluence::Frontier:
+		{
+			if (difference == 0.f)
+				return 0.f;
+
+			bool isFrontier = false;
+			m_BakedGraph.ForEachNeighbor(idx, [&](int toIdx, float)
+			{
+				const float neighborDifference = a.GetInfluence(toIdx) - b.GetInfluence(toIdx);
+				if (neighborDifference != 0.f && (neighborDifference > 0.f) != (difference > 0.f))
+					isFrontier = true;
+			});
+			return isFrontier ? abs(difference) : 0.f;
+		}
+		}
+		return 0.f;
+	}
+
+	template<class T_GraphType>
+	template<class T_Func>
+	void LayeredInfluenceMap<T_GraphType>::ForEachNodeInRadius(const Vector2& pos, float radius, T_Func func) const
+	{
+		const float radiusSquared = radius * radius;
+		const int firstCol = PositionToCol(pos.x - radius);
+		const int lastCol = PositionToCol(pos.x + radius);
+		const int firstRow = PositionToRow(pos.y - radius);
+		const int lastRow = PositionToRow(pos.y + radius);
+
+		// The cells of a row are contiguous in m_CellNodes
+		for (int row = firstRow; row <= lastRow; ++row)
+		{
+			const int end = m_CellStartIndices[row * m_NrOfCols + lastCol + 1];
+			for (int i = m_CellStartIndices[row * m_NrOfCols + firstCol]; i < end; ++i)
+			{
+				const int idx = m_CellNodes[i];
+				const float distanceSquared = DistanceSquared(pos, m_NodeWorldPositions[idx]);
+				if (distanceSquared <= radiusSquared)
+					func(idx, distanceSquared);
+			}
+		}
+	}
+}
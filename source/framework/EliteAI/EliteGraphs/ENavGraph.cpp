@@ -4,16 +4,19 @@
 
 using namespace Elite;
 
-Elite::NavGraph::NavGraph(const Polygon& contourMesh, float playerRadius = 1.0f) :
+Elite::NavGraph::NavGraph(const Polygon& contourMesh, float playerRadius, TriangulationMethod triangulationMethod) :
+	//Get all shapes from all static rigidbodies with NavigationCollider flag
+	NavGraph(contourMesh, PHYSICSWORLD->GetAllStaticShapesInWorld(PhysicsFlags::NavigationCollider), playerRadius, triangulationMethod)
+{
+}
+
+Elite::NavGraph::NavGraph(const Polygon& contourMesh, const std::vector<Polygon>& vShapes, float playerRadius, TriangulationMethod triangulationMethod) :
 	Graph2D(false),
 	m_pNavMeshPolygon(nullptr)
 {
 	//Create the navigation mesh (polygon of navigatable area= Contour - Static Shapes)
 	m_pNavMeshPolygon = new Polygon(contourMesh); // Create copy on heap
 
-	//Get all shapes from all static rigidbodies with NavigationCollider flag
-	auto vShapes = PHYSICSWORLD->GetAllStaticShapesInWorld(PhysicsFlags::NavigationCollider);
-
 	//Store all children
 	for (auto shape : vShapes)
 	{
@@ -22,7 +25,7 @@ Elite::NavGraph::NavGraph(const Polygon& contourMesh, float playerRadius = 1.0f)
 	}
 
 	//Triangulate
-	m_pNavMeshPolygon->Triangulate();
+	m_pNavMeshPolygon->Triangulate(triangulationMethod);
 
 	//Create the actual graph (nodes & connections) from the navigation mesh
 	CreateNavigationGraph();
@@ -36,13 +39,10 @@ Elite::NavGraph::~NavGraph()
 
 int Elite::NavGraph::GetNodeIdxFromLineIdx(int lineIdx) const
 {
-	auto nodeIt = std::find_if(m_Nodes.begin(), m_Nodes.end(), [lineIdx](const NavGraphNode* n) { return n->GetLineIndex() == lineIdx; });
-	if (nodeIt != m_Nodes.end())
-	{
-		return (*nodeIt)->GetIndex();
-	}
+	if (lineIdx < 0 || lineIdx >= (int)m_LineToNodeIndices.size())
+		return invalid_node_index;
 
-	return invalid_node_index;
+	return m_LineToNodeIndices[lineIdx];
 }
 
 Elite::Polygon* Elite::NavGraph::GetNavMeshPolygon() const
@@ -53,11 +53,13 @@ Elite::Polygon* Elite::NavGraph::GetNavMeshPolygon() const
 void Elite::NavGraph::CreateNavigationGraph()
 {
 	//1. Go over all the edges of the navigationmesh and create nodes
+	m_LineToNodeIndices.assign(m_pNavMeshPolygon->GetLines().size(), invalid_node_index);
 	for (const auto line : m_pNavMeshPolygon->GetLines())
 	{
 		// Conected to atleast 2 triangles
 		if (m_pNavMeshPolygon->GetTrianglesFromLineIndex(line->index).size() > 1)
 		{
+			m_LineToNodeIndices[line->index] = GetNextFreeNodeIndex();
 			AddNode(new NavGraphNode{ GetNextFreeNodeIndex(), line->index, (line->p1 + line->p2) / 2.f});
 		}
 	}
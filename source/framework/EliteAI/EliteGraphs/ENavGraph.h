@@ -9,7 +9,9 @@ namespace Elite
 	class NavGraph final: public Graph2D<NavGraphNode, GraphConnection2D>
 	{
 	public:
-		NavGraph(const Polygon& baseMesh, float playerRadius );
+		NavGraph(const Polygon& baseMesh, float playerRadius, TriangulationMethod triangulationMethod = TriangulationMethod::EarClipping);
+		// Navigation mesh around the given obstacles instead of the static NavigationColliders in the physics world
+		NavGraph(const Polygon& baseMesh, const std::vector<Polygon>& obstacles, float playerRadius, TriangulationMethod triangulationMethod = TriangulationMethod::EarClipping);
 		~NavGraph();
 
 		int GetNodeIdxFromLineIdx(int lineIdx) const;
@@ -18,6 +20,7 @@ namespace Elite
 	private:
 		//--- Datamembers ---
 		Polygon* m_pNavMeshPolygon = nullptr; //Polygon that represents navigation mesh
+		std::vector<int> m_LineToNodeIndices; //Node on each line of the navigation mesh (invalid_node_index when the line has none)
 
 		void CreateNavigationGraph();
 
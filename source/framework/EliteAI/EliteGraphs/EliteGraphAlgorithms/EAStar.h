@@ -1,157 +1,138 @@
 #pragma once
 #include "framework/EliteAI/EliteNavigation/ENavigation.h"
+#include "ESearchContext.h"
 
 namespace Elite
 {
-	template <class T_NodeType, class T_ConnectionType>
-	class AStar
+	// A* over node indices, works on every graph that follows the neighbour-iteration concept (see EGraphCSR.h)
+	template <class T_GraphType>
+	class IndexedAStar
 	{
 	public:
-		AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction);
+		IndexedAStar(const T_GraphType* pGraph, Heuristic hFunction);
 
-		// stores the optimal connection to a node and its total costs related to the start and end node of the path
-		struct NodeRecord
-		{
-			T_NodeType* pNode = nullptr;
-			T_ConnectionType* pConnection = nullptr;
-			float costSoFar = 0.f; // accumulated g-costs of all the connections leading up to this one
-			float estimatedTotalCost = 0.f; // f-cost (= costSoFar + h-cost)
+		// The context and the path buffer are owned by the caller and only grow when the graph does.
+		// Returns false (and an empty path) when the destination can't be reached.
+		bool FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const;
 
-			bool operator==(const NodeRecord& other) const
-			{
-				return pNode == other.pNode
-					&& pConnection == other.pConnection
-					&& costSoFar == other.costSoFar
-					&& estimatedTotalCost == other.estimatedTotalCost;
-			};
+	private:
+		float GetHeuristicCost(int fromIdx, int toIdx) const;
 
-			bool operator<(const NodeRecord& other) const
-			{
-				return estimatedTotalCost < other.estimatedTotalCost;
-			};
-		};
+		const T_GraphType* m_pGraph;
+		Heuristic m_HeuristicFunction;
+	};
+
+	template <class T_NodeType, class T_ConnectionType>
+	class AStar
+	{
+	public:
+		AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction);
 
 		std::vector<T_NodeType*> FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode);
 
-	private:
-		float GetHeuristicCost(T_NodeType* pStartNode, T_NodeType* pEndNode) const;
+		// Allocation free version for repeated queries: the context and the path buffer are owned by the caller
+		// and only grow when the graph does. Returns false (and an empty path) when the destination can't be reached.
+		bool FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode, SearchContext& context, std::vector<T_NodeType*>& path) const;
 
+	private:
 		IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
 		Heuristic m_HeuristicFunction;
+
+		SearchContext m_Context;
 	};
 
-	template <class T_NodeType, class T_ConnectionType>
-	AStar<T_NodeType, T_ConnectionType>::AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction)
+	template <class T_GraphType>
+	IndexedAStar<T_GraphType>::IndexedAStar(const T_GraphType* pGraph, Heuristic hFunction)
 		: m_pGraph(pGraph)
 		, m_HeuristicFunction(hFunction)
 	{
 	}
 
-	template <class T_NodeType, class T_ConnectionType>
-	std::vector<T_NodeType*> AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode)
+	template <class T_GraphType>
+	bool IndexedAStar<T_GraphType>::FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const
 	{
-		std::vector<T_NodeType*> path;
-		std::vector<NodeRecord> openList;
-		std::vector<NodeRecord> closedList;
-		NodeRecord currentRecord;
-
-		NodeRecord startRecord;
-		startRecord.pNode = pStartNode;
-		startRecord.pConnection = nullptr;
-		startRecord.costSoFar = 0.f;
-		startRecord.estimatedTotalCost = GetHeuristicCost(startRecord.pNode, pGoalNode);
-		openList.emplace_back(startRecord);
-
-		while (!openList.empty())
+		ELITE_PROFILE_SCOPE("AStar::FindPath");
+		path.clear();
+		context.BeginQuery(m_pGraph->GetNrOfNodes());
+		IndexedMinHeap& openList = context.GetOpenList();
+
+		context.Visit(startIdx, 0.f, invalid_node_index);
+		openList.Push(startIdx, GetHeuristicCost(startIdx, goalIdx));
+
+		bool isGoalReached = false;
+		while (!openList.IsEmpty())
 		{
-			currentRecord = *std::min_element(openList.begin(), openList.end());
-			
-			if (currentRecord.pNode == pGoalNode)
+			const int currentIdx = openList.Pop();
+			if (currentIdx == goalIdx)
+			{
+				isGoalReached = true;
 				break;
+			}
 
-			for (auto& connection : m_pGraph->GetNodeConnections(currentRecord.pNode))
+			// Move current record from open to closed list
+			context.Close(currentIdx);
+			const float currentCost = context.GetCostSoFar(currentIdx);
+
+			m_pGraph->ForEachNeighbor(currentIdx, [&](int nextIdx, float connectionCost)
 			{
-				T_NodeType* pNextNode{ m_pGraph->GetNode(connection->GetTo()) };
-				float gCost = currentRecord.costSoFar + 1 + connection->GetCost();
-
-				bool isCheaperConnectionFound = false;
-
-				// Check if connection already exists
-				for (NodeRecord& existingRecord : closedList)
-				{
-					// Is current connection cheaper?
-					if (existingRecord.pNode == pNextNode)
-					{
-						if (existingRecord.costSoFar < gCost)
-						{
-							isCheaperConnectionFound = true;
-							break;
-						}
-						else
-						{
-							closedList.erase(std::remove(closedList.begin(), closedList.end(), existingRecord));
-						}
-					}
-				}
-
-				for (NodeRecord& existingRecord : openList)
-				{
-					// Is current connection cheaper?
-					if (existingRecord.pNode == pNextNode)
-					{
-						if (existingRecord.costSoFar < gCost)
-						{
-							isCheaperConnectionFound = true;
-							break;
-						}
-						else
-						{
-							openList.erase(std::remove(openList.begin(), openList.end(), existingRecord));
-						}
-					}
-				}
-				if (isCheaperConnectionFound) continue;
-
-				// Create new node and add to open list
-				NodeRecord record;
-				record.pNode = pNextNode;
-				record.costSoFar = gCost;
-				record.estimatedTotalCost = gCost + GetHeuristicCost(pNextNode, pGoalNode);
-				record.pConnection = connection;
-				openList.push_back(record);
-			} // Connections for-loop
+				const float gCost = currentCost + 1 + connectionCost;
 
-			// Move current record from open to closed list
-			openList.erase(std::remove(openList.begin(), openList.end(), currentRecord));
-			closedList.push_back(currentRecord);
+				// A cheaper connection to this node is already known (either open or closed)
+				if (context.IsVisited(nextIdx) && context.GetCostSoFar(nextIdx) <= gCost)
+					return;
+
+				// New or cheaper: (re)open the node, decreasing its key when already in the open list
+				context.Visit(nextIdx, gCost, currentIdx);
+				openList.Push(nextIdx, gCost + GetHeuristicCost(nextIdx, goalIdx));
+			});
 		} // While-loop
 
-		if(currentRecord.pNode != pGoalNode)
-			return std::vector<T_NodeType*>();
+		if (!isGoalReached)
+			return false;
 
-		while (currentRecord.pNode != pStartNode)
-		{
-			path.emplace_back(currentRecord.pNode);
-			for (NodeRecord& record : closedList)
-			{
-				if (record.pNode->GetIndex() == currentRecord.pConnection->GetFrom())
-				{
-					currentRecord = record;
-					break;
-				}
-			}
-		}
+		// Follow the parent indices back to the start
+		for (int idx = goalIdx; idx != invalid_node_index; idx = context.GetParent(idx))
+			path.emplace_back(idx);
 
-		path.emplace_back(pStartNode);
 		std::reverse(path.begin(), path.end());
+		return true;
+	}
 
+	template <class T_GraphType>
+	float IndexedAStar<T_GraphType>::GetHeuristicCost(int fromIdx, int toIdx) const
+	{
+		Vector2 toDestination = m_pGraph->GetNodePos(toIdx) - m_pGraph->GetNodePos(fromIdx);
+		return m_HeuristicFunction(abs(toDestination.x), abs(toDestination.y));
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	AStar<T_NodeType, T_ConnectionType>::AStar(IGraph<T_NodeType, T_ConnectionType>* pGraph, Heuristic hFunction)
+		: m_pGraph(pGraph)
+		, m_HeuristicFunction(hFunction)
+	{
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	std::vector<T_NodeType*> AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode)
+	{
+		std::vector<T_NodeType*> path;
+		FindPath(pStartNode, pGoalNode, m_Context, path);
 		return path;
 	}
 
 	template <class T_NodeType, class T_ConnectionType>
-	float Elite::AStar<T_NodeType, T_ConnectionType>::GetHeuristicCost(T_NodeType* pStartNode, T_NodeType* pEndNode) const
+	bool AStar<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pGoalNode, SearchContext& context, std::vector<T_NodeType*>& path) const
 	{
-		Vector2 toDestination = m_pGraph->GetNodePos(pEndNode) - m_pGraph->GetNodePos(pStartNode);
-		return m_HeuristicFunction(abs(toDestination.x), abs(toDestination.y));
+		path.clear();
+
+		std::vector<int>& indexPath = context.GetIndexPath();
+		const IndexedAStar<IGraph<T_NodeType, T_ConnectionType>> pathfinder{ m_pGraph, m_HeuristicFunction };
+		if (!pathfinder.FindPath(pStartNode->GetIndex(), pGoalNode->GetIndex(), context, indexPath))
+			return false;
+
+		for (const int idx : indexPath)
+			path.emplace_back(m_pGraph->GetNode(idx));
+
+		return true;
 	}
-}
\ No newline at end of file
+}
@@ -1,7 +1,20 @@
 #pragma once
+#include "ESearchContext.h"
 
 namespace Elite 
 {
+	// Breadth-first search over node indices, works on every graph that follows the neighbour-iteration concept (see EGraphCSR.h)
+	template <class T_GraphType>
+	class IndexedBFS
+	{
+	public:
+		IndexedBFS(const T_GraphType* pGraph);
+
+		bool FindPath(int startIdx, int destinationIdx, SearchContext& context, std::vector<int>& path) const;
+	private:
+		const T_GraphType* m_pGraph;
+	};
+
 	template <class T_NodeType, class T_ConnectionType>
 	class BFS
 	{
@@ -11,57 +24,78 @@ namespace Elite
 		std::vector<T_NodeType*> FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode);
 	private:
 		IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
+		SearchContext m_Context;
 	};
 
-	template <class T_NodeType, class T_ConnectionType>
-	BFS<T_NodeType, T_ConnectionType>::BFS(IGraph<T_NodeType, T_ConnectionType>* pGraph)
+	template <class T_GraphType>
+	IndexedBFS<T_GraphType>::IndexedBFS(const T_GraphType* pGraph)
 		: m_pGraph(pGraph)
 	{
-
 	}
 
-	template <class T_NodeType, class T_ConnectionType>
-	std::vector<T_NodeType*> BFS<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode)
+	template <class T_GraphType>
+	bool IndexedBFS<T_GraphType>::FindPath(int startIdx, int destinationIdx, SearchContext& context, std::vector<int>& path) const
 	{
-		std::queue<T_NodeType*> openList;
-		std::map<T_NodeType*, T_NodeType*> closedList;
+		path.clear();
+		context.BeginQuery(m_pGraph->GetNrOfNodes());
+
+		// The frontier is used as a FIFO queue, nodes are marked as visited when they are first discovered
+		auto& openList = context.GetFrontier();
+		openList.clear();
+		size_t front = 0;
 
-		openList.push(pStartNode);
+		openList.push_back(startIdx);
+		context.Visit(startIdx, 0.f, invalid_node_index);
 
-		while (!openList.empty())
+		while (front < openList.size())
 		{
-			T_NodeType* pCurrentNode{ openList.front() };
-			openList.pop();
+			const int currentIdx = openList[front++];
 
-			if (pCurrentNode == pDestinationNode)
+			if (currentIdx == destinationIdx)
 				break;
 
-			for (auto& connection : m_pGraph->GetNodeConnections(pCurrentNode))
+			context.Close(currentIdx);
+
+			const float depth = context.GetCostSoFar(currentIdx) + 1.f;
+			m_pGraph->ForEachNeighbor(currentIdx, [&](int nextIdx, float)
 			{
-				T_NodeType* pNextNode{ m_pGraph->GetNode(connection->GetTo()) };
-
-				if (closedList.find(pNextNode) != closedList.end())
-					continue;
-				
-				openList.push(pNextNode);
-				closedList[pNextNode] = pCurrentNode;	
-			}
+				if (context.IsVisited(nextIdx))
+					return;
+
+				openList.push_back(nextIdx);
+				context.Visit(nextIdx, depth, currentIdx);
+			});
 		}
 
-		if (closedList.find(pDestinationNode) == closedList.end())
-			return std::vector<T_NodeType*>();
+		if (!context.IsVisited(destinationIdx))
+			return false;
 
+		for (int idx = destinationIdx; idx != invalid_node_index; idx = context.GetParent(idx))
+			path.emplace_back(idx);
+
+		std::reverse(path.begin(), path.end());
+		return true;
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	BFS<T_NodeType, T_ConnectionType>::BFS(IGraph<T_NodeType, T_ConnectionType>* pGraph)
+		: m_pGraph(pGraph)
+	{
+
+	}
+
+	template <class T_NodeType, class T_ConnectionType>
+	std::vector<T_NodeType*> BFS<T_NodeType, T_ConnectionType>::FindPath(T_NodeType* pStartNode, T_NodeType* pDestinationNode)
+	{
 		std::vector<T_NodeType*> path{};
-		T_NodeType* pCurrentNode{ pDestinationNode };
 
-		while (pCurrentNode != pStartNode)
-		{
-			path.emplace_back(pCurrentNode);
-			pCurrentNode = closedList[pCurrentNode];
-		}
+		std::vector<int>& indexPath = m_Context.GetIndexPath();
+		const IndexedBFS<IGraph<T_NodeType, T_ConnectionType>> pathfinder{ m_pGraph };
+		if (!pathfinder.FindPath(pStartNode->GetIndex(), pDestinationNode->GetIndex(), m_Context, indexPath))
+			return path;
 
-		path.emplace_back(pStartNode);
-		std::reverse(path.begin(), path.end());
+		for (const int idx : indexPath)
+			path.emplace_back(m_pGraph->GetNode(idx));
 
 		return path;
 	}
@@ -0,0 +1,44 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ECountingAllocator.h: Allocator for the search buffers that counts its allocations into a counter owned by the caller.
+// Without a counter it allocates like std::allocator, a benchmark passes one in to check that queries don't allocate.
+/*=============================================================================*/
+#pragma once
+#include <memory>
+
+namespace Elite
+{
+	// Not final, the containers derive from their allocator
+	template<typename T>
+	class CountingAllocator
+	{
+	public:
+		using value_type = T;
+
+		CountingAllocator() = default;
+		// pNrOfAllocations has to outlive every container using this allocator
+		explicit CountingAllocator(size_t* pNrOfAllocations) : m_pNrOfAllocations(pNrOfAllocations) {}
+		template<typename U>
+		CountingAllocator(const CountingAllocator<U>& other) : m_pNrOfAllocations(other.GetCounter()) {}
+
+		T* allocate(size_t n)
+		{
+			if (m_pNrOfAllocations)
+				++(*m_pNrOfAllocations);
+			return std::allocator<T>{}.allocate(n);
+		}
+		void deallocate(T* p, size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+		size_t* GetCounter() const { return m_pNrOfAllocations; }
+
+	private:
+		size_t* m_pNrOfAllocations = nullptr;
+	};
+
+	// Every instance allocates from the same heap, the counter doesn't matter for freeing
+	template<typename T, typename U>
+	bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) { return true; }
+	template<typename T, typename U>
+	bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) { return false; }
+}
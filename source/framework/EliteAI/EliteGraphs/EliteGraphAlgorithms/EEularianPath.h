@@ -1,5 +1,6 @@
 #pragma once
 #include <stack>
+#include "framework/EliteAI/EliteGraphs/EGraphCSR.h"
 
 namespace Elite
 {
@@ -10,6 +11,25 @@ namespace Elite
 		eulerian,
 	};
 
+	// Eulerian trail over node indices, works on every graph that follows the neighbour-iteration concept (see EGraphCSR.h)
+	template <class T_GraphType>
+	class IndexedEulerianPath
+	{
+	public:
+		IndexedEulerianPath(const T_GraphType* pGraph, bool isDirectionalGraph = false);
+
+		Eulerianity IsEulerian() const;
+		std::vector<int> FindPath(Eulerianity& eulerianity) const;
+
+	private:
+		int GetDegree(int idx) const;
+		void VisitAllNodesDFS(int startIdx, std::vector<bool>& visited) const;
+		bool IsConnected() const;
+
+		const T_GraphType* m_pGraph;
+		bool m_IsDirectionalGraph;
+	};
+
 	template <class T_NodeType, class T_ConnectionType>
 	class EulerianPath
 	{
@@ -21,33 +41,33 @@ namespace Elite
 		std::vector<T_NodeType*> FindPath(Eulerianity& eulerianity) const;
 
 	private:
-		void VisitAllNodesDFS(int startIdx, std::vector<bool>& visited) const;
-		bool IsConnected() const;
-
 		IGraph<T_NodeType, T_ConnectionType>* m_pGraph;
 	};
 
-	template<class T_NodeType, class T_ConnectionType>
-	inline EulerianPath<T_NodeType, T_ConnectionType>::EulerianPath(IGraph<T_NodeType, T_ConnectionType>* pGraph)
+	template<class T_GraphType>
+	inline IndexedEulerianPath<T_GraphType>::IndexedEulerianPath(const T_GraphType* pGraph, bool isDirectionalGraph /*= false*/)
 		: m_pGraph(pGraph)
+		, m_IsDirectionalGraph(isDirectionalGraph)
 	{
 	}
 
-	template<class T_NodeType, class T_ConnectionType>
-	inline Eulerianity EulerianPath<T_NodeType, T_ConnectionType>::IsEulerian() const
+	template<class T_GraphType>
+	inline Eulerianity IndexedEulerianPath<T_GraphType>::IsEulerian() const
 	{
-
 		// If the graph is not connected, there can be no Eulerian Trail
 		if (!IsConnected())
 			return Eulerianity::notEulerian;
 
 		// Count nodes with odd degree 
-		auto nodes = m_pGraph->GetAllNodes();
+		int nrOfActiveNodes = 0;
 		int oddCount = 0;
-		for (auto n : nodes)
+		for (int idx = 0; idx < m_pGraph->GetNrOfNodes(); ++idx)
 		{
-			auto connections = m_pGraph->GetNodeConnections(n);
-			if (connections.size() & 1)
+			if (!m_pGraph->IsNodeActive(idx))
+				continue;
+
+			++nrOfActiveNodes;
+			if (GetDegree(idx) & 1)
 				oddCount++;
 		}
 
@@ -57,20 +77,17 @@ namespace Elite
 
 		// A connected graph with exactly 2 nodes with an odd degree is Semi-Eulerian (unless there are only 2 nodes)
 		// An Euler trail can be made, but only starting and ending in these 2 nodes
-		if (oddCount == 2 && nodes.size() != 2)
+		if (oddCount == 2 && nrOfActiveNodes != 2)
 			return Eulerianity::semiEulerian;
 
 		// A connected graph with no odd nodes is Eulerian
 		return Eulerianity::eulerian;
 	}
 
-	template<class T_NodeType, class T_ConnectionType>
-	inline std::vector<T_NodeType*> EulerianPath<T_NodeType, T_ConnectionType>::FindPath(Eulerianity& eulerianity) const
+	template<class T_GraphType>
+	inline std::vector<int> IndexedEulerianPath<T_GraphType>::FindPath(Eulerianity& eulerianity) const
 	{
-		// Get a copy of the graph because this algorithm involves removing edges
-		auto graphCopy = m_pGraph->Clone();
-		auto path = std::vector<T_NodeType*>();
-		int nrOfNodes = graphCopy->GetNrOfNodes();
+		auto path = std::vector<int>();
 
 		// Check if there can be an Euler path
 		// If this graph is not eulerian, return the empty path
@@ -78,89 +95,123 @@ namespace Elite
 		if (eulerianity == Eulerianity::notEulerian)
 			return path;
 
-		std::stack<int> nodeStack;
-		T_NodeType* pCurrentNode = m_pGraph->GetAllNodes()[0];
+		// Bake the adjacency, so connections can be consumed through a per-node cursor instead of removing them from a copy of the graph
+		const CSRGraph graph{ *m_pGraph };
+		const int nrOfNodes = graph.GetNrOfNodes();
 
-		auto nodes = m_pGraph->GetAllNodes();
-		int nodeIndex = 0;
-		for (auto* n : nodes)
+		int startIdx = invalid_node_index;
+		for (int idx = 0; idx < nrOfNodes; ++idx)
 		{
-			auto connections = graphCopy->GetNodeConnections(n);
-			if (connections.size() & 1)
+			if (!graph.IsNodeActive(idx) || graph.GetNrOfNodeConnections(idx) == 0)
+				continue;
+
+			if (startIdx == invalid_node_index)
+				startIdx = idx;
+
+			if (graph.GetNrOfNodeConnections(idx) & 1)
 			{
-				pCurrentNode = n;
-				nodeStack.push(nodeIndex);
+				startIdx = idx;
 				break;
 			}
-			nodeIndex++;
 		}
-		if (nodeStack.size() == 0)
-			nodeStack.push(0);
+		if (startIdx == invalid_node_index)
+			return path;
 
-		// Start algorithm loop
-		do
+		std::vector<int> cursors(nrOfNodes);
+		for (int idx = 0; idx < nrOfNodes; ++idx)
+			cursors[idx] = graph.GetFirstConnection(idx);
+		std::vector<bool> isUsed(graph.GetNrOfConnections(), false);
+
+		// Hierholzer: walk unused connections, backtrack (and emit) when stuck
+		std::stack<int> nodeStack;
+		nodeStack.push(startIdx);
+		while (!nodeStack.empty())
 		{
-			const auto nodeConnections = graphCopy->GetNodeConnections(pCurrentNode);
-			if (nodeConnections.size() > 0)
-			{
-				nodeStack.push(pCurrentNode->GetIndex());
-				pCurrentNode = m_pGraph->GetNode(nodeConnections.front()->GetTo());
-				graphCopy->RemoveConnection(nodeConnections.front()->GetFrom(), pCurrentNode->GetIndex());
-			}
-			else
+			const int currentIdx = nodeStack.top();
+			int& cursor = cursors[currentIdx];
+			while (cursor < graph.GetEndConnection(currentIdx) && isUsed[cursor])
+				++cursor;
+
+			if (cursor == graph.GetEndConnection(currentIdx))
 			{
-				path.emplace_back(pCurrentNode);
-				if (nodeStack.size() > 0)
-					pCurrentNode = m_pGraph->GetNode(nodeStack.top());
+				path.emplace_back(currentIdx);
 				nodeStack.pop();
+				continue;
 			}
 
-			if (pCurrentNode->GetIndex() == -1)
+			const int nextIdx = graph.GetConnectionTo(cursor);
+			isUsed[cursor] = true;
+
+			// An undirected connection is stored in both directions, consume the opposite one as well
+			if (!m_IsDirectionalGraph)
 			{
-				std::reverse(path.begin(), path.end());
-				return path;
-			}	
-		} while (!(nodeStack.size() == 0 && graphCopy->GetNodeConnections(pCurrentNode).size() == 0));
+				for (int c = graph.GetFirstConnection(nextIdx); c < graph.GetEndConnection(nextIdx); ++c)
+				{
+					if (!isUsed[c] && graph.GetConnectionTo(c) == currentIdx)
+					{
+						isUsed[c] = true;
+						break;
+					}
+				}
+			}
+
+			nodeStack.push(nextIdx);
+		}
 
 		std::reverse(path.begin(), path.end()); // reverses order of the path
 		return path;
 	}
 
-	template<class T_NodeType, class T_ConnectionType>
-	inline void EulerianPath<T_NodeType, T_ConnectionType>::VisitAllNodesDFS(int startIdx, std::vector<bool>& visited) const
+	template<class T_GraphType>
+	inline int IndexedEulerianPath<T_GraphType>::GetDegree(int idx) const
 	{
-		// mark the visited node
+		int degree = 0;
+		m_pGraph->ForEachNeighbor(idx, [&degree](int, float) { ++degree; });
+		return degree;
+	}
+
+	template<class T_GraphType>
+	inline void IndexedEulerianPath<T_GraphType>::VisitAllNodesDFS(int startIdx, std::vector<bool>& visited) const
+	{
+		// iterative, large graphs would overflow the call stack
+		std::stack<int> nodeStack;
+		nodeStack.push(startIdx);
 		visited[startIdx] = true;
 
-		// recursively visit any valid connected nodes that were not visited before
-		for (auto connecetion : m_pGraph->GetNodeConnections(startIdx))
+		while (!nodeStack.empty())
 		{
-			if (!visited[connecetion->GetTo()])
+			const int currentIdx = nodeStack.top();
+			nodeStack.pop();
+
+			// visit any valid connected nodes that were not visited before
+			m_pGraph->ForEachNeighbor(currentIdx, [&](int nextIdx, float)
 			{
-				VisitAllNodesDFS(connecetion->GetTo(), visited);
-			}
+				if (!visited[nextIdx])
+				{
+					visited[nextIdx] = true;
+					nodeStack.push(nextIdx);
+				}
+			});
 		}
-
 	}
 
-	template<class T_NodeType, class T_ConnectionType>
-	inline bool EulerianPath<T_NodeType, T_ConnectionType>::IsConnected() const
+	template<class T_GraphType>
+	inline bool IndexedEulerianPath<T_GraphType>::IsConnected() const
 	{
-		auto nodes = m_pGraph->GetAllNodes();
-		vector<bool> visited(m_pGraph->GetNrOfNodes(), false);
+		const int nrOfNodes = m_pGraph->GetNrOfNodes();
+		std::vector<bool> visited(nrOfNodes, false);
 
 		// find a valid starting node that has connections
 		int connectedIndex = invalid_node_index;
-		for (auto n : nodes)
+		for (int idx = 0; idx < nrOfNodes; ++idx)
 		{
-			auto connections = m_pGraph->GetNodeConnections(n);
-			if (connections.size() != 0)
+			if (m_pGraph->IsNodeActive(idx) && GetDegree(idx) != 0)
 			{
-				connectedIndex = n->GetIndex();
+				connectedIndex = idx;
 				break;
 			}
 		}
-		
+
 		// if no valid node could be found, return false
 		if (connectedIndex == invalid_node_index)
 			return false;
@@ -169,14 +220,36 @@ namespace Elite
 		VisitAllNodesDFS(connectedIndex, visited);
 
 		// if a node was never visited, this graph is not connected
-		for (auto n : nodes)
+		for (int idx = 0; idx < nrOfNodes; ++idx)
 		{
-			if (!visited[n->GetIndex()])
+			if (m_pGraph->IsNodeActive(idx) && !visited[idx])
 				return false;
 		}
 
-
 		return true;
 	}
 
-}
\ No newline at end of file
+	template<class T_NodeType, class T_ConnectionType>
+	inline EulerianPath<T_NodeType, T_ConnectionType>::EulerianPath(IGraph<T_NodeType, T_ConnectionType>* pGraph)
+		: m_pGraph(pGraph)
+	{
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline Eulerianity EulerianPath<T_NodeType, T_ConnectionType>::IsEulerian() const
+	{
+		return IndexedEulerianPath<IGraph<T_NodeType, T_ConnectionType>>(m_pGraph, m_pGraph->IsDirectionalGraph()).IsEulerian();
+	}
+
+	template<class T_NodeType, class T_ConnectionType>
+	inline std::vector<T_NodeType*> EulerianPath<T_NodeType, T_ConnectionType>::FindPath(Eulerianity& eulerianity) const
+	{
+		const auto pathfinder = IndexedEulerianPath<IGraph<T_NodeType, T_ConnectionType>>(m_pGraph, m_pGraph->IsDirectionalGraph());
+
+		auto path = std::vector<T_NodeType*>();
+		for (const int idx : pathfinder.FindPath(eulerianity))
+			path.emplace_back(m_pGraph->GetNode(idx));
+
+		return path;
+	}
+}
@@ -0,0 +1,582 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EHPAStar.h: Hierarchical path-finding A* (Botea, Mueller & Schaeffer 2004) over grid graphs.
+// The grid is split in square clusters. Cells on both sides of an open cluster border become transition nodes,
+// the costs between the transitions of a cluster are searched once and cached in a small abstract graph.
+// Long queries are answered on the abstract graph, each abstract step is refined with A* inside one cluster.
+// Works on GridGraph and ImplicitGridGraph, the grid is expected to be undirected.
+// A diagonal move across a border (or through a cluster corner) that no two straight moves can replace connects its two cells as
+// an extra pair of transitions, so the abstract graph finds a path whenever the grid has one.
+/*=============================================================================*/
+#pragma once
+#include <unordered_map>
+#include "framework/EliteAI/EliteNavigation/ENavigation.h"
+#include "EAStar.h"
+
+namespace Elite
+{
+	template <class T_GridType>
+	class HPAStar
+	{
+	public:
+		HPAStar(const T_GridType* pGrid, int clusterSize, Heuristic hFunction);
+
+		void SetHeuristicFunction(Heuristic hFunction) { m_HeuristicFunction = hFunction; }
+
+		// Marks the clusters around this cell as out of date, call it for every cell whose connections changed
+		void InvalidateNode(int idx);
+		// Rebuilds the transitions and cached costs of the invalidated clusters (and their direct neighbours)
+		void Update();
+
+		// Full path: the abstract path refined cell by cell. Returns false (and an empty path) when there is no path.
+		bool FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const;
+
+		// Lazy refinement: search the abstract path once, then refine one step at a time when the agent needs it.
+		// The abstract path starts with startIdx and ends with goalIdx.
+		bool FindAbstractPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& abstractPath) const;
+		// Appends the cells after fromIdx up to and including toIdx (two consecutive nodes of an abstract path)
+		bool RefineSegment(int fromIdx, int toIdx, SearchContext& context, std::vector<int>& path) const;
+
+		int GetClusterSize() const { return m_ClusterSize; }
+		int GetNrOfClusters() const { return m_NrOfClusterColumns * m_NrOfClusterRows; }
+		int GetClusterIdx(int idx) const;
+		int GetNrOfTransitions() const { return (int)m_AbstractEdges.size(); }
+		std::vector<int> GetTransitions() const;
+
+	private:
+		struct AbstractEdge
+		{
+			int toIdx;
+			float cost;
+		};
+
+		struct Entrance
+		{
+			int idxA; // cell in the cluster before the border
+			int idxB; // cell in the cluster after the border
+			float cost;
+		};
+
+		// Restricts a grid to the cells of one cluster, follows the neighbour-iteration concept (see EGraphCSR.h)
+		class ClusterView
+		{
+		public:
+			ClusterView(const T_GridType* pGrid, int minCol, int minRow, int endCol, int endRow)
+				: m_pGrid(pGrid), m_MinCol(minCol), m_MinRow(minRow), m_EndCol(endCol), m_EndRow(endRow) {}
+
+			int GetNrOfNodes() const { return m_pGrid->GetNrOfNodes(); }
+			bool IsNodeActive(int idx) const { return IsInside(idx); }
+			Vector2 GetNodePos(int idx) const { return m_pGrid->GetNodePos(idx); }
+
+			bool IsInside(int idx) const
+			{
+				const int col = idx % m_pGrid->GetColumns();
+				const int row = idx / m_pGrid->GetColumns();
+				return col >= m_MinCol && col < m_EndCol && row >= m_MinRow && row < m_EndRow;
+			}
+
+			template<class T_Func>
+			void ForEachNeighbor(int idx, T_Func func) const
+			{
+				m_pGrid->ForEachNeighbor(idx, [&](int toIdx, float cost)
+				{
+					if (IsInside(toIdx))
+						func(toIdx, cost);
+				});
+			}
+
+		private:
+			const T_GridType* m_pGrid;
+			int m_MinCol, m_MinRow, m_EndCol, m_EndRow;
+		};
+
+		enum { min_wide_entrance = 6 }; // wider entrances get a transition at both ends instead of one in the middle
+
+		const T_GridType* m_pGrid;
+		Heuristic m_HeuristicFunction;
+
+		int m_ClusterSize;
+		int m_NrOfClusterColumns;
+		int m_NrOfClusterRows;
+
+		// Per cluster: the entrances to the next column and to the next row of clusters
+		std::vector<std::vector<Entrance>> m_ColumnEntrances;
+		std::vector<std::vector<Entrance>> m_RowEntrances;
+		std::vector<std::vector<int>> m_ClusterTransitions;
+		std::vector<char> m_IsClusterDirty;
+		bool m_HasDirtyClusters = false;
+
+		// Abstract graph, keyed on the grid index of the transition
+		std::unordered_map<int, std::vector<AbstractEdge>> m_AbstractEdges;
+		SearchContext m_BuildContext;
+
+		ClusterView GetClusterView(int clusterIdx) const;
+		void ScanColumnBorder(int clusterIdx);
+		void ScanRowBorder(int clusterIdx);
+		void AddEntrances(int idxA, int idxB, int step, int nrOfCells, std::vector<Entrance>& entrances) const;
+		void RebuildCluster(int clusterIdx);
+		template <class T_Func>
+		void ForEachDiagonalOnlyCrossing(int clusterIdx, T_Func func) const;
+		void SearchCluster(int clusterIdx, int fromIdx, SearchContext& context) const;
+
+		bool TryGetStepCost(int fromIdx, int toIdx, float& cost) const;
+		float GetHeuristicCost(int fromIdx, int toIdx) const;
+	};
+
+	template <class T_GridType>
+	HPAStar<T_GridType>::HPAStar(const T_GridType* pGrid, int clusterSize, Heuristic hFunction)
+		: m_pGrid(pGrid)
+		, m_HeuristicFunction(hFunction)
+		, m_ClusterSize(clusterSize)
+		, m_NrOfClusterColumns((pGrid->GetColumns() + clusterSize - 1) / clusterSize)
+		, m_NrOfClusterRows((pGrid->GetRows() + clusterSize - 1) / clusterSize)
+	{
+		const int nrOfClusters = GetNrOfClusters();
+		m_ColumnEntrances.resize(nrOfClusters);
+		m_RowEntrances.resize(nrOfClusters);
+		m_ClusterTransitions.resize(nrOfClusters);
+		m_IsClusterDirty.assign(nrOfClusters, 1);
+		m_HasDirtyClusters = true;
+
+		Update();
+	}
+
+	template <class T_GridType>
+	int HPAStar<T_GridType>::GetClusterIdx(int idx) const
+	{
+		const int col = idx % m_pGrid->GetColumns();
+		const int row = idx / m_pGrid->GetColumns();
+		return (row / m_ClusterSize) * m_NrOfClusterColumns + col / m_ClusterSize;
+	}
+
+	template <class T_GridType>
+	std::vector<int> HPAStar<T_GridType>::GetTransitions() const
+	{
+		std::vector<int> transitions{};
+		transitions.reserve(m_AbstractEdges.size());
+		for (const auto& node : m_AbstractEdges)
+			transitions.push_back(node.first);
+		return transitions;
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::InvalidateNode(int idx)
+	{
+		// The connections of the neighbours changed too, they can be part of an adjacent cluster
+		const int col = idx % m_pGrid->GetColumns();
+		const int row = idx / m_pGrid->GetColumns();
+		for (int c = col - 1; c <= col + 1; ++c)
+		{
+			for (int r = row - 1; r <= row + 1; ++r)
+			{
+				if (m_pGrid->IsWithinBounds(c, r))
+					m_IsClusterDirty[GetClusterIdx(m_pGrid->GetIndex(c, r))] = 1;
+			}
+		}
+		m_HasDirtyClusters = true;
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::Update()
+	{
+		if (!m_HasDirtyClusters)
+			return;
+
+		// The entrances on the borders of a dirty cluster can change, so the clusters on the other side are rebuilt too
+		std::vector<char> isRebuilt(m_IsClusterDirty);
+		for (int clusterIdx = 0; clusterIdx < GetNrOfClusters(); ++clusterIdx)
+		{
+			if (!m_IsClusterDirty[clusterIdx])
+				continue;
+
+			const int clusterCol = clusterIdx % m_NrOfClusterColumns;
+			const int clusterRow = clusterIdx / m_NrOfClusterColumns;
+
+			ScanColumnBorder(clusterIdx);
+			ScanRowBorder(clusterIdx);
+			if (clusterCol + 1 < m_NrOfClusterColumns)
+				isRebuilt[clusterIdx + 1] = 1;
+			if (clusterRow + 1 < m_NrOfClusterRows)
+				isRebuilt[clusterIdx + m_NrOfClusterColumns] = 1;
+			if (clusterCol > 0)
+			{
+				ScanColumnBorder(clusterIdx - 1);
+				isRebuilt[clusterIdx - 1] = 1;
+			}
+			if (clusterRow > 0)
+			{
+				ScanRowBorder(clusterIdx - m_NrOfClusterColumns);
+				isRebuilt[clusterIdx - m_NrOfClusterColumns] = 1;
+			}
+		}
+
+		for (int clusterIdx = 0; clusterIdx < GetNrOfClusters(); ++clusterIdx)
+		{
+			if (isRebuilt[clusterIdx])
+				RebuildCluster(clusterIdx);
+		}
+
+		std::fill(m_IsClusterDirty.begin(), m_IsClusterDirty.end(), char(0));
+		m_HasDirtyClusters = false;
+	}
+
+	template <class T_GridType>
+	typename HPAStar<T_GridType>::ClusterView HPAStar<T_GridType>::GetClusterView(int clusterIdx) const
+	{
+		const int minCol = (clusterIdx % m_NrOfClusterColumns) * m_ClusterSize;
+		const int minRow = (clusterIdx / m_NrOfClusterColumns) * m_ClusterSize;
+		return ClusterView{ m_pGrid, minCol, minRow,
+			std::min(minCol + m_ClusterSize, m_pGrid->GetColumns()), std::min(minRow + m_ClusterSize, m_pGrid->GetRows()) };
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::ScanColumnBorder(int clusterIdx)
+	{
+		std::vector<Entrance>& entrances = m_ColumnEntrances[clusterIdx];
+		entrances.clear();
+
+		const int clusterCol = clusterIdx % m_NrOfClusterColumns;
+		if (clusterCol + 1 >= m_NrOfClusterColumns)
+			return;
+
+		const int borderCol = (clusterCol + 1) * m_ClusterSize - 1;
+		const int minRow = (clusterIdx / m_NrOfClusterColumns) * m_ClusterSize;
+		const int nrOfCells = std::min(m_ClusterSize, m_pGrid->GetRows() - minRow);
+		AddEntrances(m_pGrid->GetIndex(borderCol, minRow), m_pGrid->GetIndex(borderCol + 1, minRow), m_pGrid->GetColumns(), nrOfCells, entrances);
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::ScanRowBorder(int clusterIdx)
+	{
+		std::vector<Entrance>& entrances = m_RowEntrances[clusterIdx];
+		entrances.clear();
+
+		const int clusterRow = clusterIdx / m_NrOfClusterColumns;
+		if (clusterRow + 1 >= m_NrOfClusterRows)
+			return;
+
+		const int borderRow = (clusterRow + 1) * m_ClusterSize - 1;
+		const int minCol = (clusterIdx % m_NrOfClusterColumns) * m_ClusterSize;
+		const int nrOfCells = std::min(m_ClusterSize, m_pGrid->GetColumns() - minCol);
+		AddEntrances(m_pGrid->GetIndex(minCol, borderRow), m_pGrid->GetIndex(minCol, borderRow + 1), 1, nrOfCells, entrances);
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::AddEntrances(int idxA, int idxB, int step, int nrOfCells, std::vector<Entrance>& entrances) const
+	{
+		// Walk along the border, every run of open cell pairs is one entrance
+		const int offsetToB = idxB - idxA;
+		int runStart = -1;
+		for (int i = 0; i <= nrOfCells; ++i)
+		{
+			float cost = 0.f;
+			const bool isOpen = i < nrOfCells && TryGetStepCost(idxA + i * step, idxA + i * step + offsetToB, cost);
+			if (isOpen && runStart < 0)
+				runStart = i;
+			if (isOpen || runStart < 0)
+				continue;
+
+			const int runLength = i - runStart;
+			const int runEnds[2]{ runStart, i - 1 };
+			const int nrOfTransitions = runLength < min_wide_entrance ? 1 : 2;
+			for (int t = 0; t < nrOfTransitions; ++t)
+			{
+				const int cell = nrOfTransitions == 1 ? runStart + runLength / 2 : runEnds[t];
+				const int fromIdx = idxA + cell * step;
+				TryGetStepCost(fromIdx, fromIdx + offsetToB, cost);
+				entrances.push_back({ fromIdx, fromIdx + offsetToB, cost });
+			}
+			runStart = -1;
+		}
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::RebuildCluster(int clusterIdx)
+	{
+		std::vector<int>& transitions = m_ClusterTransitions[clusterIdx];
+		for (const int idx : transitions)
+			m_AbstractEdges.erase(idx);
+		transitions.clear();
+
+		auto addInterEdge = [&](int fromIdx, int toIdx, float cost)
+		{
+			if (std::find(transitions.begin(), transitions.end(), fromIdx) == transitions.end())
+				transitions.push_back(fromIdx);
+			m_AbstractEdges[fromIdx].push_back({ toIdx, cost });
+		};
+
+		// Entrances on the four borders, the ones to the previous column/row are stored on the neighbouring cluster
+		const int clusterCol = clusterIdx % m_NrOfClusterColumns;
+		const int clusterRow = clusterIdx / m_NrOfClusterColumns;
+		for (const Entrance& entrance : m_ColumnEntrances[clusterIdx])
+			addInterEdge(entrance.idxA, entrance.idxB, entrance.cost);
+		for (const Entrance& entrance : m_RowEntrances[clusterIdx])
+			addInterEdge(entrance.idxA, entrance.idxB, entrance.cost);
+		if (clusterCol > 0)
+		{
+			for (const Entrance& entrance : m_ColumnEntrances[clusterIdx - 1])
+				addInterEdge(entrance.idxB, entrance.idxA, entrance.cost);
+		}
+		if (clusterRow > 0)
+		{
+			for (const Entrance& entrance : m_RowEntrances[clusterIdx - m_NrOfClusterColumns])
+				addInterEdge(entrance.idxB, entrance.idxA, entrance.cost);
+		}
+		// The cluster on the other side finds the same crossing from its own border, which adds the way back
+		ForEachDiagonalOnlyCrossing(clusterIdx, addInterEdge);
+
+		// Cache the cost between every pair of transitions that are connected inside the cluster
+		for (const int fromIdx : transitions)
+		{
+			SearchCluster(clusterIdx, fromIdx, m_BuildContext);
+
+			std::vector<AbstractEdge>& edges = m_AbstractEdges[fromIdx];
+			for (const int toIdx : transitions)
+			{
+				if (toIdx != fromIdx && m_BuildContext.IsVisited(toIdx))
+					edges.push_back({ toIdx, m_BuildContext.GetCostSoFar(toIdx) });
+			}
+		}
+	}
+
+	template <class T_GridType>
+	template <class T_Func>
+	void HPAStar<T_GridType>::ForEachDiagonalOnlyCrossing(int clusterIdx, T_Func func) const
+	{
+		// Diagonal steps from the border cells of this cluster into another cluster. A crossing that can also be made with two
+		// straight steps (through one of the cells next to both) is already covered by the entrances, those are skipped.
+		// Every cell of this check lies around the crossing, so InvalidateNode on any of them marks both clusters.
+		const ClusterView view = GetClusterView(clusterIdx);
+		const int minCol = (clusterIdx % m_NrOfClusterColumns) * m_ClusterSize;
+		const int minRow = (clusterIdx / m_NrOfClusterColumns) * m_ClusterSize;
+		const int endCol = std::min(minCol + m_ClusterSize, m_pGrid->GetColumns());
+		const int endRow = std::min(minRow + m_ClusterSize, m_pGrid->GetRows());
+
+		auto isConnected = [this](int fromIdx, int toIdx)
+		{
+			float cost = 0.f;
+			return TryGetStepCost(fromIdx, toIdx, cost);
+		};
+
+		for (int row = minRow; row < endRow; ++row)
+		{
+			// Only the outer columns, except on the first and last row
+			const int colStep = (row == minRow || row == endRow - 1) ? 1 : std::max(endCol - minCol - 1, 1);
+			for (int col = minCol; col < endCol; col += colStep)
+			{
+				const int fromIdx = m_pGrid->GetIndex(col, row);
+				for (int dRow = -1; dRow <= 1; dRow += 2)
+				{
+					for (int dCol = -1; dCol <= 1; dCol += 2)
+					{
+						if (!m_pGrid->IsWithinBounds(col + dCol, row + dRow))
+							continue;
+
+						const int toIdx = m_pGrid->GetIndex(col + dCol, row + dRow);
+						float cost = 0.f;
+						if (view.IsInside(toIdx) || !TryGetStepCost(fromIdx, toIdx, cost))
+							continue;
+
+						const int viaRowIdx = m_pGrid->GetIndex(col, row + dRow);
+						const int viaColIdx = m_pGrid->GetIndex(col + dCol, row);
+						if ((isConnected(fromIdx, viaRowIdx) && isConnected(viaRowIdx, toIdx))
+							|| (isConnected(fromIdx, viaColIdx) && isConnected(viaColIdx, toIdx)))
+							continue;
+
+						func(fromIdx, toIdx, cost);
+					}
+				}
+			}
+		}
+	}
+
+	template <class T_GridType>
+	void HPAStar<T_GridType>::SearchCluster(int clusterIdx, int fromIdx, SearchContext& context) const
+	{
+		// Dijkstra from one cell to every reachable cell of the cluster, the costs stay in the context
+		const ClusterView view = GetClusterView(clusterIdx);
+		context.BeginQuery(m_pGrid->GetNrOfNodes());
+		IndexedMinHeap& openList = context.GetOpenList();
+
+		context.Visit(fromIdx, 0.f, invalid_node_index);
+		openList.Push(fromIdx, 0.f);
+		while (!openList.IsEmpty())
+		{
+			const int currentIdx = openList.Pop();
+			context.Close(currentIdx);
+			const float currentCost = context.GetCostSoFar(currentIdx);
+
+			view.ForEachNeighbor(currentIdx, [&](int nextIdx, float connectionCost)
+			{
+				const float gCost = currentCost + 1 + connectionCost;
+				if (context.IsVisited(nextIdx) && context.GetCostSoFar(nextIdx) <= gCost)
+					return;
+
+				context.Visit(nextIdx, gCost, currentIdx);
+				openList.Push(nextIdx, gCost);
+			});
+		}
+	}
+
+	template <class T_GridType>
+	bool HPAStar<T_GridType>::FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const
+	{
+		path.clear();
+
+		std::vector<int>& abstractPath = context.GetAbstractPath();
+		if (!FindAbstractPath(startIdx, goalIdx, context, abstractPath))
+			return false;
+
+		path.push_back(startIdx);
+		for (size_t i = 1; i < abstractPath.size(); ++i)
+		{
+			if (!RefineSegment(abstractPath[i - 1], abstractPath[i], context, path))
+			{
+				path.clear();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <class T_GridType>
+	bool HPAStar<T_GridType>::FindAbstractPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& abstractPath) const
+	{
+		abstractPath.clear();
+		if (startIdx == goalIdx)
+		{
+			abstractPath.push_back(startIdx);
+			return true;
+		}
+
+		// Temporarily connect start and goal to the transitions of their cluster (and to each other when they share one)
+		const int startClusterIdx = GetClusterIdx(startIdx);
+		const int goalClusterIdx = GetClusterIdx(goalIdx);
+		std::vector<AbstractEdge> startEdges{};
+		std::vector<AbstractEdge> goalEdges{};
+
+		SearchCluster(startClusterIdx, startIdx, context);
+		for (const int idx : m_ClusterTransitions[startClusterIdx])
+		{
+			if (context.IsVisited(idx))
+				startEdges.push_back({ idx, context.GetCostSoFar(idx) });
+		}
+		if (startClusterIdx == goalClusterIdx && context.IsVisited(goalIdx))
+			startEdges.push_back({ goalIdx, context.GetCostSoFar(goalIdx) });
+
+		SearchCluster(goalClusterIdx, goalIdx, context);
+		for (const int idx : m_ClusterTransitions[goalClusterIdx])
+		{
+			if (context.IsVisited(idx))
+				goalEdges.push_back({ idx, context.GetCostSoFar(idx) });
+		}
+
+		// A* over the abstract graph
+		context.BeginQuery(m_pGrid->GetNrOfNodes());
+		IndexedMinHeap& openList = context.GetOpenList();
+
+		context.Visit(startIdx, 0.f, invalid_node_index);
+		openList.Push(startIdx, GetHeuristicCost(startIdx, goalIdx));
+
+		bool isGoalReached = false;
+		while (!openList.IsEmpty())
+		{
+			const int currentIdx = openList.Pop();
+			if (currentIdx == goalIdx)
+			{
+				isGoalReached = true;
+				break;
+			}
+
+			context.Close(currentIdx);
+			const float currentCost = context.GetCostSoFar(currentIdx);
+
+			auto relax = [&](int nextIdx, float edgeCost)
+			{
+				const float gCost = currentCost + edgeCost;
+				if (context.IsVisited(nextIdx) && context.GetCostSoFar(nextIdx) <= gCost)
+					return;
+
+				context.Visit(nextIdx, gCost, currentIdx);
+				openList.Push(nextIdx, gCost + GetHeuristicCost(nextIdx, goalIdx));
+			};
+
+			if (currentIdx == startIdx)
+			{
+				for (const AbstractEdge& edge : startEdges)
+					relax(edge.toIdx, edge.cost);
+			}
+
+			const auto nodeIt = m_AbstractEdges.find(currentIdx);
+			if (nodeIt != m_AbstractEdges.end())
+			{
+				for (const AbstractEdge& edge : nodeIt->second)
+					relax(edge.toIdx, edge.cost);
+			}
+
+			if (GetClusterIdx(currentIdx) == goalClusterIdx)
+			{
+				for (const AbstractEdge& edge : goalEdges)
+				{
+					if (edge.toIdx == currentIdx)
+						relax(goalIdx, edge.cost);
+				}
+			}
+		} // While-loop
+
+		if (!isGoalReached)
+			return false;
+
+		for (int idx = goalIdx; idx != invalid_node_index; idx = context.GetParent(idx))
+			abstractPath.emplace_back(idx);
+
+		std::reverse(abstractPath.begin(), abstractPath.end());
+		return true;
+	}
+
+	template <class T_GridType>
+	bool HPAStar<T_GridType>::RefineSegment(int fromIdx, int toIdx, SearchContext& context, std::vector<int>& path) const
+	{
+		// Steps between clusters always go to an adjacent cell
+		const int clusterIdx = GetClusterIdx(fromIdx);
+		if (clusterIdx != GetClusterIdx(toIdx))
+		{
+			path.push_back(toIdx);
+			return true;
+		}
+
+		const ClusterView view = GetClusterView(clusterIdx);
+		const IndexedAStar<ClusterView> pathfinder{ &view, m_HeuristicFunction };
+
+		std::vector<int>& segment = context.GetIndexPath();
+		if (!pathfinder.FindPath(fromIdx, toIdx, context, segment))
+			return false;
+
+		path.insert(path.end(), segment.begin() + 1, segment.end());
+		return true;
+	}
+
+	template <class T_GridType>
+	bool HPAStar<T_GridType>::TryGetStepCost(int fromIdx, int toIdx, float& cost) const
+	{
+		bool isConnected = false;
+		m_pGrid->ForEachNeighbor(fromIdx, [&](int nextIdx, float connectionCost)
+		{
+			if (nextIdx != toIdx)
+				return;
+
+			// Same cost model as AStar
+			cost = 1 + connectionCost;
+			isConnected = true;
+		});
+		return isConnected;
+	}
+
+	template <class T_GridType>
+	float HPAStar<T_GridType>::GetHeuristicCost(int fromIdx, int toIdx) const
+	{
+		Vector2 toDestination = m_pGrid->GetNodePos(toIdx) - m_pGrid->GetNodePos(fromIdx);
+		return m_HeuristicFunction(abs(toDestination.x), abs(toDestination.y));
+	}
+}
@@ -0,0 +1,144 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EIndexedHeap.h: Binary min-heap over node indices with decrease-key support, used as open list by the graph searches
+/*=============================================================================*/
+#pragma once
+#include <vector>
+#include "ECountingAllocator.h"
+
+namespace Elite
+{
+	class IndexedMinHeap final
+	{
+	public:
+		IndexedMinHeap() = default;
+		explicit IndexedMinHeap(int nrOfIndices) { Resize(nrOfIndices); }
+		// Counts the allocations of the heap's buffers into *pNrOfAllocations (see ECountingAllocator.h)
+		explicit IndexedMinHeap(size_t* pNrOfAllocations)
+			: m_Heap(CountingAllocator<Entry>{ pNrOfAllocations })
+			, m_Positions(CountingAllocator<int>{ pNrOfAllocations })
+		{}
+
+		// Makes room for indices [0, nrOfIndices), keeps the current content valid
+		void Resize(int nrOfIndices)
+		{
+			if (nrOfIndices > (int)m_Positions.size())
+				m_Positions.resize(nrOfIndices, invalid_position);
+			if (nrOfIndices > (int)m_Heap.capacity())
+				m_Heap.reserve(nrOfIndices);
+		}
+
+		// Only touches the entries that are still in the heap, no reallocation
+		void Clear()
+		{
+			for (const auto& entry : m_Heap)
+				m_Positions[entry.idx] = invalid_position;
+			m_Heap.clear();
+		}
+
+		bool IsEmpty() const { return m_Heap.empty(); }
+		int GetSize() const { return (int)m_Heap.size(); }
+		bool Contains(int idx) const { return idx < (int)m_Positions.size() && m_Positions[idx] != invalid_position; }
+
+		int GetTop() const { return m_Heap.front().idx; }
+		float GetTopKey() const { return m_Heap.front().key; }
+
+		// Inserts idx, or updates its key when it is already in the heap
+		void Push(int idx, float key)
+		{
+			if (Contains(idx))
+			{
+				UpdateKey(idx, key);
+				return;
+			}
+
+			m_Heap.push_back({ idx, key });
+			m_Positions[idx] = (int)m_Heap.size() - 1;
+			SiftUp(m_Positions[idx]);
+		}
+
+		void UpdateKey(int idx, float key)
+		{
+			const int pos = m_Positions[idx];
+			const float oldKey = m_Heap[pos].key;
+			m_Heap[pos].key = key;
+
+			if (key < oldKey)
+				SiftUp(pos);
+			else
+				SiftDown(pos);
+		}
+
+		int Pop()
+		{
+			const int top = m_Heap.front().idx;
+			m_Positions[top] = invalid_position;
+
+			if (m_Heap.size() > 1)
+			{
+				m_Heap.front() = m_Heap.back();
+				m_Heap.pop_back();
+				m_Positions[m_Heap.front().idx] = 0;
+				SiftDown(0);
+			}
+			else
+			{
+				m_Heap.pop_back();
+			}
+
+			return top;
+		}
+
+	private:
+		struct Entry
+		{
+			int idx;
+			float key;
+		};
+
+		enum { invalid_position = -1 };
+
+		std::vector<Entry, CountingAllocator<Entry>> m_Heap;
+		std::vector<int, CountingAllocator<int>> m_Positions; // position of every index inside m_Heap, or invalid_position
+
+		void SiftUp(int pos)
+		{
+			const Entry entry = m_Heap[pos];
+			while (pos > 0)
+			{
+				const int parent = (pos - 1) / 2;
+				if (!(entry.key < m_Heap[parent].key))
+					break;
+
+				m_Heap[pos] = m_Heap[parent];
+				m_Positions[m_Heap[pos].idx] = pos;
+				pos = parent;
+			}
+			m_Heap[pos] = entry;
+			m_Positions[entry.idx] = pos;
+		}
+
+		void SiftDown(int pos)
+		{
+			const Entry entry = m_Heap[pos];
+			const int size = (int)m_Heap.size();
+			while (true)
+			{
+				int child = 2 * pos + 1;
+				if (child >= size)
+					break;
+				if (child + 1 < size && m_Heap[child + 1].key < m_Heap[child].key)
+					++child;
+				if (!(m_Heap[child].key < entry.key))
+					break;
+
+				m_Heap[pos] = m_Heap[child];
+				m_Positions[m_Heap[pos].idx] = pos;
+				pos = child;
+			}
+			m_Heap[pos] = entry;
+			m_Positions[entry.idx] = pos;
+		}
+	};
+}
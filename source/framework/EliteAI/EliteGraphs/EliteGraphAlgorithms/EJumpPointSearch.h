@@ -0,0 +1,297 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EJumpPointSearch.h: Jump Point Search (Harabor & Grastien 2011) for uniform-cost, diagonally connected grids.
+// Works on GridGraph<GridTerrainNode, ...> and ImplicitGridGraph, using the same movement rules as those grids
+// (diagonal moves may cut corners, water is blocked) so it finds paths of the same cost as AStar.
+// Grids with mixed terrain costs or without diagonal connections are searched with IndexedAStar instead.
+// Walkability is read from the terrain, so a GridGraph's connections have to follow it (water cells isolated, every other
+// neighbour connected). A GridGraph whose connections were edited apart from the terrain (e.g. RemoveConnectionsToAdjacentNodes
+// on a land cell) is searched with IndexedAStar as well. This is checked on construction, create the search again after editing the grid.
+/*=============================================================================*/
+#pragma once
+#include "framework/EliteAI/EliteNavigation/ENavigation.h"
+#include "EAStar.h"
+
+namespace Elite
+{
+	template <class T_GridType>
+	class JumpPointSearch
+	{
+	public:
+		JumpPointSearch(const T_GridType* pGrid, Heuristic hFunction);
+
+		// True when the grid can't be searched with jumps and the queries run as regular A*
+		bool IsUsingFallback() const { return !m_CanJump; }
+
+		// Same contract as IndexedAStar::FindPath, the returned path contains every cell (not only the jump points)
+		bool FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const;
+
+	private:
+		bool IsWalkable(int col, int row) const;
+		int Jump(int col, int row, int dCol, int dRow, int goalIdx) const;
+		float GetHeuristicCost(int fromIdx, int toIdx) const;
+
+		static int Sign(int value) { return (value > 0) - (value < 0); }
+
+		// True when the connections of the grid are exactly the ones its terrain implies
+		template <class T_OtherGridType>
+		static bool HasTerrainConnections(const T_OtherGridType*) { return true; } // connections generated from the terrain
+		template <class T_NodeType, class T_ConnectionType>
+		static bool HasTerrainConnections(const GridGraph<T_NodeType, T_ConnectionType>* pGrid);
+
+		const T_GridType* m_pGrid;
+		Heuristic m_HeuristicFunction;
+
+		bool m_CanJump = false;
+		float m_StraightStepCost = 0.f;
+		float m_DiagonalStepCost = 0.f;
+	};
+
+	template <class T_GridType>
+	JumpPointSearch<T_GridType>::JumpPointSearch(const T_GridType* pGrid, Heuristic hFunction)
+		: m_pGrid(pGrid)
+		, m_HeuristicFunction(hFunction)
+	{
+		// Jumping is only valid when every walkable cell costs the same
+		TerrainType uniformTerrain = TerrainType::Water;
+		bool isUniform = true;
+		for (int idx = 0; idx < m_pGrid->GetNrOfNodes() && isUniform; ++idx)
+		{
+			const TerrainType terrain = m_pGrid->GetTerrainType(idx);
+			if (terrain == TerrainType::Water)
+				continue;
+
+			if (uniformTerrain == TerrainType::Water)
+				uniformTerrain = terrain;
+			else if (terrain != uniformTerrain)
+				isUniform = false;
+		}
+
+		m_CanJump = isUniform && m_pGrid->IsConnectedDiagonally() && HasTerrainConnections(m_pGrid);
+
+		// Step costs as seen by AStar: 1 + connection cost (see GridGraph::CalculateConnectionCost for the terrain factor)
+		const float terrainFactor = float(int(uniformTerrain == TerrainType::Water ? TerrainType::Ground : uniformTerrain));
+		m_StraightStepCost = 1 + m_pGrid->GetDefaultCostStraight() * terrainFactor;
+		m_DiagonalStepCost = 1 + m_pGrid->GetDefaultCostDiagonal() * terrainFactor;
+	}
+
+	template <class T_GridType>
+	bool JumpPointSearch<T_GridType>::FindPath(int startIdx, int goalIdx, SearchContext& context, std::vector<int>& path) const
+	{
+		if (!m_CanJump)
+			return IndexedAStar<T_GridType>(m_pGrid, m_HeuristicFunction).FindPath(startIdx, goalIdx, context, path);
+
+		path.clear();
+		context.BeginQuery(m_pGrid->GetNrOfNodes());
+		IndexedMinHeap& openList = context.GetOpenList();
+
+		const int nrOfColumns = m_pGrid->GetColumns();
+
+		// Water cells have no connections in the grid graphs, so nothing leaves or enters them
+		if (startIdx != goalIdx &&
+			(!IsWalkable(startIdx % nrOfColumns, startIdx / nrOfColumns) || !IsWalkable(goalIdx % nrOfColumns, goalIdx / nrOfColumns)))
+			return false;
+
+		context.Visit(startIdx, 0.f, invalid_node_index);
+		openList.Push(startIdx, GetHeuristicCost(startIdx, goalIdx));
+
+		bool isGoalReached = false;
+		while (!openList.IsEmpty())
+		{
+			const int currentIdx = openList.Pop();
+			if (currentIdx == goalIdx)
+			{
+				isGoalReached = true;
+				break;
+			}
+
+			context.Close(currentIdx);
+			const float currentCost = context.GetCostSoFar(currentIdx);
+			const int col = currentIdx % nrOfColumns;
+			const int row = currentIdx / nrOfColumns;
+
+			// Direction we arrived from, (0, 0) for the start node so all 8 directions are explored
+			int dCol = 0, dRow = 0;
+			const int parentIdx = context.GetParent(currentIdx);
+			if (parentIdx != invalid_node_index)
+			{
+				dCol = Sign(col - parentIdx % nrOfColumns);
+				dRow = Sign(row - parentIdx / nrOfColumns);
+			}
+
+			// Pruned successor directions: the natural neighbours plus the forced ones
+			int directions[8][2]{};
+			int nrOfDirections = 0;
+			auto addDirection = [&](int c, int r) { directions[nrOfDirections][0] = c; directions[nrOfDirections][1] = r; ++nrOfDirections; };
+
+			if (dCol == 0 && dRow == 0)
+			{
+				for (int c = -1; c <= 1; ++c)
+					for (int r = -1; r <= 1; ++r)
+						if (c != 0 || r != 0)
+							addDirection(c, r);
+			}
+			else if (dCol != 0 && dRow != 0)
+			{
+				addDirection(dCol, 0);
+				addDirection(0, dRow);
+				addDirection(dCol, dRow);
+				if (!IsWalkable(col - dCol, row))
+					addDirection(-dCol, dRow);
+				if (!IsWalkable(col, row - dRow))
+					addDirection(dCol, -dRow);
+			}
+			else if (dCol != 0)
+			{
+				addDirection(dCol, 0);
+				if (!IsWalkable(col, row + 1))
+					addDirection(dCol, 1);
+				if (!IsWalkable(col, row - 1))
+					addDirection(dCol, -1);
+			}
+			else
+			{
+				addDirection(0, dRow);
+				if (!IsWalkable(col + 1, row))
+					addDirection(1, dRow);
+				if (!IsWalkable(col - 1, row))
+					addDirection(-1, dRow);
+			}
+
+			for (int d = 0; d < nrOfDirections; ++d)
+			{
+				const int jumpIdx = Jump(col, row, directions[d][0], directions[d][1], goalIdx);
+				if (jumpIdx == invalid_node_index)
+					continue;
+
+				const int nrOfSteps = std::max(abs(jumpIdx % nrOfColumns - col), abs(jumpIdx / nrOfColumns - row));
+				const bool isDiagonal = directions[d][0] != 0 && directions[d][1] != 0;
+				const float gCost = currentCost + nrOfSteps * (isDiagonal ? m_DiagonalStepCost : m_StraightStepCost);
+
+				if (context.IsVisited(jumpIdx) && context.GetCostSoFar(jumpIdx) <= gCost)
+					continue;
+
+				context.Visit(jumpIdx, gCost, currentIdx);
+				openList.Push(jumpIdx, gCost + GetHeuristicCost(jumpIdx, goalIdx));
+			}
+		} // While-loop
+
+		if (!isGoalReached)
+			return false;
+
+		// Walk back over the jump points, filling in the cells in between
+		for (int idx = goalIdx; idx != startIdx; idx = context.GetParent(idx))
+		{
+			const int parentIdx = context.GetParent(idx);
+			const int stepCol = Sign(parentIdx % nrOfColumns - idx % nrOfColumns);
+			const int stepRow = Sign(parentIdx / nrOfColumns - idx / nrOfColumns);
+
+			for (int cellIdx = idx; cellIdx != parentIdx; cellIdx += stepRow * nrOfColumns + stepCol)
+				path.emplace_back(cellIdx);
+		}
+		path.emplace_back(startIdx);
+
+		std::reverse(path.begin(), path.end());
+		return true;
+	}
+
+	template <class T_GridType>
+	template <class T_NodeType, class T_ConnectionType>
+	bool JumpPointSearch<T_GridType>::HasTerrainConnections(const GridGraph<T_NodeType, T_ConnectionType>* pGrid)
+	{
+		const auto isLand = [pGrid](int col, int row)
+		{
+			return pGrid->IsWithinBounds(col, row) && pGrid->GetTerrainType(pGrid->GetIndex(col, row)) != TerrainType::Water;
+		};
+
+		for (int row = 0; row < pGrid->GetRows(); ++row)
+		{
+			for (int col = 0; col < pGrid->GetColumns(); ++col)
+			{
+				const int idx = pGrid->GetIndex(col, row);
+				const auto& connections = pGrid->GetConnections(idx);
+
+				if (!isLand(col, row))
+				{
+					if (!connections.empty())
+						return false;
+					continue;
+				}
+
+				// Every connection leads to a neighbouring land cell, and every neighbouring land cell is connected
+				size_t nrOfLandNeighbors = 0;
+				for (int dRow = -1; dRow <= 1; ++dRow)
+				{
+					for (int dCol = -1; dCol <= 1; ++dCol)
+					{
+						if ((dCol != 0 || dRow != 0) && isLand(col + dCol, row + dRow))
+						{
+							++nrOfLandNeighbors;
+							if (!pGrid->GetConnection(idx, pGrid->GetIndex(col + dCol, row + dRow)))
+								return false;
+						}
+					}
+				}
+				if (connections.size() != nrOfLandNeighbors)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	template <class T_GridType>
+	bool JumpPointSearch<T_GridType>::IsWalkable(int col, int row) const
+	{
+		return m_pGrid->IsWithinBounds(col, row) && m_pGrid->GetTerrainType(m_pGrid->GetIndex(col, row)) != TerrainType::Water;
+	}
+
+	template <class T_GridType>
+	int JumpPointSearch<T_GridType>::Jump(int col, int row, int dCol, int dRow, int goalIdx) const
+	{
+		// Step in one direction until we hit a wall, the goal or a node with a forced neighbour
+		while (true)
+		{
+			col += dCol;
+			row += dRow;
+
+			if (!IsWalkable(col, row))
+				return invalid_node_index;
+
+			const int idx = m_pGrid->GetIndex(col, row);
+			if (idx == goalIdx)
+				return idx;
+
+			if (dCol != 0 && dRow != 0)
+			{
+				if ((IsWalkable(col - dCol, row + dRow) && !IsWalkable(col - dCol, row)) ||
+					(IsWalkable(col + dCol, row - dRow) && !IsWalkable(col, row - dRow)))
+					return idx;
+
+				// A diagonal jump stops at every cell from which a straight jump finds something
+				if (Jump(col, row, dCol, 0, goalIdx) != invalid_node_index ||
+					Jump(col, row, 0, dRow, goalIdx) != invalid_node_index)
+					return idx;
+			}
+			else if (dCol != 0)
+			{
+				if ((IsWalkable(col + dCol, row + 1) && !IsWalkable(col, row + 1)) ||
+					(IsWalkable(col + dCol, row - 1) && !IsWalkable(col, row - 1)))
+					return idx;
+			}
+			else
+			{
+				if ((IsWalkable(col + 1, row + dRow) && !IsWalkable(col + 1, row)) ||
+					(IsWalkable(col - 1, row + dRow) && !IsWalkable(col - 1, row)))
+					return idx;
+			}
+		}
+	}
+
+	template <class T_GridType>
+	float JumpPointSearch<T_GridType>::GetHeuristicCost(int fromIdx, int toIdx) const
+	{
+		Vector2 toDestination = m_pGrid->GetNodePos(toIdx) - m_pGrid->GetNodePos(fromIdx);
+		return m_HeuristicFunction(abs(toDestination.x), abs(toDestination.y));
+	}
+}
@@ -0,0 +1,98 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ESearchContext.h: Reusable per-node search state for the graph searches.
+// The records are stamped with a query generation, so starting a new query does not have to clear them.
+// Once the context (and the path buffer) are sized for a graph, queries don't allocate. The A* benchmark checks this
+// by passing an allocation counter to the context.
+/*=============================================================================*/
+#pragma once
+#include <vector>
+#include "framework/EliteAI/EliteGraphs/EGraphEnums.h"
+#include "EIndexedHeap.h"
+
+namespace Elite
+{
+	class SearchContext final
+	{
+	public:
+		SearchContext() = default;
+		explicit SearchContext(int nrOfNodes) { Resize(nrOfNodes); }
+		// Counts the allocations of the per-node buffers into *pNrOfAllocations, which has to outlive the context.
+		// The index path is a plain std::vector (the searches write it as their result), it allocates when its capacity grows.
+		SearchContext(int nrOfNodes, size_t* pNrOfAllocations)
+			: m_Records(CountingAllocator<Record>{ pNrOfAllocations })
+			, m_OpenList(pNrOfAllocations)
+			, m_Frontier(CountingAllocator<int>{ pNrOfAllocations })
+		{
+			Resize(nrOfNodes);
+		}
+
+		// Only allocates when the graph has more nodes than any previous query
+		void Resize(int nrOfNodes)
+		{
+			if (nrOfNodes > (int)m_Records.size())
+				m_Records.resize(nrOfNodes);
+			m_OpenList.Resize(nrOfNodes);
+			if (nrOfNodes > (int)m_Frontier.capacity())
+				m_Frontier.reserve(nrOfNodes);
+		}
+
+		// Invalidates every record from the previous query in O(1)
+		void BeginQuery(int nrOfNodes)
+		{
+			Resize(nrOfNodes);
+			m_OpenList.Clear();
+			m_NrOfExpandedNodes = 0;
+
+			if (++m_Generation == 0)
+			{
+				// Generation counter wrapped around, old stamps could be mistaken for this query
+				for (auto& record : m_Records)
+					record.generation = 0;
+				m_Generation = 1;
+			}
+		}
+
+		bool IsVisited(int idx) const { return m_Records[idx].generation == m_Generation; }
+		bool IsClosed(int idx) const { return IsVisited(idx) && m_Records[idx].isClosed; }
+
+		float GetCostSoFar(int idx) const { return m_Records[idx].costSoFar; }
+		int GetParent(int idx) const { return m_Records[idx].parentIdx; }
+
+		void Visit(int idx, float costSoFar, int parentIdx)
+		{
+			Record& record = m_Records[idx];
+			record.generation = m_Generation;
+			record.costSoFar = costSoFar;
+			record.parentIdx = parentIdx;
+			record.isClosed = false;
+		}
+		void Close(int idx) { m_Records[idx].isClosed = true; ++m_NrOfExpandedNodes; }
+
+		// Number of nodes the last query expanded (statistics for benchmarking the searches)
+		int GetNrOfExpandedNodes() const { return m_NrOfExpandedNodes; }
+
+		IndexedMinHeap& GetOpenList() { return m_OpenList; }
+		std::vector<int, CountingAllocator<int>>& GetFrontier() { return m_Frontier; } // FIFO buffer for the breadth-first searches
+		std::vector<int>& GetIndexPath() { return m_IndexPath; } // result buffer when a search runs through a node pointer wrapper
+		std::vector<int>& GetAbstractPath() { return m_AbstractPath; } // abstract path of a hierarchical search, before it is refined
+
+	private:
+		struct Record
+		{
+			unsigned int generation = 0;
+			float costSoFar = 0.f;
+			int parentIdx = invalid_node_index;
+			bool isClosed = false;
+		};
+
+		std::vector<Record, CountingAllocator<Record>> m_Records;
+		IndexedMinHeap m_OpenList;
+		std::vector<int, CountingAllocator<int>> m_Frontier;
+		std::vector<int> m_IndexPath;
+		std::vector<int> m_AbstractPath;
+		unsigned int m_Generation = 0;
+		int m_NrOfExpandedNodes = 0;
+	};
+}
@@ -28,6 +28,52 @@ namespace Elite
 
 	
 
+	void GraphRenderer::RenderGraph(const ImplicitGridGraph* pGraph, bool renderNodes, bool renderNodeNumbers, bool renderConnections, bool renderConnectionsCosts) const
+	{
+		const int nrOfNodes = pGraph->GetNrOfNodes();
+
+		if (renderNodes)
+		{
+			//Nodes/Grid
+			for (int idx = 0; idx < nrOfNodes; ++idx)
+			{
+				std::string nodeTxt{};
+				if (renderNodeNumbers)
+					nodeTxt = std::to_string(idx);
+
+				RenderRectNode(pGraph->GetNodeWorldPos(idx), nodeTxt, float(pGraph->GetCellSize()), pGraph->GetNodeColor(idx), 0.1f);
+			}
+		}
+
+		if (renderConnections)
+		{
+			//Connections are generated on the fly, just like during a search
+			for (int idx = 0; idx < nrOfNodes; ++idx)
+			{
+				pGraph->ForEachNeighbor(idx, [&](int toIdx, float cost)
+				{
+					std::string conTxt{};
+					if (renderConnectionsCosts)
+					{
+						std::stringstream ss;
+						ss << std::fixed << std::setprecision(m_FloatPrintPrecision) << cost;
+						conTxt = ss.str();
+					}
+
+					RenderConnection(nullptr, pGraph->GetNodeWorldPos(toIdx), pGraph->GetNodeWorldPos(idx), conTxt);
+				});
+			}
+		}
+	}
+
+	void GraphRenderer::HighlightNodes(const ImplicitGridGraph* pGraph, const std::vector<int>& path, Color col /*= HIGHLIGHTED_NODE_COLOR*/) const
+	{
+		for (const int idx : path)
+		{
+			RenderCircleNode(pGraph->GetNodeWorldPos(idx), "", 3.1f, col, -0.2f);
+		}
+	}
+
 	void GraphRenderer::RenderConnection(GraphConnection* con, Elite::Vector2 toPos, Elite::Vector2 fromPos, std::string text, Elite::Color col, float depth/*= 0.0f*/) const
 	{
 		auto center = toPos + (fromPos - toPos) / 2;
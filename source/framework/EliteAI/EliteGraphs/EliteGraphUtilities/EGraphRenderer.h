@@ -5,6 +5,7 @@
 #include "framework\EliteAI\EliteGraphs\EGraphConnectionTypes.h"
 #include "framework\EliteAI\EliteGraphs\EGridGraph.h"
 #include "framework\EliteAI\EliteGraphs\EGraph2D.h"
+#include "framework\EliteAI\EliteGraphs\EImplicitGridGraph.h"
 #include  <type_traits>
 
 namespace Elite 
@@ -24,6 +25,9 @@ namespace Elite
 		template<class T_NodeType, class T_ConnectionType>
 		void HighlightNodes(GridGraph<T_NodeType, T_ConnectionType>* pGraph, std::vector<T_NodeType*> path, Color col = HIGHLIGHTED_NODE_COLOR) const;
 
+		void RenderGraph(const ImplicitGridGraph* pGraph, bool renderNodes, bool renderNodeTxt, bool renderConnections, bool renderConnectionsCosts) const;
+		void HighlightNodes(const ImplicitGridGraph* pGraph, const std::vector<int>& path, Color col = HIGHLIGHTED_NODE_COLOR) const;
+
 		void SetNumberPrintPrecision(int precision) { m_FloatPrintPrecision = precision; }
 
 	private:
@@ -4,86 +4,168 @@
 #include "framework/EliteMath/EMath.h"
 #include "framework\EliteAI\EliteGraphs\ENavGraph.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EAStar.h"
+#include "EPathSmoothing.h"
 
 namespace Elite
 {
-	class NavMeshPathfinding
+	// Search view over a shared NavGraph, with the start and end position injected as two virtual nodes (the indices right after the graph's nodes).
+	// Follows the neighbour-iteration concept (see EGraphCSR.h), the NavGraph itself is never modified.
+	class NavMeshQueryGraph final
 	{
 	public:
-		static std::vector<Vector2> FindPath(Vector2 startPos, Vector2 endPos, NavGraph* pNavGraph, std::vector<Vector2>& debugNodePositions, std::vector<Portal>& debugPortals)
+		NavMeshQueryGraph(const NavGraph* pNavGraph, const Vector2& startPos, const Vector2& endPos, const int* startLineNodes, const int* endLineNodes)
+			: m_pNavGraph(pNavGraph)
+			, m_NrOfGraphNodes(pNavGraph->GetNrOfNodes())
+			, m_StartPos(startPos)
+			, m_EndPos(endPos)
+			, m_pStartLineNodes(startLineNodes)
+			, m_pEndLineNodes(endLineNodes)
 		{
-			//Create the path to return
-			std::vector<Vector2> finalPath{};
+		}
+
+		int GetStartIdx() const { return m_NrOfGraphNodes; }
+		int GetEndIdx() const { return m_NrOfGraphNodes + 1; }
 
-			//Get the start and endTriangle
-			Triangle *startTriangle = nullptr, *endTriangle = nullptr;
-			for (const auto tri : pNavGraph->GetNavMeshPolygon()->GetTriangles())
+		int GetNrOfNodes() const { return m_NrOfGraphNodes + 2; }
+		bool IsNodeActive(int idx) const { return idx >= m_NrOfGraphNodes || m_pNavGraph->IsNodeActive(idx); }
+		Vector2 GetNodePos(int idx) const
+		{
+			if (idx == GetStartIdx())
+				return m_StartPos;
+			if (idx == GetEndIdx())
+				return m_EndPos;
+			return m_pNavGraph->GetNodePos(idx);
+		}
+
+		template<class T_Func>
+		void ForEachNeighbor(int idx, T_Func func) const
+		{
+			// Start only connects to the nodes on the lines of its triangle, the end is never left
+			if (idx == GetStartIdx())
 			{
-				if (PointInTriangle(startPos, tri->p1, tri->p2, tri->p3))
-				{
-					startTriangle = tri;
-				}
-				if (PointInTriangle(endPos, tri->p1, tri->p2, tri->p3))
+				for (int i = 0; i < 3; ++i)
 				{
-					endTriangle = tri;
+					if (m_pStartLineNodes[i] != invalid_node_index)
+						func(m_pStartLineNodes[i], Distance(m_StartPos, m_pNavGraph->GetNodePos(m_pStartLineNodes[i])));
 				}
-
-				// we got start and end triangle, stop looping triangles
-				if (startTriangle != nullptr && endTriangle != nullptr) break;
+				return;
 			}
+			if (idx == GetEndIdx())
+				return;
 
-			if (startTriangle == nullptr || endTriangle == nullptr) return finalPath;
-		
-			if (startTriangle == endTriangle)
+			m_pNavGraph->ForEachNeighbor(idx, func);
+			for (int i = 0; i < 3; ++i)
 			{
-				finalPath.push_back(endPos);
-				return finalPath;
+				if (m_pEndLineNodes[i] == idx)
+					func(GetEndIdx(), Distance(m_pNavGraph->GetNodePos(idx), m_EndPos));
 			}
-			
-			//We have valid start/end triangles and they are not the same
-			//=> Start looking for a path
-			//Copy the graph
-			auto pNavGraphCopy = pNavGraph->Clone();
-			
-			//Create extra node for the Start Node (Agent's position)
-			NavGraphNode* startNode = new NavGraphNode{ pNavGraphCopy->GetNextFreeNodeIndex(), -1, startPos};
-			pNavGraphCopy->AddNode(startNode);
-			for (const int lineIndex : startTriangle->metaData.IndexLines)
+		}
+
+	private:
+		const NavGraph* m_pNavGraph;
+		int m_NrOfGraphNodes;
+		Vector2 m_StartPos;
+		Vector2 m_EndPos;
+		const int* m_pStartLineNodes;
+		const int* m_pEndLineNodes;
+	};
+
+	// Reusable navmesh query: keeps its search state and buffers between queries, so repeated queries don't allocate.
+	// The NavGraph is only read, so every thread can run queries on the same graph with its own NavMeshQuery.
+	class NavMeshQuery final
+	{
+	public:
+		NavMeshQuery() = default;
+
+		// Fills the smoothed path from startPos to endPos, returns false (and an empty path) when there is none
+		bool FindPath(const Vector2& startPos, const Vector2& endPos, const NavGraph* pNavGraph, std::vector<Vector2>& path)
+		{
+			path.clear();
+			m_NodePositions.clear();
+			m_Portals.clear();
+
+			//Get the start and endTriangle, positions off the navmesh are clamped to the closest point on it
+			const Polygon* pNavMeshPolygon = pNavGraph->GetNavMeshPolygon();
+			Vector2 clampedStartPos{}, clampedEndPos{};
+			const Triangle* startTriangle = GetWalkableTriangle(pNavMeshPolygon, startPos, clampedStartPos);
+			const Triangle* endTriangle = GetWalkableTriangle(pNavMeshPolygon, endPos, clampedEndPos);
+
+			if (startTriangle == nullptr || endTriangle == nullptr) return false;
+
+			if (startTriangle == endTriangle)
 			{
-				int nodeIndex = pNavGraph->GetNodeIdxFromLineIdx(lineIndex);
-				if (nodeIndex == invalid_node_index) continue;
-				const auto lineNode = pNavGraphCopy->GetNode(nodeIndex);
-				pNavGraphCopy->AddConnection(new GraphConnection2D{nodeIndex, startNode->GetIndex(), Distance(lineNode->GetPosition(), startNode->GetPosition())});
+				path.push_back(clampedEndPos);
+				return true;
 			}
 
-			//Create extra node for the endNode
-			NavGraphNode* endNode = new NavGraphNode{ pNavGraphCopy->GetNextFreeNodeIndex(), -1, endPos };
-			pNavGraphCopy->AddNode(endNode);
-			for (const auto lineIndex : endTriangle->metaData.IndexLines)
+			//Connect the start and end position to the nodes on the lines of their triangle, without touching the graph
+			int startLineNodes[3]{}, endLineNodes[3]{};
+			for (int i = 0; i < 3; ++i)
 			{
-				int nodeIndex = pNavGraph->GetNodeIdxFromLineIdx(lineIndex);
-				if (nodeIndex == invalid_node_index) continue;
-				const auto lineNode = pNavGraphCopy->GetNode(nodeIndex);
-				pNavGraphCopy->AddConnection(new GraphConnection2D{ nodeIndex, endNode->GetIndex(), Distance(lineNode->GetPosition(), endNode->GetPosition()) });
+				startLineNodes[i] = pNavGraph->GetNodeIdxFromLineIdx(startTriangle->metaData.IndexLines[i]);
+				endLineNodes[i] = pNavGraph->GetNodeIdxFromLineIdx(endTriangle->metaData.IndexLines[i]);
 			}
 
-			//Run A star on new graph
-			auto pathfinder = AStar<NavGraphNode, GraphConnection2D>(pNavGraphCopy.get(), Elite::HeuristicFunctions::Euclidean);
-			std::vector<Elite::NavGraphNode*> m_vPath = pathfinder.FindPath(startNode, endNode);
+			//Run A star with the start and end as virtual nodes
+			const NavMeshQueryGraph queryGraph{ pNavGraph, clampedStartPos, clampedEndPos, startLineNodes, endLineNodes };
+			const IndexedAStar<NavMeshQueryGraph> pathfinder{ &queryGraph, HeuristicFunctions::Euclidean };
+			if (!pathfinder.FindPath(queryGraph.GetStartIdx(), queryGraph.GetEndIdx(), m_Context, m_IndexPath))
+				return false;
 
-			for (const auto node : m_vPath)
+			m_LineIndices.clear();
+			for (const int idx : m_IndexPath)
 			{
-				finalPath.emplace_back(node->GetPosition());
+				m_NodePositions.emplace_back(queryGraph.GetNodePos(idx));
+				m_LineIndices.emplace_back(idx < pNavGraph->GetNrOfNodes() ? pNavGraph->GetNode(idx)->GetLineIndex() : -1);
 			}
-			
-			//OPTIONAL BUT ADVICED: Debug Visualisation
-			debugNodePositions = finalPath;
 
-			//Run optimiser on new graph, MAKE SURE the A star path is working properly before starting this section and uncommenting this!!!
-			const auto portals = SSFA::FindPortals(m_vPath, pNavGraph->GetNavMeshPolygon());
-			finalPath = SSFA::OptimizePortals(portals);
+			//Run optimiser on the path
+			SSFA::FindPortals(m_NodePositions, m_LineIndices, pNavMeshPolygon, m_Portals);
+			SSFA::OptimizePortals(m_Portals, path);
+			return true;
+		}
+
+		// Debug information of the last query: the unoptimised path and the portals it crossed
+		const std::vector<Vector2>& GetDebugNodePositions() const { return m_NodePositions; }
+		const std::vector<Portal>& GetDebugPortals() const { return m_Portals; }
+
+	private:
+		static const Triangle* GetWalkableTriangle(const Polygon* pNavMeshPolygon, const Vector2& position, Vector2& walkablePosition)
+		{
+			walkablePosition = position;
+			const Triangle* pTriangle = pNavMeshPolygon->GetTriangleFromPosition(position);
+			if (pTriangle)
+				return pTriangle;
+
+			//Off the navmesh (or exactly on an edge): move the position just inside the closest triangle
+			pTriangle = pNavMeshPolygon->GetClosestTriangle(position, walkablePosition);
+			if (pTriangle)
+				walkablePosition += (pTriangle->GetCenter() - walkablePosition) * 0.01f;
+			return pTriangle;
+		}
+
+		SearchContext m_Context;
+		std::vector<int> m_IndexPath;
+		std::vector<int> m_LineIndices;
+		std::vector<Vector2> m_NodePositions;
+		std::vector<Portal> m_Portals;
+	};
 
-			debugPortals = portals;
+	class NavMeshPathfinding
+	{
+	public:
+		// Convenience function for a single query, keep a NavMeshQuery around for repeated queries
+		static std::vector<Vector2> FindPath(Vector2 startPos, Vector2 endPos, NavGraph* pNavGraph, std::vector<Vector2>& debugNodePositions, std::vector<Portal>& debugPortals)
+		{
+			//Create the path to return
+			std::vector<Vector2> finalPath{};
+
+			NavMeshQuery query{};
+			query.FindPath(startPos, endPos, pNavGraph, finalPath);
+
+			//OPTIONAL BUT ADVICED: Debug Visualisation
+			debugNodePositions = query.GetDebugNodePositions();
+			debugPortals = query.GetDebugPortals();
 			return finalPath;
 		}
 	};
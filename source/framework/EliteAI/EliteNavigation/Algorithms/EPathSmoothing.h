@@ -29,23 +29,41 @@ namespace Elite
 			const std::vector<NavGraphNode*>& nodePath,
 			Polygon* navMeshPolygon)
 		{
+			std::vector<Vector2> positions = {};
+			std::vector<int> lineIndices = {};
+			for (const auto pNode : nodePath)
+			{
+				positions.push_back(pNode->GetPosition());
+				lineIndices.push_back(pNode->GetLineIndex());
+			}
+
 			//Container
 			std::vector<Portal> vPortals = {};
+			FindPortals(positions, lineIndices, navMeshPolygon, vPortals);
+			return vPortals;
+		}
 
-			vPortals.push_back(Portal(Line(nodePath[0]->GetPosition(), nodePath[0]->GetPosition())));
+		//Same as above, for a path given as node positions and the line index of every node (the first and last entry are the start and end position)
+		static void FindPortals(
+			const std::vector<Vector2>& pathPositions,
+			const std::vector<int>& pathLineIndices,
+			const Polygon* navMeshPolygon,
+			std::vector<Portal>& vPortals)
+		{
+			vPortals.clear();
+			vPortals.push_back(Portal(Line(pathPositions[0], pathPositions[0])));
 
-			std::vector<Line*> lines = navMeshPolygon->GetLines();
+			const std::vector<Line*>& lines = navMeshPolygon->GetLines();
 
 			//For each node received, get its corresponding line
-			for (size_t nodeIdx = 1; nodeIdx < nodePath.size() - 1; ++nodeIdx)
+			for (size_t nodeIdx = 1; nodeIdx < pathPositions.size() - 1; ++nodeIdx)
 			{
 				//Local variables
-				NavGraphNode* pNode = nodePath[nodeIdx]; //Store node, except last node, because this is our target node!
-				Line* pLine = lines[pNode->GetLineIndex()];
+				const Line* pLine = lines[pathLineIndices[nodeIdx]]; //Except last node, because this is our target node!
 
 				//Redetermine it's "orientation" based on the required path (left-right vs right-left) - p1 should be right point
 				Vector2 centerLine = (pLine->p1 + pLine->p2) / 2.0f;
-				Vector2 previousPosition = nodeIdx == 0 ? nodePath[0]->GetPosition() : nodePath[nodeIdx - 1]->GetPosition();
+				Vector2 previousPosition = pathPositions[nodeIdx - 1];
 
 				float cross = Cross((centerLine - previousPosition), (pLine->p1 - previousPosition));
 
@@ -59,15 +77,21 @@ namespace Elite
 				vPortals.push_back(Portal(portalLine));
 			}
 			//Add degenerate portal to force end evaluation
-			vPortals.push_back(Portal(Line(nodePath[nodePath.size() - 1]->GetPosition(), nodePath[nodePath.size() - 1]->GetPosition())));
-
-			return vPortals;
+			vPortals.push_back(Portal(Line(pathPositions.back(), pathPositions.back())));
 		}
 
 		static std::vector<Vector2> OptimizePortals(const std::vector<Portal>& portals)
 		{
-			//P1 == right point of portal, P2 == left point of portal
 			std::vector<Vector2> vPath = {};
+			OptimizePortals(portals, vPath);
+			return vPath;
+		}
+
+		//Same as above, writes into an existing path container
+		static void OptimizePortals(const std::vector<Portal>& portals, std::vector<Vector2>& vPath)
+		{
+			//P1 == right point of portal, P2 == left point of portal
+			vPath.clear();
 			const unsigned int amtPortals{ static_cast<unsigned int>(portals.size()) };
 
 			int apexIdx{ 0 }, leftLegIdx{ 1 }, rightLegIdx{ 1 };
@@ -132,7 +156,6 @@ namespace Elite
 
 			// Add last path point (You can use the last portal p1 or p2 points as both are equal to the endPoint of the path
 			vPath.emplace_back(portals.back().Line.p2);
-			return vPath;
 		}
 	private:
 		SSFA() {};
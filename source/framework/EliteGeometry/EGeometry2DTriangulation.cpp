@@ -0,0 +1,385 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGeometry2DTriangulation.cpp: Monotone decomposition triangulation (de Berg et al., Computational Geometry, chapter 3).
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EGeometry2DTriangulation.h"
+#include <set>
+
+namespace
+{
+	using namespace Elite;
+
+	enum class VertexType { Start, End, Split, Merge, Regular };
+
+	class MonotoneDecomposition final
+	{
+	public:
+		MonotoneDecomposition(const std::vector<Vector2>& vertices, const std::vector<int>& ringOffsets);
+
+		void Triangulate(std::vector<int>& triangleIndices);
+
+	private:
+		//Sweep order: top to bottom, left to right on equal heights (as if the plane was slightly rotated)
+		bool IsAbove(int a, int b) const
+		{
+			const Vector2& pa = m_Vertices[a];
+			const Vector2& pb = m_Vertices[b];
+			if (pa.y != pb.y)
+				return pa.y > pb.y;
+			if (pa.x != pb.x)
+				return pa.x < pb.x;
+			return a < b;
+		}
+		//Point p lies right of the edge starting at vertex e (edges are walked downwards)
+		bool IsRightOfEdge(int e, const Vector2& p) const
+		{
+			int upper = e, lower = m_Next[e];
+			if (IsAbove(lower, upper))
+				std::swap(upper, lower);
+			return Cross(m_Vertices[lower] - m_Vertices[upper], p - m_Vertices[upper]) > 0.f;
+		}
+
+		//Sweep position to look up in the status, left of every edge that doesn't have the point on its right
+		struct SweepPoint final
+		{
+			Vector2 position;
+		};
+
+		//Status of the sweep line: the edges with the polygon's interior on their right, ordered left to right
+		struct EdgeOrder final
+		{
+			using is_transparent = void;
+
+			const MonotoneDecomposition* pDecomposition;
+			bool operator()(int e, const SweepPoint& p) const { return pDecomposition->IsRightOfEdge(e, p.position); }
+			bool operator()(const SweepPoint& p, int e) const { return !pDecomposition->IsRightOfEdge(e, p.position); }
+			bool operator()(int a, int b) const
+			{
+				//Compare at the upper vertex of the edge that was inserted last, that one lies within the other edge's span
+				const auto& d = *pDecomposition;
+				const int upperA = d.IsAbove(a, d.m_Next[a]) ? a : d.m_Next[a];
+				const int upperB = d.IsAbove(b, d.m_Next[b]) ? b : d.m_Next[b];
+				if (upperA == upperB)
+					return a != b && d.IsRightOfEdge(a, d.m_Vertices[d.m_Next[b] == upperB ? b : d.m_Next[b]]);
+				if (d.IsAbove(upperA, upperB))
+					return d.IsRightOfEdge(a, d.m_Vertices[upperB]);
+				return !d.IsRightOfEdge(b, d.m_Vertices[upperA]);
+			}
+		};
+
+		VertexType GetVertexType(int v) const;
+		int FindEdgeLeftOf(int v) const;
+		void InsertEdge(int e, int helper);
+		void RemoveEdge(int e);
+		void AddDiagonalToMergeHelper(int v, int e);
+
+		void SplitIntoMonotonePieces();
+		void TriangulateMonotonePiece(const std::vector<int>& piece, std::vector<int>& triangleIndices);
+
+		const std::vector<Vector2>& m_Vertices;
+		std::vector<int> m_Next, m_Prev;
+		std::vector<int> m_Helpers;
+		std::set<int, EdgeOrder> m_Status;
+		std::vector<std::set<int, EdgeOrder>::iterator> m_StatusIterators;
+		std::vector<std::pair<int, int>> m_Diagonals;
+	};
+
+	MonotoneDecomposition::MonotoneDecomposition(const std::vector<Vector2>& vertices, const std::vector<int>& ringOffsets)
+		: m_Vertices(vertices)
+		, m_Next(vertices.size())
+		, m_Prev(vertices.size())
+		, m_Helpers(vertices.size(), -1)
+		, m_Status(EdgeOrder{ this })
+		, m_StatusIterators(vertices.size())
+	{
+		//Link the rings so the interior is always on the left: outer shape counter clockwise, holes clockwise
+		for (size_t r = 0; r + 1 < ringOffsets.size(); ++r)
+		{
+			const int first = ringOffsets[r];
+			const int last = ringOffsets[r + 1] - 1;
+
+			float signedArea = 0.f;
+			for (int i = first; i <= last; ++i)
+				signedArea += Cross(m_Vertices[i], m_Vertices[i == last ? first : i + 1]);
+
+			const bool isReversed = (r == 0) != (signedArea > 0.f);
+			for (int i = first; i <= last; ++i)
+			{
+				const int next = (i == last) ? first : i + 1;
+				const int prev = (i == first) ? last : i - 1;
+				m_Next[i] = isReversed ? prev : next;
+				m_Prev[i] = isReversed ? next : prev;
+			}
+		}
+	}
+
+	VertexType MonotoneDecomposition::GetVertexType(int v) const
+	{
+		const int prev = m_Prev[v];
+		const int next = m_Next[v];
+		const bool isConvex = Cross(m_Vertices[v] - m_Vertices[prev], m_Vertices[next] - m_Vertices[v]) > 0.f;
+
+		if (IsAbove(v, prev) && IsAbove(v, next))
+			return isConvex ? VertexType::Start : VertexType::Split;
+		if (IsAbove(prev, v) && IsAbove(next, v))
+			return isConvex ? VertexType::End : VertexType::Merge;
+		return VertexType::Regular;
+	}
+
+	int MonotoneDecomposition::FindEdgeLeftOf(int v) const
+	{
+		//First edge that doesn't have v on its right, the one before it is directly left of v
+		const auto it = m_Status.lower_bound(SweepPoint{ m_Vertices[v] });
+		return it == m_Status.begin() ? -1 : *std::prev(it);
+	}
+
+	void MonotoneDecomposition::InsertEdge(int e, int helper)
+	{
+		m_StatusIterators[e] = m_Status.insert(e).first;
+		m_Helpers[e] = helper;
+	}
+
+	void MonotoneDecomposition::RemoveEdge(int e)
+	{
+		if (m_Helpers[e] == -1)
+			return;
+		m_Status.erase(m_StatusIterators[e]);
+		m_Helpers[e] = -1;
+	}
+
+	void MonotoneDecomposition::AddDiagonalToMergeHelper(int v, int e)
+	{
+		if (e != -1 && m_Helpers[e] != -1 && GetVertexType(m_Helpers[e]) == VertexType::Merge)
+			m_Diagonals.emplace_back(v, m_Helpers[e]);
+	}
+
+	void MonotoneDecomposition::SplitIntoMonotonePieces()
+	{
+		std::vector<int> order(m_Vertices.size());
+		for (int i = 0; i < static_cast<int>(order.size()); ++i)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [this](int a, int b) { return IsAbove(a, b); });
+
+		for (const int v : order)
+		{
+			const int prevEdge = m_Prev[v]; //Edges are identified by their start vertex
+			switch (GetVertexType(v))
+			{
+			case VertexType::Start:
+				InsertEdge(v, v);
+				break;
+			case VertexType::End:
+				AddDiagonalToMergeHelper(v, prevEdge);
+				RemoveEdge(prevEdge);
+				break;
+			case VertexType::Split:
+			{
+				const int leftEdge = FindEdgeLeftOf(v);
+				if (leftEdge != -1)
+				{
+					m_Diagonals.emplace_back(v, m_Helpers[leftEdge]);
+					m_Helpers[leftEdge] = v;
+				}
+				InsertEdge(v, v);
+				break;
+			}
+			case VertexType::Merge:
+			{
+				AddDiagonalToMergeHelper(v, prevEdge);
+				RemoveEdge(prevEdge);
+				const int leftEdge = FindEdgeLeftOf(v);
+				AddDiagonalToMergeHelper(v, leftEdge);
+				if (leftEdge != -1)
+					m_Helpers[leftEdge] = v;
+				break;
+			}
+			case VertexType::Regular:
+				if (IsAbove(m_Prev[v], v)) //Boundary goes down, the interior is on the right
+				{
+					AddDiagonalToMergeHelper(v, prevEdge);
+					RemoveEdge(prevEdge);
+					InsertEdge(v, v);
+				}
+				else
+				{
+					const int leftEdge = FindEdgeLeftOf(v);
+					AddDiagonalToMergeHelper(v, leftEdge);
+					if (leftEdge != -1)
+						m_Helpers[leftEdge] = v;
+				}
+				break;
+			}
+		}
+	}
+
+	void MonotoneDecomposition::Triangulate(std::vector<int>& triangleIndices)
+	{
+		const int nrOfVertices = static_cast<int>(m_Vertices.size());
+		if (nrOfVertices < 3)
+			return;
+
+		SplitIntoMonotonePieces();
+
+		//Half edges: every boundary edge (interior on the left) and both directions of every diagonal, grouped per start vertex
+		std::vector<int> offsets(nrOfVertices + 1, 0);
+		for (int v = 0; v < nrOfVertices; ++v)
+			++offsets[v + 1];
+		for (const auto& diagonal : m_Diagonals)
+		{
+			++offsets[diagonal.first + 1];
+			++offsets[diagonal.second + 1];
+		}
+		for (int v = 0; v < nrOfVertices; ++v)
+			offsets[v + 1] += offsets[v];
+
+		std::vector<int> targets(offsets.back());
+		std::vector<int> cursors(offsets.begin(), offsets.end() - 1);
+		for (int v = 0; v < nrOfVertices; ++v)
+			targets[cursors[v]++] = m_Next[v];
+		for (const auto& diagonal : m_Diagonals)
+		{
+			targets[cursors[diagonal.first]++] = diagonal.second;
+			targets[cursors[diagonal.second]++] = diagonal.first;
+		}
+
+		//Walk the faces: after arriving in a vertex, continue over the first edge clockwise from the one we came over
+		std::vector<char> isVisited(targets.size(), 0);
+		std::vector<int> piece;
+		for (int start = 0; start < static_cast<int>(targets.size()); ++start)
+		{
+			if (isVisited[start])
+				continue;
+
+			piece.clear();
+			int from = static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), start) - offsets.begin()) - 1;
+			int halfEdge = start;
+			for (int steps = 0; !isVisited[halfEdge] && steps < static_cast<int>(targets.size()); ++steps)
+			{
+				isVisited[halfEdge] = 1;
+				piece.push_back(from);
+
+				const int to = targets[halfEdge];
+				const Vector2 back = m_Vertices[from] - m_Vertices[to];
+				const float backAngle = atan2f(back.y, back.x);
+
+				int nextHalfEdge = -1;
+				float smallestTurn = FLT_MAX;
+				for (int h = offsets[to]; h < offsets[to + 1]; ++h)
+				{
+					const Vector2 out = m_Vertices[targets[h]] - m_Vertices[to];
+					float turn = backAngle - atan2f(out.y, out.x);
+					while (turn <= 0.f)
+						turn += 2.f * static_cast<float>(E_PI);
+					if (turn < smallestTurn)
+					{
+						smallestTurn = turn;
+						nextHalfEdge = h;
+					}
+				}
+
+				from = to;
+				halfEdge = nextHalfEdge;
+			}
+
+			if (piece.size() >= 3)
+				TriangulateMonotonePiece(piece, triangleIndices);
+		}
+	}
+
+	void MonotoneDecomposition::TriangulateMonotonePiece(const std::vector<int>& piece, std::vector<int>& triangleIndices)
+	{
+		const int size = static_cast<int>(piece.size());
+		auto addTriangle = [&](int a, int b, int c)
+		{
+			const float area = Cross(m_Vertices[b] - m_Vertices[a], m_Vertices[c] - m_Vertices[a]);
+			if (area == 0.f)
+				return;
+			triangleIndices.push_back(a);
+			triangleIndices.push_back(area > 0.f ? b : c);
+			triangleIndices.push_back(area > 0.f ? c : b);
+		};
+
+		if (size == 3)
+		{
+			addTriangle(piece[0], piece[1], piece[2]);
+			return;
+		}
+
+		//Counter clockwise from the top vertex we walk down the left chain, the rest is the right chain
+		int top = 0, bottom = 0;
+		for (int i = 1; i < size; ++i)
+		{
+			if (IsAbove(piece[i], piece[top]))
+				top = i;
+			if (IsAbove(piece[bottom], piece[i]))
+				bottom = i;
+		}
+
+		//Merge both chains into sweep order, the left chain ends with the bottom vertex
+		std::vector<int> sorted(size);
+		std::vector<char> isLeftChain(size, 0);
+		int nrOfLeft = (bottom - top + size) % size;
+		int nrOfRight = size - 1 - nrOfLeft;
+		int left = (top + 1) % size, right = (top + size - 1) % size;
+		sorted[0] = top;
+		for (int i = 1; i < size; ++i)
+		{
+			if (nrOfRight == 0 || (nrOfLeft > 0 && IsAbove(piece[left], piece[right])))
+			{
+				sorted[i] = left;
+				isLeftChain[left] = 1;
+				left = (left + 1) % size;
+				--nrOfLeft;
+			}
+			else
+			{
+				sorted[i] = right;
+				right = (right + size - 1) % size;
+				--nrOfRight;
+			}
+		}
+
+		std::vector<int> stack{ sorted[0], sorted[1] };
+		for (int i = 2; i < size - 1; ++i)
+		{
+			const int current = sorted[i];
+			if (isLeftChain[current] != isLeftChain[stack.back()])
+			{
+				//Other chain: fan to every vertex on the stack
+				for (size_t s = 0; s + 1 < stack.size(); ++s)
+					addTriangle(piece[current], piece[stack[s]], piece[stack[s + 1]]);
+				const int last = stack.back();
+				stack = { last, current };
+			}
+			else
+			{
+				//Same chain: cut off triangles while the diagonal stays inside
+				int last = stack.back();
+				stack.pop_back();
+				while (!stack.empty())
+				{
+					const float turn = Cross(m_Vertices[piece[stack.back()]] - m_Vertices[piece[current]], m_Vertices[piece[last]] - m_Vertices[piece[current]]);
+					if (isLeftChain[current] ? turn <= 0.f : turn >= 0.f)
+						break;
+					addTriangle(piece[current], piece[last], piece[stack.back()]);
+					last = stack.back();
+					stack.pop_back();
+				}
+				stack.push_back(last);
+				stack.push_back(current);
+			}
+		}
+
+		const int lowest = sorted[size - 1];
+		for (size_t s = 0; s + 1 < stack.size(); ++s)
+			addTriangle(piece[lowest], piece[stack[s]], piece[stack[s + 1]]);
+	}
+}
+
+void Elite::TriangulateMonotone(const std::vector<Vector2>& vertices, const std::vector<int>& ringOffsets, std::vector<int>& triangleIndices)
+{
+	MonotoneDecomposition decomposition{ vertices, ringOffsets };
+	decomposition.Triangulate(triangleIndices);
+}
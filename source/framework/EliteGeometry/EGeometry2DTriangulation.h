@@ -0,0 +1,25 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EGeometry2DTriangulation.h: Triangulation of polygons with holes by monotone decomposition.
+// A sweep line splits the polygon into y-monotone pieces (holes included, no bridging needed), which are
+// triangulated in linear time each, O(n log n) in total. Works on flat vertex and index buffers.
+/*=============================================================================*/
+#ifndef ELITE_GEOMETRY_2D_TRIANGULATION
+#define	ELITE_GEOMETRY_2D_TRIANGULATION
+
+#include <vector>
+
+namespace Elite
+{
+	enum class TriangulationMethod
+	{
+		EarClipping, //Bridges the holes into the outer shape and clips ears, O(n^3) worst case
+		MonotonePartition //Sweep line decomposition into monotone pieces, O(n log n)
+	};
+
+	/*! Triangulates the rings in vertices: ring r is [ringOffsets[r], ringOffsets[r + 1]), ring 0 is the outer shape and the others are holes.
+	The rings can have any winding. Adds 3 indices per triangle to triangleIndices, every triangle is wound counter clockwise. */
+	void TriangulateMonotone(const std::vector<Vector2>& vertices, const std::vector<int>& ringOffsets, std::vector<int>& triangleIndices);
+}
+#endif
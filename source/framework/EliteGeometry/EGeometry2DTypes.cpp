@@ -169,6 +169,29 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTriangles(const Triangl
 	//For this triangle, go over all triangles and look if any of it's edges matches the edges of a triangle,
 	//in other words, two points overlap. If two points match, it's an adjacent triangle
 	std::vector<Triangle*> adjTriangles;
+
+#ifdef USE_TRIANGLE_METADATA
+	//Triangles of this polygon know their lines, the adjacent triangles are the other triangles on those lines
+	const int triangleIndex = t->metaData.IndexTriangle;
+	if (triangleIndex >= 0 && triangleIndex < static_cast<int>(m_vpTriangles.size()) && m_vpTriangles[triangleIndex] == t)
+	{
+		for (const int lineIndex : t->metaData.IndexLines)
+		{
+			for (int i = m_vLineTriangleOffsets[lineIndex]; i < m_vLineTriangleOffsets[lineIndex + 1]; ++i)
+			{
+				const auto ct = m_vpTriangles[m_vLineTriangleIndices[i]];
+				if (ct != t && std::find(adjTriangles.begin(), adjTriangles.end(), ct) == adjTriangles.end())
+					adjTriangles.push_back(ct);
+			}
+		}
+
+		//Same order as the triangle list
+		std::sort(adjTriangles.begin(), adjTriangles.end(), [](const Triangle* a, const Triangle* b)
+		{ return a->metaData.IndexTriangle < b->metaData.IndexTriangle; });
+		return adjTriangles;
+	}
+#endif
+
 	for (auto ct : m_vpTriangles)
 	{
 		if (t == ct) //If same triangle, ignore
@@ -197,26 +220,31 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTrianglesOnLine(const T
 	std::vector<Triangle*> adjTriangles;
 
 #ifdef USE_TRIANGLE_METADATA
-	//Start by getting index of line in matrix
+	//Start by getting index of line in matrix, the lines of the triangle itself are checked first
 	auto lRev = Line(l.p2, l.p1);
-	const auto it = std::find_if(m_vpLines.begin(), m_vpLines.end(), [&](const Line* rl)
-	{ return (*rl == l || *rl == lRev); });
-	if (it == m_vpLines.end())
+	int lineIndex = -1;
+	for (const int i : t->metaData.IndexLines)
 	{
-		std::cout << "WARNING: line not found!" << std::endl;
-		return adjTriangles;
+		if (i >= 0 && i < static_cast<int>(m_vpLines.size()) && (*m_vpLines[i] == l || *m_vpLines[i] == lRev))
+			lineIndex = i;
 	}
-	const int lineIndex = it - m_vpLines.begin();
-
-	//Go over all the triangles and compare lines
-	for (auto ct : m_vpTriangles)
+	if (lineIndex == -1)
 	{
-		if (t == ct) //If same triangle, ignore
-			continue;
+		const auto it = std::find_if(m_vpLines.begin(), m_vpLines.end(), [&](const Line* rl)
+		{ return (*rl == l || *rl == lRev); });
+		if (it == m_vpLines.end())
+		{
+			std::cout << "WARNING: line not found!" << std::endl;
+			return adjTriangles;
+		}
+		lineIndex = it - m_vpLines.begin();
+	}
 
-		if (ct->metaData.IndexLines[0] == lineIndex
-			|| ct->metaData.IndexLines[1] == lineIndex
-			|| ct->metaData.IndexLines[2] == lineIndex)
+	//Go over the triangles on that line
+	for (int i = m_vLineTriangleOffsets[lineIndex]; i < m_vLineTriangleOffsets[lineIndex + 1]; ++i)
+	{
+		const auto ct = m_vpTriangles[m_vLineTriangleIndices[i]];
+		if (t != ct) //If same triangle, ignore
 			adjTriangles.push_back(ct);
 	}
 #endif
@@ -226,27 +254,114 @@ std::vector<Elite::Triangle*> Elite::Polygon::GetAdjacentTrianglesOnLine(const T
 
 const Elite::Triangle* Elite::Polygon::GetTriangleFromPosition(const Vector2& position, bool onLineAllowed /*= false*/) const
 {
-	for (size_t i = 0; i < m_vpTriangles.size(); i++)
+	//No grid (not triangulated yet), test all triangles
+	if (m_vTriangleGridOffsets.empty())
+	{
+		for (size_t i = 0; i < m_vpTriangles.size(); i++)
+		{
+			if (PointInTriangle(position, m_vpTriangles[i]->p1, m_vpTriangles[i]->p2, m_vpTriangles[i]->p3, onLineAllowed))
+				return m_vpTriangles[i];
+		}
+		return nullptr;
+	}
+
+	//Only the triangles overlapping the cell of the position can contain it
+	const int column = static_cast<int>((position.x - m_TriangleGridMin.x) / m_TriangleGridCellSize);
+	const int row = static_cast<int>((position.y - m_TriangleGridMin.y) / m_TriangleGridCellSize);
+	if (position.x < m_TriangleGridMin.x || position.y < m_TriangleGridMin.y || column >= m_TriangleGridColumns || row >= m_TriangleGridRows)
+		return nullptr;
+
+	const int bucket = row * m_TriangleGridColumns + column;
+	for (int i = m_vTriangleGridOffsets[bucket]; i < m_vTriangleGridOffsets[bucket + 1]; ++i)
 	{
-		if (PointInTriangle(position, m_vpTriangles[i]->p1, m_vpTriangles[i]->p2, m_vpTriangles[i]->p3, onLineAllowed))
-			return m_vpTriangles[i];
+		const Triangle* t = m_vpTriangles[m_vTriangleGridIndices[i]];
+		if (PointInTriangle(position, t->p1, t->p2, t->p3, onLineAllowed))
+			return t;
 	}
 	return nullptr;
 }
 
-#ifdef USE_TRIANGLE_METADATA
-const std::vector<const Elite::Triangle*> Elite::Polygon::GetTrianglesFromLineIndex(unsigned int lineIndex) const
+const Elite::Triangle* Elite::Polygon::GetClosestTriangle(const Vector2& position, Vector2& closestPoint) const
 {
-	std::vector<const Triangle*> vpFoundTriangles = {};
-	for (auto pT : m_vpTriangles)
+	closestPoint = position;
+	if (m_vpTriangles.empty())
+		return nullptr;
+
+	const Triangle* pTriangle = GetTriangleFromPosition(position, true);
+	if (pTriangle)
+		return pTriangle;
+
+	//Closest point on the edges of a triangle (the position is not inside of it)
+	float closestDistanceSq = (std::numeric_limits<float>::max)();
+	auto testTriangle = [&](const Triangle* t)
 	{
-		if (pT->metaData.IndexLines[0] == lineIndex ||
-			pT->metaData.IndexLines[1] == lineIndex ||
-			pT->metaData.IndexLines[2] == lineIndex)
+		const Vector2 edgePoints[3] = { ProjectOnLineSegment(t->p1, t->p2, position),
+			ProjectOnLineSegment(t->p2, t->p3, position), ProjectOnLineSegment(t->p3, t->p1, position) };
+		for (const auto& p : edgePoints)
 		{
-			vpFoundTriangles.push_back(pT);
+			const float distanceSq = DistanceSquared(p, position);
+			if (distanceSq < closestDistanceSq)
+			{
+				closestDistanceSq = distanceSq;
+				closestPoint = p;
+				pTriangle = t;
+			}
+		}
+	};
+
+	if (m_vTriangleGridOffsets.empty())
+	{
+		for (const auto t : m_vpTriangles)
+			testTriangle(t);
+		return pTriangle;
+	}
+
+	//Search the grid in growing rings around the (clamped) cell of the position, until no closer triangle is possible.
+	//Ring k is at least (k - 1) cells away from the clamped position, and the clamp offset is perpendicular to the grid's bounds.
+	const int startColumn = GetTriangleGridColumn(position.x);
+	const int startRow = GetTriangleGridRow(position.y);
+	const int maxRing = (std::max)(m_TriangleGridColumns, m_TriangleGridRows);
+	const Vector2 clampedPosition{ Clamp(position.x, m_TriangleGridMin.x, m_TriangleGridMin.x + m_TriangleGridColumns * m_TriangleGridCellSize),
+		Clamp(position.y, m_TriangleGridMin.y, m_TriangleGridMin.y + m_TriangleGridRows * m_TriangleGridCellSize) };
+	const float clampDistanceSq = DistanceSquared(position, clampedPosition);
+
+	for (int ring = 0; ring <= maxRing; ++ring)
+	{
+		const float ringDistance = (std::max)(ring - 1, 0) * m_TriangleGridCellSize;
+		if (clampDistanceSq + ringDistance * ringDistance > closestDistanceSq)
+			break;
+
+		for (int row = startRow - ring; row <= startRow + ring; ++row)
+		{
+			if (row < 0 || row >= m_TriangleGridRows)
+				continue;
+
+			//Only the border of the ring, the inside was visited before
+			const bool isBorderRow = row == startRow - ring || row == startRow + ring;
+			const int columnStep = isBorderRow || ring == 0 ? 1 : 2 * ring;
+			for (int column = startColumn - ring; column <= startColumn + ring; column += columnStep)
+			{
+				if (column < 0 || column >= m_TriangleGridColumns)
+					continue;
+
+				const int bucket = row * m_TriangleGridColumns + column;
+				for (int i = m_vTriangleGridOffsets[bucket]; i < m_vTriangleGridOffsets[bucket + 1]; ++i)
+					testTriangle(m_vpTriangles[m_vTriangleGridIndices[i]]);
+			}
 		}
 	}
+	return pTriangle;
+}
+
+#ifdef USE_TRIANGLE_METADATA
+const std::vector<const Elite::Triangle*> Elite::Polygon::GetTrianglesFromLineIndex(unsigned int lineIndex) const
+{
+	std::vector<const Triangle*> vpFoundTriangles = {};
+	if (lineIndex + 1 >= m_vLineTriangleOffsets.size())
+		return vpFoundTriangles;
+
+	for (int i = m_vLineTriangleOffsets[lineIndex]; i < m_vLineTriangleOffsets[lineIndex + 1]; ++i)
+		vpFoundTriangles.push_back(m_vpTriangles[m_vLineTriangleIndices[i]]);
 	return vpFoundTriangles;
 }
 #endif
@@ -255,7 +370,7 @@ const std::vector<const Elite::Triangle*> Elite::Polygon::GetTrianglesFromLineIn
 #pragma endregion //GettersInformation
 //----------------------------------------------------------
 #pragma region TriangulationFunctions
-const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
+const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate(TriangulationMethod method)
 {
 	//Check winding
 	OrientateWithChildren(Winding::CCW);
@@ -267,38 +382,61 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 		//FILL IN FUNCTIONS!
 	}
 
-	//Sort the children. Start by sorting from top to bottom (verices are what matters, not the "center" pos of the polygon!)
+	//Triangle list - Clear first (if already containing triangles)
+	for (auto t : m_vpTriangles)
+		SAFE_DELETE(t);
+	m_vpTriangles.clear();
+
+	if (method == TriangulationMethod::MonotonePartition)
+		TriangulateMonotonePartition();
+	else
+		TriangulateEarClipping();
+
+	//Flag as triangulated for later use
+	m_isTriangulated = true; 
+
+#ifdef USE_TRIANGLE_METADATA
+	GenerateLineMatrix();
+#endif
+	GenerateTriangleGrid();
+	return m_vpTriangles;
+}
+
+void Elite::Polygon::TriangulateMonotonePartition()
+{
+	//Flatten the outer shape and the holes into one vertex buffer, the shape itself is left untouched
+	std::vector<Vector2> vertices{ m_vPoints.begin(), m_vPoints.end() };
+	std::vector<int> ringOffsets{ 0, static_cast<int>(vertices.size()) };
+	for (const auto& child : m_vChildren)
+	{
+		vertices.insert(vertices.end(), child.m_vPoints.begin(), child.m_vPoints.end());
+		ringOffsets.push_back(static_cast<int>(vertices.size()));
+	}
+
+	std::vector<int> triangleIndices;
+	triangleIndices.reserve(3 * (vertices.size() + 2 * m_vChildren.size()));
+	TriangulateMonotone(vertices, ringOffsets, triangleIndices);
+
+	m_vpTriangles.reserve(triangleIndices.size() / 3);
+	for (size_t i = 0; i + 2 < triangleIndices.size(); i += 3)
+		m_vpTriangles.push_back(new Triangle(vertices[triangleIndices[i]], vertices[triangleIndices[i + 1]], vertices[triangleIndices[i + 2]]));
+}
+
+void Elite::Polygon::TriangulateEarClipping()
+{
+	//Sort the children from right to left (verices are what matters, not the "center" pos of the polygon!)
+	//Every hole is bridged to the right, so the holes right of it are already part of the outer polygon
 	std::sort(m_vChildren.begin(), m_vChildren.end(),
 		[](const Polygon& p1, const Polygon& p2)
-	{ return p1.GetPosVertMaxYPos() > p2.GetPosVertMaxYPos(); });
+	{ return p1.GetPosVertMaxXPos() > p2.GetPosVertMaxXPos(); });
 
 	//Copy children as backup after sort
 	const auto children = m_vChildren;
-	
-	//THEN, we check two elements, if the don't overlap horizontally you don't do anything, else you swap them based on right most object
-	for (auto i = 0; i < static_cast<int>(m_vChildren.size()) - 1; ++i)
-	{
-		if (m_vChildren[i].OverlappingYAxis(m_vChildren[i + 1]))
-		{
-			//Swap if i.y < i+1.y
-			if (m_vChildren[i].GetPosVertMaxXPos() < m_vChildren[i + 1].GetPosVertMaxXPos())
-			{
-				const auto temp = m_vChildren[i];
-				m_vChildren[i] = m_vChildren[i + 1];
-				m_vChildren[i + 1] = temp;
-			}
-		}
-	}
 
 	//First split polygon
 	while (m_vChildren.size() != 0)
 		Split();
 
-	//Triangle list - Clear first (if already containing triangles)
-	for (auto t : m_vpTriangles)
-		SAFE_DELETE(t);
-	m_vpTriangles.clear();
-
 	std::list<Vector2> copyPoints;
 	copyPoints.assign(m_vPoints.begin(), m_vPoints.end()); //Copy
 
@@ -314,32 +452,30 @@ const std::vector<Elite::Triangle*>& Elite::Polygon::Triangulate()
 				earListIt = it;
 		}
 
+		//No ear left on degenerate input, stop instead of removing a vertex that isn't an ear
+		if (earListIt == copyPoints.end())
+			break;
+
 		//Push triangle
 		Vector2 current, prev, next;
 		GetTriangle(copyPoints, earListIt, current, prev, next);
 		Triangle* t = new Triangle(prev, current, next);
 		m_vpTriangles.push_back(t);
 
-		//Remove current from pointslist
-		const auto currentIt = std::find(copyPoints.begin(), copyPoints.end(), current);
-		copyPoints.erase(currentIt); //remove
+		//Remove current from pointslist (by iterator, merged holes duplicate vertices)
+		copyPoints.erase(earListIt); //remove
 	}
 	//Add the remaining 3 vertices to the triangulated polygon
-	std::vector<Vector2> tempCopy;
-	for (const auto p : copyPoints)
-		tempCopy.push_back(p);
-	Triangle* lastTriangle = new Triangle(tempCopy[0], tempCopy[1], tempCopy[2]);
-	m_vpTriangles.push_back(lastTriangle);
-
-	//Flag as triangulated for later use
-	m_isTriangulated = true; 
-
-#ifdef USE_TRIANGLE_METADATA
-	GenerateLineMatrix();
-#endif
+	if (copyPoints.size() == 3)
+	{
+		std::vector<Vector2> tempCopy;
+		for (const auto p : copyPoints)
+			tempCopy.push_back(p);
+		Triangle* lastTriangle = new Triangle(tempCopy[0], tempCopy[1], tempCopy[2]);
+		m_vpTriangles.push_back(lastTriangle);
+	}
 
 	m_vChildren = children;
-	return m_vpTriangles;
 }
 
 void Elite::Polygon::OrientateWithChildren(Winding winding)
@@ -352,7 +488,7 @@ void Elite::Polygon::OrientateWithChildren(Winding winding)
 
 	//Rewind the children if necessary
 	auto windingChildren = abs(winding - 1); //CCW -> CW, CW -> CCW ----- abs(0-1)=1, abs(1-1)=0
-	for (auto child : m_vChildren)
+	for (auto& child : m_vChildren)
 		child.OrientateWithChildren(static_cast<Winding>(windingChildren));
 }
 
@@ -437,175 +573,256 @@ bool Elite::Polygon::IsEar(const list<Vector2>& l, const list<Vector2>::const_it
 	return true;
 }
 
-void Elite::Polygon::GenerateLineMatrix()
+namespace
 {
-#ifdef USE_TRIANGLE_METADATA
-	//Go over all the triangles
-	for (auto t : m_vpTriangles)
+	//Line between two vertices, independent of the direction it is walked in
+	struct LineKey final
 	{
-		//Go over all the lines of the triangle, search if they are already in the matrix
-		//If not add them and store it's index in the triangles meta data
-		const Line l1{ t->p1, t->p2 };
-		const Line l1rev{ t->p2, t->p1 };
-		const Line l2{ t->p2, t->p3 };
-		const Line l2rev{ t->p3, t->p2 };
-		const Line l3{ t->p3, t->p1 };
-		const Line l3rev{ t->p1, t->p3 };
-		for (auto i = 0; i < static_cast<int>(m_vpLines.size()); ++i)
+		LineKey(const Elite::Vector2& a, const Elite::Vector2& b)
 		{
-			const auto l = m_vpLines[i];
-			if (*l == l1 || *l == l1rev)
-				t->metaData.IndexLines[0] = i;
-			if (*l == l2 || *l == l2rev)
-				t->metaData.IndexLines[1] = i;
-			if (*l == l3 || *l == l3rev)
-				t->metaData.IndexLines[2] = i;
+			//+ 0.0f turns -0.0f into 0.0f, so equal coordinates also have equal bits
+			const bool isOrdered = a.x < b.x || (a.x == b.x && a.y <= b.y);
+			const Elite::Vector2& first = isOrdered ? a : b;
+			const Elite::Vector2& second = isOrdered ? b : a;
+			coordinates = { first.x + 0.0f, first.y + 0.0f, second.x + 0.0f, second.y + 0.0f };
 		}
-		//Not found, add to matrix
-		if (t->metaData.IndexLines[0] == -1)
+
+		bool operator==(const LineKey& other) const { return coordinates == other.coordinates; }
+
+		std::array<float, 4> coordinates;
+	};
+
+	struct LineKeyHash final
+	{
+		size_t operator()(const LineKey& key) const
 		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p1, t->p2, index));
-			t->metaData.IndexLines[0] = index;
+			size_t hash = 0;
+			for (const float c : key.coordinates)
+				hash = hash * 31 + std::hash<float>()(c);
+			return hash;
 		}
-		if (t->metaData.IndexLines[1] == -1)
+	};
+}
+
+void Elite::Polygon::GenerateLineMatrix()
+{
+#ifdef USE_TRIANGLE_METADATA
+	//Lines of a previous triangulation are no longer valid
+	for (auto l : m_vpLines)
+		SAFE_DELETE(l);
+	m_vpLines.clear();
+
+	//Go over all the lines of all the triangles, shared lines are found through a hash on their vertices
+	//If not found add them and store it's index in the triangles meta data
+	std::unordered_map<LineKey, int, LineKeyHash> lineIndices;
+	lineIndices.reserve(m_vpTriangles.size() * 2);
+	for (int i = 0; i < static_cast<int>(m_vpTriangles.size()); ++i)
+	{
+		const auto t = m_vpTriangles[i];
+		t->metaData.IndexTriangle = i;
+
+		const Vector2* points[3] = { &t->p1, &t->p2, &t->p3 };
+		for (int e = 0; e < 3; ++e)
 		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p2, t->p3, index));
-			t->metaData.IndexLines[1] = index;
+			const Vector2& p1 = *points[e];
+			const Vector2& p2 = *points[(e + 1) % 3];
+			const auto result = lineIndices.emplace(LineKey{ p1, p2 }, static_cast<int>(m_vpLines.size()));
+			if (result.second) //Not found, add to matrix
+				m_vpLines.push_back(new Line(p1, p2, result.first->second));
+			t->metaData.IndexLines[e] = result.first->second;
 		}
-		if (t->metaData.IndexLines[2] == -1)
+	}
+
+	//Triangles per line: count first, then fill in triangle order
+	m_vLineTriangleOffsets.assign(m_vpLines.size() + 1, 0);
+	for (const auto t : m_vpTriangles)
+	{
+		for (const int lineIndex : t->metaData.IndexLines)
+			++m_vLineTriangleOffsets[lineIndex + 1];
+	}
+	for (size_t l = 1; l < m_vLineTriangleOffsets.size(); ++l)
+		m_vLineTriangleOffsets[l] += m_vLineTriangleOffsets[l - 1];
+
+	std::vector<int> cursors(m_vLineTriangleOffsets.begin(), m_vLineTriangleOffsets.end() - 1);
+	m_vLineTriangleIndices.resize(m_vLineTriangleOffsets.back());
+	for (const auto t : m_vpTriangles)
+	{
+		for (const int lineIndex : t->metaData.IndexLines)
+			m_vLineTriangleIndices[cursors[lineIndex]++] = t->metaData.IndexTriangle;
+	}
+#endif
+}
+
+void Elite::Polygon::GenerateTriangleGrid()
+{
+	m_vTriangleGridOffsets.clear();
+	m_vTriangleGridIndices.clear();
+	if (m_vpTriangles.empty())
+		return;
+
+	//Bounds of the triangulated area
+	Vector2 minPoint{ (std::numeric_limits<float>::max)(), (std::numeric_limits<float>::max)() };
+	Vector2 maxPoint{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+	for (const auto t : m_vpTriangles)
+	{
+		for (const auto& p : { t->p1, t->p2, t->p3 })
 		{
-			const int index = m_vpLines.size();
-			m_vpLines.push_back(new Line(t->p3, t->p1, index));
-			t->metaData.IndexLines[2] = index;
+			minPoint.x = (std::min)(minPoint.x, p.x);
+			minPoint.y = (std::min)(minPoint.y, p.y);
+			maxPoint.x = (std::max)(maxPoint.x, p.x);
+			maxPoint.y = (std::max)(maxPoint.y, p.y);
 		}
 	}
-#endif
+
+	//Roughly one triangle per cell
+	const float width = (std::max)(maxPoint.x - minPoint.x, FLT_EPSILON);
+	const float height = (std::max)(maxPoint.y - minPoint.y, FLT_EPSILON);
+	m_TriangleGridMin = minPoint;
+	m_TriangleGridCellSize = sqrtf(width * height / m_vpTriangles.size());
+	m_TriangleGridColumns = static_cast<int>(width / m_TriangleGridCellSize) + 1;
+	m_TriangleGridRows = static_cast<int>(height / m_TriangleGridCellSize) + 1;
+
+	//Every triangle goes in the buckets overlapping its bounding box: count first, then fill
+	auto forEachCell = [this](const Triangle* t, const std::function<void(int)>& func)
+	{
+		const int minColumn = GetTriangleGridColumn((std::min)({ t->p1.x, t->p2.x, t->p3.x }));
+		const int maxColumn = GetTriangleGridColumn((std::max)({ t->p1.x, t->p2.x, t->p3.x }));
+		const int minRow = GetTriangleGridRow((std::min)({ t->p1.y, t->p2.y, t->p3.y }));
+		const int maxRow = GetTriangleGridRow((std::max)({ t->p1.y, t->p2.y, t->p3.y }));
+		for (int row = minRow; row <= maxRow; ++row)
+		{
+			for (int column = minColumn; column <= maxColumn; ++column)
+				func(row * m_TriangleGridColumns + column);
+		}
+	};
+
+	m_vTriangleGridOffsets.assign(m_TriangleGridColumns * m_TriangleGridRows + 1, 0);
+	for (const auto t : m_vpTriangles)
+		forEachCell(t, [this](int bucket) { ++m_vTriangleGridOffsets[bucket + 1]; });
+
+	for (size_t b = 1; b < m_vTriangleGridOffsets.size(); ++b)
+		m_vTriangleGridOffsets[b] += m_vTriangleGridOffsets[b - 1];
+
+	std::vector<int> cursors(m_vTriangleGridOffsets.begin(), m_vTriangleGridOffsets.end() - 1);
+	m_vTriangleGridIndices.resize(m_vTriangleGridOffsets.back());
+	for (int i = 0; i < static_cast<int>(m_vpTriangles.size()); ++i)
+		forEachCell(m_vpTriangles[i], [this, &cursors, i](int bucket) { m_vTriangleGridIndices[cursors[bucket]++] = i; });
+}
+
+int Elite::Polygon::GetTriangleGridColumn(float x) const
+{
+	return Clamp(static_cast<int>((x - m_TriangleGridMin.x) / m_TriangleGridCellSize), 0, m_TriangleGridColumns - 1);
+}
+
+int Elite::Polygon::GetTriangleGridRow(float y) const
+{
+	return Clamp(static_cast<int>((y - m_TriangleGridMin.y) / m_TriangleGridCellSize), 0, m_TriangleGridRows - 1);
 }
 #pragma endregion //PrivateGeneralFunctions
 //----------------------------------------------------------
 #pragma region PrivateTriangulationFunctions
-void Elite::Polygon::FindMutualVisibleVertices(const Polygon& outer, const Polygon& inner, Vector2& pOuter, Vector2& pInner)
+namespace
 {
-	//1. Find vertex with the biggest x value of the inner polygon AND biggest x value of outer polygon (used for size ray)
-	const auto maxInnerPoint = std::max_element(inner.m_vPoints.begin(), inner.m_vPoints.end(),
-		[](const Vector2& p1, const Vector2& p2) { return p1.x < p2.x; });
+	//Vertices where earlier holes were merged appear multiple times in the outer polygon, with a different wedge (prev - vertex - next) for every copy.
+	//The bridge to a new hole has to start from the copy whose wedge contains the hole, otherwise the bridges cross in that vertex.
+	std::list<Elite::Vector2>::const_iterator SelectBridgeVertex(const std::list<Elite::Vector2>& points, std::list<Elite::Vector2>::const_iterator itVertex, const Elite::Vector2& target)
+	{
+		using namespace Elite;
+		const Vector2 vertex = *itVertex;
+		for (auto it = points.begin(); it != points.end(); ++it)
+		{
+			if (*it != vertex)
+				continue;
 
-	const auto maxOuterPoint = std::max_element(outer.m_vPoints.begin(), outer.m_vPoints.end(),
+			const Vector2& prev = (it == points.begin()) ? points.back() : *std::prev(it);
+			const Vector2& next = (std::next(it) == points.end()) ? points.front() : *std::next(it);
+			const bool isLeftOfIncoming = Cross(vertex - prev, target - prev) > 0.f;
+			const bool isLeftOfOutgoing = Cross(next - vertex, target - vertex) > 0.f;
+			const bool isInWedge = IsConvex(vertex, prev, next) ? (isLeftOfIncoming && isLeftOfOutgoing) : (isLeftOfIncoming || isLeftOfOutgoing);
+			if (isInWedge)
+				return it;
+		}
+		return itVertex;
+	}
+}
+
+void Elite::Polygon::FindMutualVisibleVertices(const Polygon& outer, const Polygon& inner, std::list<Vector2>::const_iterator& itOuter, Vector2& pInner)
+{
+	//1. Find vertex with the biggest x value of the inner polygon
+	const auto maxInnerPoint = std::max_element(inner.m_vPoints.begin(), inner.m_vPoints.end(),
 		[](const Vector2& p1, const Vector2& p2) { return p1.x < p2.x; });
-	const float rayMaxX = maxOuterPoint->x;
 
 	//Store inner point to output
 	pInner = *maxInnerPoint;
+	const Vector2 M = pInner;
 
 	// --- 2. Based on found inner point, find mutually visisble outer point
-	//2.1 Intersect ray M + t(1,0) with all directed edges of OUTER (M is left of edges) - Result point I
-	//http://stackoverflow.com/questions/563198/how-do-you-detect-where-two-line-segments-intersect
-	const Vector2 furthestPointRay = Vector2(rayMaxX, maxInnerPoint->y);
-	Vector2 p = pInner;
-	Vector2 r = furthestPointRay - pInner; //Ray
-	Vector2 I = ZeroVector2; //Found intersection
-	Vector2 intersectedLine[2] = { ZeroVector2, ZeroVector2 }; //Store to find point P if I is found
-	for (auto it = outer.m_vPoints.begin(); it != outer.m_vPoints.end(); ++it)
+	//2.1 Intersect ray M + t(1,0) with the edges of OUTER that have M on their left (the ones going up, outer is CCW) - Result point I
+	//Vertices are tracked by iterator, the outer polygon contains duplicated vertices where earlier holes were merged
+	const auto end = outer.m_vPoints.end();
+	auto closestX = (std::numeric_limits<float>::max)();
+	auto itHitStart = end, itHitEnd = end, itHitVertex = end;
+	for (auto it = outer.m_vPoints.begin(); it != end; ++it)
 	{
-		const auto next = std::next(it);
-		//If on right of innerPoint AND has a next point (to make line)
-		if (it->x > maxInnerPoint->x && next != outer.m_vPoints.end())
-		{
-			//Poly line segment
-			const Vector2 q = *it;
-			Vector2 s = *next - q;
+		auto next = std::next(it);
+		if (next == end)
+			next = outer.m_vPoints.begin();
 
-			//Capture parallel and collinear cases
-			if (Cross(r, s) == 0)
-			{
-				if (Cross(q - p, r) == 0) //== Collinear
-				{
-					//Get closest vertex (OR the correct way see link :)) - We don't check
-					//overlap because the max x of our ray is within the boundaries
-					if (it->x < next->x)
-						I = *it;
-					else
-						I = *next;
-				}
-				continue;
-			}
+		//Horizontal edges are parallel to the ray, their vertices are hit through the neighbouring edges
+		if (!(it->y <= M.y && M.y <= next->y) || it->y == next->y)
+			continue;
 
-			//If not parallel or collinear, search point, calculate T and U
-			float crossRS = Cross(r, s);
-			float t = Cross(q - p, s) / crossRS;
-			float u = Cross(q - p, r) / crossRS;
+		const float x = it->x + (M.y - it->y) * (next->x - it->x) / (next->y - it->y);
+		if (x < M.x || x >= closestX)
+			continue;
 
-			//If U == 0 || u == 1, endpoints touch, else if within range also a hit
-			if (t >= 0 && t <= 1 && u >= 0 && u <= 1)
-			{
-				Vector2 tempI = p + (t * r);
-				auto distanceTemp = abs(Distance(p, tempI));
-				auto distanceI = abs(Distance(p, I));
-				//Check if closer than other intersected lines, if it is, replace stored line!
-				if (intersectedLine[0] == ZeroVector2 && intersectedLine[1] == ZeroVector2
-					|| distanceTemp < distanceI)
-				{
-					//Determine point with T and U
-					I = p + (t * r);
-					intersectedLine[0] = *it;
-					intersectedLine[1] = *next;
-				}
-			}
-		}
+		closestX = x;
+		itHitStart = it;
+		itHitEnd = next;
+		itHitVertex = (M.y == it->y) ? it : (M.y == next->y) ? next : end;
 	}
 
 	//2.2 IF I is vertex of OUTER == mutually visisble so terminate algorithm
-	const auto IOuter = std::find(outer.m_vPoints.begin(), outer.m_vPoints.end(), I);
-	if (IOuter != outer.m_vPoints.end()) //Point is vertex of outer, so I is correct vertex!
+	if (itHitVertex != end)
 	{
-		pOuter = I;
+		itOuter = SelectBridgeVertex(outer.m_vPoints, itHitVertex, M);
 		return;
 	}
-
-	//2.3 ELSE I is interior point on edge, select vertex with maximum x value of the hitted edge - Result point P
-	Vector2 P = intersectedLine[(intersectedLine[0].x > intersectedLine[1].x ? 0 : 1)];
-	
-	//2.4 Search for reflex vertices (excluding P if it's a reflex)
-	std::list<Vector2> reflexVertices;
-	for (auto it = outer.m_vPoints.begin(); it != outer.m_vPoints.end(); ++it)
+	//No edge of OUTER right of the hole (hole isn't inside of it), bridge to the first vertex
+	if (itHitStart == end)
 	{
-		if (*it == P)
-			continue;
-
-		if (!outer.IsConvexInPolygon(outer.m_vPoints, it))
-			reflexVertices.push_back(*it);
-	}
-
-	//2.5 IF all reflex vertices are OUTSIDE of triangle (M,I,P), then P is mutually visible == terminate algorithm
-	std::vector<Vector2> pointsInTriangle;
-	for (auto it = reflexVertices.begin(); it != reflexVertices.end(); ++it)
-	{
-		if (PointInTriangle(*it, pInner, I, P))
-			pointsInTriangle.push_back(*it);
-	}
-
-	if (pointsInTriangle.size() == 0)
-	{
-		pOuter = P;
+		itOuter = outer.m_vPoints.begin();
 		return;
 	}
 
-	//2.6 ELSE at least one reflex vertex lies in triangle (M,I,P). Search for reflex R that minimizes the angle
-	//between (1,0) and the line (M,R). If found more choose one, else use the one found and terminate algorithm
-	auto smallestAngle = 2 * M_PI;
-	for (const auto point : pointsInTriangle)
+	//2.3 ELSE I is interior point on edge, select vertex with maximum x value of the hitted edge - Result point P
+	const Vector2 I{ closestX, M.y };
+	const auto itP = (itHitStart->x > itHitEnd->x) ? itHitStart : itHitEnd;
+	const Vector2 P = *itP;
+
+	//2.4 Search for reflex vertices (excluding P if it's a reflex) inside of triangle (M,I,P)
+	//2.5 IF there are none, then P is mutually visible == terminate algorithm
+	//2.6 ELSE search for reflex R that minimizes the angle between (1,0) and the line (M,R), the closest one on ties
+	itOuter = itP;
+	auto smallestAngle = (std::numeric_limits<float>::max)();
+	auto smallestDistance = (std::numeric_limits<float>::max)();
+	for (auto it = outer.m_vPoints.begin(); it != end; ++it)
 	{
-		//Angle between r and (M,p)
-		Vector2 seg = point - p;
-		auto angle = acos((Dot(seg, r)) / (seg.Magnitude() * r.Magnitude()));
-		if (angle < smallestAngle)
+		if (*it == P || outer.IsConvexInPolygon(outer.m_vPoints, it) || !PointInTriangle(*it, M, I, P))
+			continue;
+
+		const Vector2 toPoint = *it - M;
+		const float distance = toPoint.Magnitude();
+		const float angle = acos(Clamp(toPoint.x / distance, -1.f, 1.f));
+		const bool isSameAngle = AreEqual(angle, smallestAngle, 1e-4f); //Collinear reflex vertices: only the closest one is visible
+		if ((angle < smallestAngle && !isSameAngle) || (isSameAngle && distance < smallestDistance))
 		{
 			smallestAngle = angle;
-			pOuter = point;
+			smallestDistance = distance;
+			itOuter = it;
 		}
 	}
+	itOuter = SelectBridgeVertex(outer.m_vPoints, itOuter, M);
 }
 
 void Elite::Polygon::Split()
@@ -616,10 +833,10 @@ void Elite::Polygon::Split()
 	for (auto child : m_vChildren)
 	{
 		//Find mutually visible vertices
-		Vector2 pInner, pOuter;
-		FindMutualVisibleVertices(*this, child, pOuter, pInner);
+		Vector2 pInner;
+		std::list<Vector2>::const_iterator itOuter; //Where to start inserting
+		FindMutualVisibleVertices(*this, child, itOuter, pInner);
 		//Based on mutually visible vertices, merge meshes at the split
-		const auto itOuter = std::find(m_vPoints.begin(), m_vPoints.end(), pOuter); //Find where to start inserting
 		const auto itInner = std::find(child.m_vPoints.begin(), child.m_vPoints.end(), pInner);
 		//insert child polygon vertices to outer starting from the found inner vertex
 		std::list<Vector2> mergeableChild;
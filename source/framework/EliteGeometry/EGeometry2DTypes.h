@@ -8,6 +8,7 @@
 #define	ELITE_GEOMETRY_TYPES
 
 #include "EGeometry2DUtilities.h"
+#include "EGeometry2DTriangulation.h"
 #include <array>
 
 
@@ -46,6 +47,7 @@ namespace Elite
 	struct TriangleMetaData final
 	{
 		std::array<int, 3> IndexLines{ {-1, -1, -1} };
+		int IndexTriangle = -1; //Index in the polygon's triangle list
 	};
 
 	struct Triangle final
@@ -117,6 +119,8 @@ namespace Elite
 		std::vector<Triangle*> GetAdjacentTrianglesOnLine(const Triangle* t, const Line& l) const;
 
 		const Triangle* GetTriangleFromPosition(const Vector2& position, bool onLineAllowed = false) const;
+		//Triangle with the point closest to the given position, which is returned in closestPoint (the position itself when it lies on a triangle)
+		const Triangle* GetClosestTriangle(const Vector2& position, Vector2& closestPoint) const;
 #ifdef USE_TRIANGLE_METADATA
 		const std::vector<const Triangle*> GetTrianglesFromLineIndex(unsigned int lineIndex) const;
 #endif
@@ -124,7 +128,7 @@ namespace Elite
 
 
 		//Triangulation functions
-		const std::vector<Triangle*>& Triangulate();
+		const std::vector<Triangle*>& Triangulate(TriangulationMethod method = TriangulationMethod::EarClipping);
 		void OrientateWithChildren(Winding winding);
 		void ExpandShape(float amount);
 
@@ -140,15 +144,34 @@ namespace Elite
 		std::vector<Line*> m_vpLines; //Lines constructing this polygon!
 		bool m_isTriangulated = false;
 
+		//Triangles sharing each line: line l is an edge of the triangles (by index) in
+		//m_vLineTriangleIndices[m_vLineTriangleOffsets[l], m_vLineTriangleOffsets[l + 1])
+		std::vector<int> m_vLineTriangleOffsets;
+		std::vector<int> m_vLineTriangleIndices;
+
+		//Uniform grid over the triangles, used to look up triangles by position. Bucket b holds the indices
+		//of the triangles overlapping its cell in m_vTriangleGridIndices[m_vTriangleGridOffsets[b], m_vTriangleGridOffsets[b + 1])
+		Vector2 m_TriangleGridMin = {};
+		float m_TriangleGridCellSize = 1.0f;
+		int m_TriangleGridColumns = 0;
+		int m_TriangleGridRows = 0;
+		std::vector<int> m_vTriangleGridOffsets;
+		std::vector<int> m_vTriangleGridIndices;
+
 		//=== Functions ===
 		//Private General Functions
 		void GetTriangle(const std::list<Vector2>& l, const std::list<Vector2>::const_iterator p, Vector2& currentTip, Vector2& previous, Vector2& next) const;
 		bool IsConvexInPolygon(const std::list<Vector2>& l, const std::list<Vector2>::const_iterator p) const;
 		bool IsEar(const std::list<Vector2>& l, const std::list<Vector2>::const_iterator p) const;
 		void GenerateLineMatrix();
+		void GenerateTriangleGrid();
+		int GetTriangleGridColumn(float x) const;
+		int GetTriangleGridRow(float y) const;
 
 		//Private Triangulation Functions
-		void FindMutualVisibleVertices(const Polygon& outer, const Polygon& inner, Vector2& pOuter, Vector2& pInner);
+		void TriangulateEarClipping();
+		void TriangulateMonotonePartition();
+		void FindMutualVisibleVertices(const Polygon& outer, const Polygon& inner, std::list<Vector2>::const_iterator& itOuter, Vector2& pInner);
 		void Split();
 	};
 #pragma endregion //Polygon
@@ -35,12 +35,13 @@ namespace Elite
 		//	2-------1		 1-------2			 3-------2
 		//	   ??				CCW				    CW
 
-		auto signArea = 0;
+		auto signArea = 0.f;
 		for (auto it = shape.begin(); it != shape.end(); ++it)
 		{
 			auto next = std::next(it);
-			if (next != shape.end())
-				signArea += static_cast<int>((next->x - it->x) * (next->y + it->y));
+			if (next == shape.end()) //Closing edge, back to the first point
+				next = shape.begin();
+			signArea += (next->x - it->x) * (next->y + it->y);
 		}
 		if (signArea >= 0)
 			return CW;
@@ -62,10 +63,10 @@ namespace Elite
 	/*! Check if a single point is inside the triangle's bounding box. This is a quick overlap test. */
 	constexpr auto PointInTriangleBoundingBox(const Vector2& p, const Vector2& tip, const Vector2& prev, const Vector2& next)
 	{
-		const auto xMin = min(tip.x, min(prev.x, next.x)) - FLT_EPSILON;
-		const auto xMax = max(tip.x, max(prev.x, next.x)) + FLT_EPSILON;
-		const auto yMin = min(tip.y, min(prev.y, next.y)) - FLT_EPSILON;
-		const auto yMax = max(tip.y, max(prev.y, next.y)) + FLT_EPSILON;
+		const auto xMin = std::min(tip.x, std::min(prev.x, next.x)) - FLT_EPSILON;
+		const auto xMax = std::max(tip.x, std::max(prev.x, next.x)) + FLT_EPSILON;
+		const auto yMin = std::min(tip.y, std::min(prev.y, next.y)) - FLT_EPSILON;
+		const auto yMax = std::max(tip.y, std::max(prev.y, next.y)) + FLT_EPSILON;
 		return !(p.x < xMin || xMax < p.x || p.y < yMin || yMax < p.y);
 	}
 	/*! Square Distance of a point to a line. Used to deal with floating point errors when checking if point is on a line. */
@@ -0,0 +1,294 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EHeadlessRunner.cpp: Runs an IApp without window or renderer (PLATFORM_HEADLESS).
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EHeadlessRunner.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
+
+namespace
+{
+	// Nearest rank percentile of sorted values
+	float GetPercentile(const std::vector<float>& sortedValues, float percentile)
+	{
+		if (sortedValues.empty())
+			return 0.f;
+
+		const size_t rank = static_cast<size_t>(ceilf(percentile / 100.f * sortedValues.size()));
+		return sortedValues[std::max(rank, size_t(1)) - 1];
+	}
+
+	void WriteStatistics(std::ostream& os, const char* name, std::vector<float>& values)
+	{
+		std::sort(values.begin(), values.end());
+		float total = 0.f;
+		for (const float value : values)
+			total += value;
+
+		os << "\t\"" << name << "\": { "
+			<< "\"mean\": " << (values.empty() ? 0.f : total / values.size()) << ", "
+			<< "\"min\": " << GetPercentile(values, 0.f) << ", "
+			<< "\"p50\": " << GetPercentile(values, 50.f) << ", "
+			<< "\"p90\": " << GetPercentile(values, 90.f) << ", "
+			<< "\"p95\": " << GetPercentile(values, 95.f) << ", "
+			<< "\"p99\": " << GetPercentile(values, 99.f) << ", "
+			<< "\"max\": " << GetPercentile(values, 100.f) << " }";
+	}
+
+	// trace.json becomes trace_<app>.json
+	std::string GetTracePath(const std::string& tracePath, const std::string& appName)
+	{
+		const size_t extension = tracePath.find_last_of('.');
+		if (extension == std::string::npos || tracePath.find_first_of("/\\", extension) != std::string::npos)
+			return tracePath + "_" + appName;
+		return tracePath.substr(0, extension) + "_" + appName + tracePath.substr(extension);
+	}
+
+	// Times the scheduling overhead of empty jobs, dependency chains and parallel fors of the JOBSYSTEM, prints the results
+	void RunJobSystemBenchmark()
+	{
+		using Clock = std::chrono::high_resolution_clock;
+		const auto getMicroSeconds = [](Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::micro>(Clock::now() - start).count();
+		};
+
+		//Empty jobs: pure cost of scheduling, running and fencing a job
+		const int nrOfJobs{ 100000 };
+		std::atomic<int> nrOfJobsRun{ 0 };
+		auto start = Clock::now();
+		for (int i{ 0 }; i < nrOfJobs; ++i)
+			JOBSYSTEM->Schedule([&nrOfJobsRun]() { ++nrOfJobsRun; });
+		JOBSYSTEM->WaitForFrame();
+		const float emptyJobUs{ getMicroSeconds(start) / nrOfJobs };
+
+		//Dependency chain: every job waits on the previous one, so this is the latency from one job finishing to the next one running
+		const int chainLength{ 10000 };
+		start = Clock::now();
+		Elite::JobHandle previous{};
+		for (int i{ 0 }; i < chainLength; ++i)
+			previous = JOBSYSTEM->Schedule([&nrOfJobsRun]() { ++nrOfJobsRun; }, { previous });
+		JOBSYSTEM->Wait(previous);
+		const float chainJobUs{ getMicroSeconds(start) / chainLength };
+
+		//Parallel for over a light loop body, against the same loop on one thread
+		const int count{ 1 << 20 };
+		std::vector<float> values(count);
+		const auto loopBody = [&values](int begin, int end)
+		{
+			for (int i{ begin }; i < end; ++i)
+				values[i] = sqrtf(static_cast<float>(i));
+		};
+
+		start = Clock::now();
+		loopBody(0, count);
+		const float serialUs{ getMicroSeconds(start) };
+
+		std::cout << "[JobSystem Benchmark] " << JOBSYSTEM->GetNrOfThreads() << " threads, " << emptyJobUs << " us/empty job, "
+			<< chainJobUs << " us/job in a dependency chain (" << nrOfJobsRun << " jobs run)" << std::endl;
+
+		for (const int grainSize : { 64, 1024, 16384 })
+		{
+			start = Clock::now();
+			JOBSYSTEM->ParallelFor(count, grainSize, loopBody);
+			const float parallelUs{ getMicroSeconds(start) };
+
+			//Thread time spent on top of the serial loop, spread over the chunks
+			const int nrOfChunks{ (count + grainSize - 1) / grainSize };
+			const float overheadUs{ (parallelUs * JOBSYSTEM->GetNrOfThreads() - serialUs) / nrOfChunks };
+			std::cout << "[JobSystem Benchmark] parallel for over " << count << " elements, grain size " << grainSize << ": "
+				<< parallelUs << " us (serial " << serialUs << " us), " << overheadUs << " us overhead/chunk" << std::endl;
+		}
+	}
+
+	// Engine benchmarks that don't belong to an app, run with "--benchmark <name>"
+	using Benchmark = void(*)();
+	const std::pair<const char*, Benchmark> Benchmarks[]{ { "jobs", &RunJobSystemBenchmark } };
+
+	Benchmark FindBenchmark(const std::string& name)
+	{
+		for (const auto& benchmark : Benchmarks)
+		{
+			if (name == benchmark.first)
+				return benchmark.second;
+		}
+		return nullptr;
+	}
+}
+
+Elite::HeadlessRunner::HeadlessRunner()
+{
+	const WindowParams params{};
+	m_pCamera = new Camera2D(params.width, params.height);
+	DEBUGRENDERER2D->Initialize(m_pCamera);
+
+	m_pImmediateUI = new EImmediateUI();
+	m_pImmediateUI->Initialize(nullptr);
+}
+
+Elite::HeadlessRunner::~HeadlessRunner()
+{
+	SAFE_DELETE(m_pImmediateUI);
+	SAFE_DELETE(m_pCamera);
+}
+
+bool Elite::HeadlessRunner::ReadParameters(const AppParameters& appParameters, HeadlessParams& params)
+{
+	try
+	{
+		params.appNames = appParameters.GetStrings("app");
+		params.benchmarkNames = appParameters.GetStrings("benchmark");
+		params.nrOfFrames = appParameters.GetInt("frames", params.nrOfFrames);
+		params.nrOfWarmUpFrames = appParameters.GetInt("warmup", params.nrOfWarmUpFrames);
+		params.timeStep = appParameters.GetFloat("dt", params.timeStep);
+		params.outputPath = appParameters.GetString("out", params.outputPath);
+		params.tracePath = appParameters.GetString("trace", params.tracePath);
+	}
+	catch (const Elite_Exception& e)
+	{
+		std::cout << e._msg << std::endl;
+		return false;
+	}
+
+	return (!params.appNames.empty() || !params.benchmarkNames.empty()) && params.nrOfFrames > 0 && params.nrOfWarmUpFrames >= 0 && params.timeStep > 0.f;
+}
+
+std::string Elite::HeadlessRunner::GetUsage()
+{
+	std::string usage{ "Usage: --app <name>[,<name>...] [--benchmark <name>[,<name>...]] [--frames <n>] [--warmup <n>] [--dt <seconds>] [--out <file>] [--trace <file>] [--<app parameter> <value>...]\nApps:" };
+	for (const auto& name : APPREGISTRY->GetAppNames())
+		usage += " " + name;
+	usage += "\nBenchmarks:";
+	for (const auto& benchmark : Benchmarks)
+		usage += std::string{ " " } + benchmark.first;
+	return usage;
+}
+
+void Elite::HeadlessRunner::RunBenchmarks(const HeadlessParams& params)
+{
+	for (const auto& name : params.benchmarkNames)
+	{
+		if (!FindBenchmark(name))
+			throw Elite_Exception("Unknown benchmark \"" + name + "\"");
+	}
+
+	for (const auto& name : params.benchmarkNames)
+	{
+		FindBenchmark(name)();
+		JOBSYSTEM->WaitForFrame();
+	}
+}
+
+std::string Elite::HeadlessRunner::RunAll(const HeadlessParams& params, const AppParameters& appParameters)
+{
+	//Check every name up front, a typo in the last app shouldn't cost the runs before it
+	for (const auto& appName : params.appNames)
+	{
+		if (!APPREGISTRY->HasApp(appName))
+			throw Elite_Exception("Unknown app \"" + appName + "\"");
+	}
+
+	std::string reports{};
+	for (size_t i = 0; i < params.appNames.size(); ++i)
+	{
+		{
+			HeadlessRunner runner{};
+			IApp* pApp = APPREGISTRY->CreateApp(params.appNames[i], appParameters);
+			reports += (i == 0 ? "" : ",\n") + runner.Run(pApp, params.appNames[i], params);
+			SAFE_DELETE(pApp);
+		}
+
+		if (!params.tracePath.empty())
+		{
+			const std::string tracePath{ params.appNames.size() > 1 ? GetTracePath(params.tracePath, params.appNames[i]) : params.tracePath };
+			if (!PROFILER->ExportChromeTrace(tracePath))
+				std::cerr << "Could not write the trace to " << tracePath << std::endl;
+		}
+
+		//The next app starts from an empty world
+		PHYSICSWORLD->Destroy();
+	}
+
+	if (params.appNames.size() > 1)
+		return "[\n" + reports + "\n]\n";
+	return reports + "\n";
+}
+
+std::string Elite::HeadlessRunner::Run(IApp* pApp, const std::string& appName, const HeadlessParams& params)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	const auto getMilliSeconds = [](Clock::time_point start, Clock::time_point end)
+	{
+		return std::chrono::duration<float, std::milli>(end - start).count();
+	};
+
+	pApp->Start();
+
+	std::vector<float> updateMs{};
+	std::vector<float> frameMs{};
+	updateMs.reserve(params.nrOfFrames);
+	frameMs.reserve(params.nrOfFrames);
+
+	//Same frame as the windowed loop in main.cpp, with a fixed timestep and nothing to present
+	for (int frame = 0; frame < params.nrOfWarmUpFrames + params.nrOfFrames; ++frame)
+	{
+		//The trace only holds timed frames
+		if (frame == params.nrOfWarmUpFrames)
+			PROFILER->ClearFrames();
+		PROFILER->BeginFrame();
+
+		const auto frameStart = Clock::now();
+		TIMER->Update();
+		m_pImmediateUI->NewFrame(nullptr, params.timeStep);
+
+		PHYSICSWORLD->Simulate(params.timeStep);
+		m_pCamera->Update();
+
+		const auto updateStart = Clock::now();
+		{
+			ELITE_PROFILE_SCOPE("IApp::Update");
+			pApp->Update(params.timeStep);
+		}
+		const auto updateEnd = Clock::now();
+
+		PHYSICSWORLD->RenderDebug();
+		{
+			ELITE_PROFILE_SCOPE("IApp::Render");
+			pApp->Render(params.timeStep);
+		}
+		m_pImmediateUI->Render();
+
+		JOBSYSTEM->WaitForFrame();
+		PROFILER->EndFrame();
+
+		if (frame >= params.nrOfWarmUpFrames)
+		{
+			updateMs.push_back(getMilliSeconds(updateStart, updateEnd));
+			frameMs.push_back(getMilliSeconds(frameStart, Clock::now()));
+		}
+	}
+
+	return CreateReport(appName, params, updateMs, frameMs);
+}
+
+std::string Elite::HeadlessRunner::CreateReport(const std::string& appName, const HeadlessParams& params, std::vector<float>& updateMs, std::vector<float>& frameMs)
+{
+	float totalMs = 0.f;
+	for (const float ms : frameMs)
+		totalMs += ms;
+
+	std::stringstream report{};
+	report << "{\n"
+		<< "\t\"app\": \"" << appName << "\",\n"
+		<< "\t\"frames\": " << params.nrOfFrames << ",\n"
+		<< "\t\"warmUpFrames\": " << params.nrOfWarmUpFrames << ",\n"
+		<< "\t\"timeStep\": " << params.timeStep << ",\n"
+		<< "\t\"threads\": " << JOBSYSTEM->GetNrOfThreads() << ",\n"
+		<< "\t\"totalSeconds\": " << totalMs / 1000.f << ",\n";
+	WriteStatistics(report, "updateMs", updateMs);
+	report << ",\n";
+	WriteStatistics(report, "frameMs", frameMs);
+	report << "\n}";
+	return report.str();
+}
@@ -0,0 +1,61 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EHeadlessRunner.h: Runs an IApp without window or renderer (PLATFORM_HEADLESS), for benchmarks and soak tests.
+// The app is updated with a fixed timestep as fast as possible, the update times of every frame are reported as JSON.
+// "--app A,B" runs the apps back to back in one process, every app gets a fresh physics world, camera and UI.
+// "--benchmark jobs" runs engine benchmarks that don't belong to an app (see GetUsage), before the apps.
+/*=============================================================================*/
+#ifndef ELITE_HEADLESS_RUNNER
+#define	ELITE_HEADLESS_RUNNER
+
+class IApp;
+class Camera2D;
+
+namespace Elite
+{
+	class EImmediateUI;
+	class AppParameters;
+
+	struct HeadlessParams
+	{
+		std::vector<std::string> appNames;
+		std::vector<std::string> benchmarkNames;
+		int nrOfFrames = 1000;
+		int nrOfWarmUpFrames = 60; // updated before the timed frames, not reported
+		float timeStep = 1.f / 60.f;
+		std::string outputPath; // the report goes to the console when empty
+		std::string tracePath; // Chrome trace of the last timed frames (see EProfiler.h), "<name>_<app>.<ext>" per app when running several
+	};
+
+	class HeadlessRunner final
+	{
+	public:
+		HeadlessRunner();
+		~HeadlessRunner();
+
+		// Reads --app, --benchmark, --frames, --warmup, --dt, --out and --trace, the other parameters are for the apps. False when they are invalid.
+		static bool ReadParameters(const AppParameters& appParameters, HeadlessParams& params);
+		static std::string GetUsage();
+
+		// Creates every app from the registry and runs them one after the other, returns a JSON report per app (an array for several apps).
+		// Throws an Elite_Exception for an unknown app name.
+		static std::string RunAll(const HeadlessParams& params, const AppParameters& appParameters);
+		// Runs the engine benchmarks, they print their results. Throws an Elite_Exception for an unknown benchmark name.
+		static void RunBenchmarks(const HeadlessParams& params);
+
+		// Starts the app and runs the warm up and timed frames, returns the JSON report of the timed frames
+		std::string Run(IApp* pApp, const std::string& appName, const HeadlessParams& params);
+
+	private:
+		Camera2D* m_pCamera = nullptr;
+		EImmediateUI* m_pImmediateUI = nullptr;
+
+		static std::string CreateReport(const std::string& appName, const HeadlessParams& params, std::vector<float>& updateMs, std::vector<float>& frameMs);
+
+		//C++ make the class non-copyable
+		HeadlessRunner(const HeadlessRunner&) = delete;
+		HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+	};
+}
+#endif
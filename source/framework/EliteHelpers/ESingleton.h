@@ -40,6 +40,6 @@ namespace Elite
 	};
 
 	template<typename T>
-	typename T* ESingleton<T>::m_pInstance = 0;
+	T* ESingleton<T>::m_pInstance = 0;
 }
 #endif
\ No newline at end of file
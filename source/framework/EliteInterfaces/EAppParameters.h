@@ -0,0 +1,115 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EAppParameters.h: Named parameters for the apps, e.g. "--agents 5000" from the command line.
+// Apps read the ones they know in their constructor and keep their own default for the others.
+/*=============================================================================*/
+#ifndef ELITE_APP_PARAMETERS
+#define	ELITE_APP_PARAMETERS
+
+namespace Elite
+{
+	class AppParameters final
+	{
+	public:
+		AppParameters() = default;
+
+		// Every "--name value" pair, throws an Elite_Exception for a name without value
+		static AppParameters FromArguments(int argc, char* argv[]);
+
+		bool Has(const std::string& name) const { return m_Values.find(name) != m_Values.end(); }
+		void Set(const std::string& name, const std::string& value) { m_Values[name] = value; }
+
+		// The getters return the default when the parameter isn't set and throw an Elite_Exception when its value doesn't parse
+		std::string GetString(const std::string& name, const std::string& defaultValue) const;
+		int GetInt(const std::string& name, int defaultValue) const;
+		float GetFloat(const std::string& name, float defaultValue) const;
+		bool GetBool(const std::string& name, bool defaultValue) const;
+		// Comma separated values, e.g. "--app Flocking,InfluenceMap"
+		std::vector<std::string> GetStrings(const std::string& name) const;
+
+	private:
+		std::map<std::string, std::string> m_Values;
+	};
+
+	inline AppParameters AppParameters::FromArguments(int argc, char* argv[])
+	{
+		AppParameters params{};
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string argument{ argv[i] };
+			if (argument.compare(0, 2, "--") != 0 || i + 1 >= argc)
+				throw Elite_Exception("Expected \"--name value\" arguments, got \"" + argument + "\"");
+
+			params.Set(argument.substr(2), argv[++i]);
+		}
+		return params;
+	}
+
+	inline std::string AppParameters::GetString(const std::string& name, const std::string& defaultValue) const
+	{
+		const auto it = m_Values.find(name);
+		return it != m_Values.end() ? it->second : defaultValue;
+	}
+
+	inline int AppParameters::GetInt(const std::string& name, int defaultValue) const
+	{
+		const auto it = m_Values.find(name);
+		if (it == m_Values.end())
+			return defaultValue;
+
+		size_t nrOfParsedCharacters = 0;
+		try
+		{
+			const int value = std::stoi(it->second, &nrOfParsedCharacters);
+			if (nrOfParsedCharacters == it->second.size())
+				return value;
+		}
+		catch (const std::exception&) {}
+		throw Elite_Exception("Parameter --" + name + " expects an integer, got \"" + it->second + "\"");
+	}
+
+	inline float AppParameters::GetFloat(const std::string& name, float defaultValue) const
+	{
+		const auto it = m_Values.find(name);
+		if (it == m_Values.end())
+			return defaultValue;
+
+		size_t nrOfParsedCharacters = 0;
+		try
+		{
+			const float value = std::stof(it->second, &nrOfParsedCharacters);
+			if (nrOfParsedCharacters == it->second.size())
+				return value;
+		}
+		catch (const std::exception&) {}
+		throw Elite_Exception("Parameter --" + name + " expects a number, got \"" + it->second + "\"");
+	}
+
+	inline bool AppParameters::GetBool(const std::string& name, bool defaultValue) const
+	{
+		const auto it = m_Values.find(name);
+		if (it == m_Values.end())
+			return defaultValue;
+
+		if (it->second == "1" || it->second == "true")
+			return true;
+		if (it->second == "0" || it->second == "false")
+			return false;
+		throw Elite_Exception("Parameter --" + name + " expects true or false, got \"" + it->second + "\"");
+	}
+
+	inline std::vector<std::string> AppParameters::GetStrings(const std::string& name) const
+	{
+		std::vector<std::string> values{};
+		std::stringstream stream{ GetString(name, "") };
+		std::string value{};
+		while (std::getline(stream, value, ','))
+		{
+			if (!value.empty())
+				values.push_back(value);
+		}
+		return values;
+	}
+}
+#endif
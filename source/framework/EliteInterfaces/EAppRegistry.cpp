@@ -0,0 +1,28 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EAppRegistry.cpp: Creates the apps by name.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EAppRegistry.h"
+
+bool Elite::AppRegistry::Register(const std::string& name, AppFactory factory)
+{
+	const bool isNewName = m_Factories.emplace(name, factory).second;
+	assert(isNewName && "<AppRegistry::Register>: two apps registered under the same name");
+	return isNewName;
+}
+
+IApp* Elite::AppRegistry::CreateApp(const std::string& name, const AppParameters& params) const
+{
+	const auto it = m_Factories.find(name);
+	return it != m_Factories.end() ? it->second(params) : nullptr;
+}
+
+std::vector<std::string> Elite::AppRegistry::GetAppNames() const
+{
+	std::vector<std::string> names{};
+	for (const auto& factory : m_Factories)
+		names.push_back(factory.first);
+	return names;
+}
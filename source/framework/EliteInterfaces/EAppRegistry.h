@@ -0,0 +1,48 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EAppRegistry.h: Creates the apps by name. Every app registers itself in its cpp:
+//		REGISTER_APP(App_Flocking, "Flocking")
+// Apps with a constructor taking AppParameters get the parameters of the run, the others are default constructed.
+/*=============================================================================*/
+#ifndef ELITE_APP_REGISTRY
+#define	ELITE_APP_REGISTRY
+
+#include <type_traits>
+#include "EIApp.h"
+#include "EAppParameters.h"
+
+namespace Elite
+{
+	class AppRegistry final : public ESingleton<AppRegistry>
+	{
+	public:
+		typedef IApp* (*AppFactory)(const AppParameters& params);
+
+		// Returns true so it can initialize a static, see REGISTER_APP
+		bool Register(const std::string& name, AppFactory factory);
+
+		// nullptr when no app has that name
+		IApp* CreateApp(const std::string& name, const AppParameters& params) const;
+		bool HasApp(const std::string& name) const { return m_Factories.find(name) != m_Factories.end(); }
+		std::vector<std::string> GetAppNames() const;
+
+		template<class T_App>
+		static IApp* Create(const AppParameters& params)
+		{
+			return Create<T_App>(params, std::is_constructible<T_App, const AppParameters&>{});
+		}
+
+	private:
+		std::map<std::string, AppFactory> m_Factories;
+
+		template<class T_App>
+		static IApp* Create(const AppParameters& params, std::true_type) { return new T_App(params); }
+		template<class T_App>
+		static IApp* Create(const AppParameters&, std::false_type) { return new T_App(); }
+	};
+}
+
+#define REGISTER_APP(T_App, name) \
+	namespace { const bool g_Is##T_App##Registered = APPREGISTRY->Register(name, &Elite::AppRegistry::Create<T_App>); }
+#endif
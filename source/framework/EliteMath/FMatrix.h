@@ -83,8 +83,8 @@ namespace Elite
 		}
 		void Add(const FMatrix& other)
 		{
-			int maxRows = min(GetNrOfRows(), other.GetNrOfRows());
-			int maxColumns = min(GetNrOfColumns(), other.GetNrOfColumns());
+			int maxRows = std::min(GetNrOfRows(), other.GetNrOfRows());
+			int maxColumns = std::min(GetNrOfColumns(), other.GetNrOfColumns());
 
 			for (int c_row = 0; c_row < maxRows; ++c_row) {
 				for (int c_column = 0; c_column < maxColumns; ++c_column) {
@@ -115,8 +115,8 @@ namespace Elite
 		}
 		void MatrixMultiply(const FMatrix& op2, FMatrix& result)
 		{
-			int maxRows = min(GetNrOfRows(), result.GetNrOfRows());
-			int maxColumns = min(op2.GetNrOfColumns(), result.GetNrOfColumns());
+			int maxRows = std::min(GetNrOfRows(), result.GetNrOfRows());
+			int maxColumns = std::min(op2.GetNrOfColumns(), result.GetNrOfColumns());
 
 			for (int c_row = 0; c_row < maxRows; ++c_row)
 			{
@@ -141,8 +141,8 @@ namespace Elite
 
 		void Copy(const FMatrix& other)
 		{
-			int maxRows = min(GetNrOfRows(), other.GetNrOfRows());
-			int maxColumns = min(GetNrOfColumns(), other.GetNrOfColumns());
+			int maxRows = std::min(GetNrOfRows(), other.GetNrOfRows());
+			int maxColumns = std::min(GetNrOfColumns(), other.GetNrOfColumns());
 
 			for (int c_row = 0; c_row < maxRows; ++c_row) {
 				for (int c_column = 0; c_column < maxColumns; ++c_column) {
@@ -154,8 +154,8 @@ namespace Elite
 
 		void Subtract(const FMatrix& other)
 		{
-			int maxRows = min(GetNrOfRows(), other.GetNrOfRows());
-			int maxColumns = min(GetNrOfColumns(), other.GetNrOfColumns());
+			int maxRows = std::min(GetNrOfRows(), other.GetNrOfRows());
+			int maxColumns = std::min(GetNrOfColumns(), other.GetNrOfColumns());
 
 			for (int c_row = 0; c_row < maxRows; ++c_row) 
 			{
@@ -187,8 +187,8 @@ namespace Elite
 		}
 		float Dot(const FMatrix& op2) const
 		{
-			int mR = min(GetNrOfRows(), op2.GetNrOfRows());
-			int mC = min(GetNrOfColumns(), op2.GetNrOfColumns());
+			int mR = std::min(GetNrOfRows(), op2.GetNrOfRows());
+			int mC = std::min(GetNrOfColumns(), op2.GetNrOfColumns());
 
 			float dot = 0;
 			for (int c_row = 0; c_row < mR; ++c_row) {
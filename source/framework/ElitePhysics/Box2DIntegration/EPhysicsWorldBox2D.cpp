@@ -50,6 +50,7 @@ void PhysicsWorld::Initialize()
 template<>
 void PhysicsWorld::Simulate(float elapsedTime)
 {
+	ELITE_PROFILE_SCOPE("PhysicsWorld::Simulate");
 	if (!m_pPhysicsWorld)
 		return;
 
@@ -0,0 +1,394 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EProfiler.cpp: Per-frame CPU profiler with scoped zones.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EProfiler.h"
+#include <cstdint>
+#include <iomanip>
+
+namespace Elite
+{
+	// Single producer (the owning thread), single consumer (EndFrame on the main thread)
+	struct Profiler::ThreadBuffer final
+	{
+		static const unsigned long long Capacity = 1 << 14; // power of two
+
+		std::vector<ProfileZone> zones = std::vector<ProfileZone>(Capacity);
+		std::atomic<unsigned long long> nrOfWrittenZones{ 0 };
+		unsigned long long nrOfReadZones = 0; // consumer only
+		unsigned int depth = 0; // producer only
+		unsigned int threadIdx = 0;
+		std::string name;
+		std::atomic<bool> isInUse{ true }; // a thread that ends hands its buffer to the next new thread
+	};
+}
+
+namespace
+{
+	// Creating or destroying the profiler invalidates the buffers the threads kept.
+	// Bumped with release once the profiler is set up, threads read it with acquire before they use their buffer.
+	std::atomic<uint32_t> g_ProfilerGeneration{ 0 };
+
+	struct ThreadBufferOwner final
+	{
+		Elite::Profiler::ThreadBuffer* pBuffer = nullptr;
+		uint32_t generation = 0;
+
+		bool IsValid() const { return pBuffer && generation == g_ProfilerGeneration.load(std::memory_order_acquire); }
+		~ThreadBufferOwner()
+		{
+			if (IsValid())
+				pBuffer->isInUse.store(false, std::memory_order_release);
+		}
+	};
+	thread_local ThreadBufferOwner t_ThreadBuffer;
+
+	void WriteJsonString(std::ostream& os, const std::string& text)
+	{
+		os << '"';
+		for (const char c : text)
+		{
+			if (c == '"' || c == '\\')
+				os << '\\';
+			os << c;
+		}
+		os << '"';
+	}
+}
+
+Elite::Profiler::Profiler()
+	: m_StartTime(std::chrono::steady_clock::now())
+{
+	g_ProfilerGeneration.fetch_add(1, std::memory_order_release);
+	SetThreadName("Main");
+}
+
+Elite::Profiler::~Profiler()
+{
+	g_ProfilerGeneration.fetch_add(1, std::memory_order_release);
+}
+
+Elite::Profiler::ThreadBuffer* Elite::Profiler::BeginZone()
+{
+	if (!t_ThreadBuffer.IsValid())
+		RegisterThread();
+
+	++t_ThreadBuffer.pBuffer->depth;
+	return t_ThreadBuffer.pBuffer;
+}
+
+void Elite::Profiler::EndZone(ThreadBuffer* pBuffer, const char* name, long long startNs, long long endNs)
+{
+	--pBuffer->depth;
+
+	//The slot is only read again after the release below, by EndFrame
+	const unsigned long long idx = pBuffer->nrOfWrittenZones.load(std::memory_order_relaxed);
+	pBuffer->zones[idx & (ThreadBuffer::Capacity - 1)] = ProfileZone{ name, startNs, endNs, pBuffer->depth, pBuffer->threadIdx };
+	pBuffer->nrOfWrittenZones.store(idx + 1, std::memory_order_release);
+}
+
+void Elite::Profiler::RegisterThread()
+{
+	std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+
+	//Reuse the buffer of a thread that ended, pools that come and go don't add threads to the timeline
+	ThreadBuffer* pBuffer = nullptr;
+	for (const auto& pFreeBuffer : m_ThreadBuffers)
+	{
+		bool isInUse = false;
+		if (pFreeBuffer->isInUse.compare_exchange_strong(isInUse, true, std::memory_order_acquire))
+		{
+			pBuffer = pFreeBuffer.get();
+			pBuffer->depth = 0;
+			pBuffer->name.clear();
+			break;
+		}
+	}
+
+	if (!pBuffer)
+	{
+		m_ThreadBuffers.push_back(std::make_unique<ThreadBuffer>());
+		pBuffer = m_ThreadBuffers.back().get();
+		pBuffer->threadIdx = static_cast<unsigned int>(m_ThreadBuffers.size() - 1);
+	}
+
+	t_ThreadBuffer.pBuffer = pBuffer;
+	t_ThreadBuffer.generation = g_ProfilerGeneration.load(std::memory_order_acquire);
+}
+
+void Elite::Profiler::SetThreadName(const std::string& name)
+{
+	if (!t_ThreadBuffer.IsValid())
+		RegisterThread();
+
+	std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+	t_ThreadBuffer.pBuffer->name = name;
+}
+
+std::string Elite::Profiler::GetThreadName(unsigned int threadIdx) const
+{
+	std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+	if (threadIdx < m_ThreadBuffers.size() && !m_ThreadBuffers[threadIdx]->name.empty())
+		return m_ThreadBuffers[threadIdx]->name;
+	return "Thread " + std::to_string(threadIdx);
+}
+
+void Elite::Profiler::BeginFrame()
+{
+	m_FrameStartNs = GetTimeNs();
+}
+
+void Elite::Profiler::EndFrame()
+{
+	ProfileFrame frame{};
+	frame.startNs = m_FrameStartNs;
+	frame.endNs = GetTimeNs();
+	CollectZones(frame);
+
+	if (!IsRecording())
+		return;
+
+	m_Frames.push_back(std::move(frame));
+	if (m_Frames.size() > MaxNrOfFrames)
+		m_Frames.pop_front();
+}
+
+void Elite::Profiler::CollectZones(ProfileFrame& frame)
+{
+	std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+	for (const auto& pBuffer : m_ThreadBuffers)
+	{
+		const unsigned long long nrOfWrittenZones = pBuffer->nrOfWrittenZones.load(std::memory_order_acquire);
+		unsigned long long first = pBuffer->nrOfReadZones;
+		if (nrOfWrittenZones - first > ThreadBuffer::Capacity)
+		{
+			frame.nrOfDroppedZones += static_cast<int>(nrOfWrittenZones - first - ThreadBuffer::Capacity);
+			first = nrOfWrittenZones - ThreadBuffer::Capacity;
+		}
+
+		for (unsigned long long idx = first; idx < nrOfWrittenZones; ++idx)
+			frame.zones.push_back(pBuffer->zones[idx & (ThreadBuffer::Capacity - 1)]);
+		pBuffer->nrOfReadZones = nrOfWrittenZones;
+	}
+}
+
+bool Elite::Profiler::ExportChromeTrace(const std::string& filePath) const
+{
+	std::ofstream file{ filePath };
+	if (!file)
+		return false;
+
+	//Complete events ("X") with timestamps in microseconds, plus the thread names as metadata
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool isFirstEvent = true;
+	const auto beginEvent = [&file, &isFirstEvent]()
+	{
+		file << (isFirstEvent ? "" : ",\n");
+		isFirstEvent = false;
+	};
+
+	unsigned int nrOfThreads = 0;
+	{
+		std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+		nrOfThreads = static_cast<unsigned int>(m_ThreadBuffers.size());
+	}
+	for (unsigned int threadIdx = 0; threadIdx < nrOfThreads; ++threadIdx)
+	{
+		beginEvent();
+		file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIdx << ",\"args\":{\"name\":";
+		WriteJsonString(file, GetThreadName(threadIdx));
+		file << "}}";
+	}
+
+	file << std::fixed << std::setprecision(3);
+	for (const auto& frame : m_Frames)
+	{
+		beginEvent();
+		file << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << frame.startNs / 1000.0
+			<< ",\"dur\":" << (frame.endNs - frame.startNs) / 1000.0 << "}";
+
+		for (const auto& zone : frame.zones)
+		{
+			beginEvent();
+			file << "{\"name\":";
+			WriteJsonString(file, zone.name);
+			file << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << zone.threadIdx << ",\"ts\":" << zone.startNs / 1000.0
+				<< ",\"dur\":" << (zone.endNs - zone.startNs) / 1000.0 << "}";
+		}
+	}
+	file << "\n]}\n";
+	return static_cast<bool>(file);
+}
+
+#if (PLATFORM_ID == PLATFORM_WINDOWS) || (PLATFORM_ID == PLATFORM_HEADLESS)
+namespace
+{
+	// Zones with the same name get the same color
+	unsigned int HashName(const char* name)
+	{
+		unsigned int hash = 2166136261u;
+		for (; *name; ++name)
+			hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+		return hash;
+	}
+}
+
+void Elite::Profiler::RenderUI()
+{
+	if (!m_IsWindowVisible)
+		return;
+
+	ImGui::SetNextWindowSize(ImVec2(720, 360), ImGuiSetCond_FirstUseEver);
+	if (!ImGui::Begin("Profiler", &m_IsWindowVisible))
+	{
+		ImGui::End();
+		return;
+	}
+
+	bool isRecording = IsRecording();
+	if (ImGui::Checkbox("Record", &isRecording))
+		SetRecording(isRecording);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace"))
+		m_ExportMessage = ExportChromeTrace("profile_trace.json") ? "Written to profile_trace.json" : "Could not write profile_trace.json";
+	ImGui::SameLine();
+	ImGui::Text("%s", m_ExportMessage.c_str());
+
+	if (m_Frames.empty())
+	{
+		ImGui::End();
+		return;
+	}
+
+	//--- Frame times, click a bar to inspect that frame ---
+	const int nrOfFrames = static_cast<int>(m_Frames.size());
+	if (m_SelectedFrame >= nrOfFrames)
+		m_SelectedFrame = -1;
+	const int frameIdx = m_SelectedFrame < 0 ? nrOfFrames - 1 : m_SelectedFrame;
+	const ProfileFrame& frame = m_Frames[frameIdx];
+	const float frameMs = (frame.endNs - frame.startNs) / 1000000.f;
+
+	const auto getFrameMs = [](void* pData, int idx)
+	{
+		const ProfileFrame& frame = (*static_cast<const std::deque<ProfileFrame>*>(pData))[idx];
+		return (frame.endNs - frame.startNs) / 1000000.f;
+	};
+	char overlay[64];
+	snprintf(overlay, sizeof(overlay), "frame %d: %.3f ms%s", frameIdx, frameMs, m_SelectedFrame < 0 ? " (live)" : "");
+	ImGui::PlotHistogram("##FrameTimes", getFrameMs, &m_Frames, nrOfFrames, 0, overlay, 0.f, FLT_MAX, ImVec2(ImGui::GetContentRegionAvailWidth(), 50));
+	if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0))
+	{
+		const float t = (ImGui::GetMousePos().x - ImGui::GetItemRectMin().x) / std::max(1.f, ImGui::GetItemRectSize().x);
+		m_SelectedFrame = Clamp(static_cast<int>(t * nrOfFrames), 0, nrOfFrames - 1);
+	}
+	if (ImGui::Button("Follow last frame"))
+		m_SelectedFrame = -1;
+	ImGui::SameLine();
+	ImGui::PushItemWidth(150);
+	ImGui::SliderFloat("Zoom", &m_TimelineZoom, 1.f, 50.f, "%.1fx");
+	ImGui::PopItemWidth();
+	if (frame.nrOfDroppedZones > 0)
+	{
+		ImGui::SameLine();
+		ImGui::Text("%d zones dropped", frame.nrOfDroppedZones);
+	}
+
+	//--- Timeline: a lane per thread, nested zones below their parent ---
+	unsigned int nrOfThreads = 1;
+	std::vector<unsigned int> laneDepths{};
+	for (const auto& zone : frame.zones)
+	{
+		nrOfThreads = std::max(nrOfThreads, zone.threadIdx + 1);
+		laneDepths.resize(nrOfThreads, 0);
+		laneDepths[zone.threadIdx] = std::max(laneDepths[zone.threadIdx], zone.depth + 1);
+	}
+	laneDepths.resize(nrOfThreads, 0);
+
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.f;
+	const float labelWidth = 90.f;
+	float timelineHeight = 0.f;
+	for (const unsigned int depth : laneDepths)
+		timelineHeight += (std::max(depth, 1u) + 0.5f) * rowHeight;
+
+	ImGui::BeginChild("Timeline", ImVec2(0, std::min(timelineHeight + 20.f, 220.f)), true, ImGuiWindowFlags_HorizontalScrollbar);
+	{
+		const float timelineWidth = (ImGui::GetContentRegionAvailWidth() - labelWidth) * m_TimelineZoom;
+		const float pixelsPerNs = timelineWidth / std::max(1.f, static_cast<float>(frame.endNs - frame.startNs));
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+
+		std::vector<float> laneY(nrOfThreads, 0.f);
+		float y = origin.y;
+		for (unsigned int threadIdx = 0; threadIdx < nrOfThreads; ++threadIdx)
+		{
+			laneY[threadIdx] = y;
+			pDrawList->AddText(ImVec2(origin.x, y + 2.f), ImGui::GetColorU32(ImGuiCol_Text), GetThreadName(threadIdx).c_str());
+			y += (std::max(laneDepths[threadIdx], 1u) + 0.5f) * rowHeight;
+		}
+
+		for (const auto& zone : frame.zones)
+		{
+			const float x0 = origin.x + labelWidth + (zone.startNs - frame.startNs) * pixelsPerNs;
+			const float x1 = std::max(x0 + 1.f, origin.x + labelWidth + (zone.endNs - frame.startNs) * pixelsPerNs);
+			const float y0 = laneY[zone.threadIdx] + zone.depth * rowHeight;
+			const ImVec2 min{ x0, y0 };
+			const ImVec2 max{ x1, y0 + rowHeight - 1.f };
+
+			const unsigned int hash = HashName(zone.name);
+			const ImU32 color = ImColor(static_cast<int>(80 + hash % 150), static_cast<int>(80 + (hash >> 8) % 150), static_cast<int>(80 + (hash >> 16) % 150));
+			pDrawList->AddRectFilled(min, max, color);
+			if (x1 - x0 > ImGui::CalcTextSize(zone.name).x + 4.f)
+				pDrawList->AddText(ImVec2(x0 + 2.f, y0 + 1.f), ImColor(0, 0, 0), zone.name);
+
+			if (ImGui::IsMouseHoveringRect(min, max))
+				ImGui::SetTooltip("%s\n%.3f ms", zone.name, (zone.endNs - zone.startNs) / 1000000.f);
+		}
+		ImGui::Dummy(ImVec2(labelWidth + timelineWidth, timelineHeight));
+	}
+	ImGui::EndChild();
+
+	//--- Totals per zone name of the selected frame ---
+	struct ZoneTotal { const char* name; unsigned int threadIdx; int nrOfCalls; long long totalNs; long long maxNs; };
+	std::vector<ZoneTotal> totals{};
+	for (const auto& zone : frame.zones)
+	{
+		auto it = std::find_if(totals.begin(), totals.end(), [&zone](const ZoneTotal& total)
+		{
+			return total.threadIdx == zone.threadIdx && strcmp(total.name, zone.name) == 0;
+		});
+		if (it == totals.end())
+			it = totals.insert(totals.end(), ZoneTotal{ zone.name, zone.threadIdx, 0, 0, 0 });
+
+		const long long durationNs = zone.endNs - zone.startNs;
+		++it->nrOfCalls;
+		it->totalNs += durationNs;
+		it->maxNs = std::max(it->maxNs, durationNs);
+	}
+	std::sort(totals.begin(), totals.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.totalNs > b.totalNs; });
+
+	ImGui::Columns(5, "ZoneTotals");
+	ImGui::Text("Zone"); ImGui::NextColumn();
+	ImGui::Text("Thread"); ImGui::NextColumn();
+	ImGui::Text("Calls"); ImGui::NextColumn();
+	ImGui::Text("Total ms"); ImGui::NextColumn();
+	ImGui::Text("Max ms"); ImGui::NextColumn();
+	ImGui::Separator();
+	for (const auto& total : totals)
+	{
+		ImGui::Text("%s", total.name); ImGui::NextColumn();
+		ImGui::Text("%s", GetThreadName(total.threadIdx).c_str()); ImGui::NextColumn();
+		ImGui::Text("%d", total.nrOfCalls); ImGui::NextColumn();
+		ImGui::Text("%.3f", total.totalNs / 1000000.f); ImGui::NextColumn();
+		ImGui::Text("%.3f", total.maxNs / 1000000.f); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+
+	ImGui::End();
+}
+#else
+void Elite::Profiler::RenderUI()
+{
+}
+#endif
@@ -0,0 +1,144 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EProfiler.h: Per-frame CPU profiler with scoped zones.
+//		void PhysicsWorld::Simulate(float elapsedTime)
+//		{
+//			ELITE_PROFILE_SCOPE("PhysicsWorld::Simulate");
+//			...
+// A zone is recorded when its scope ends, into a ring buffer owned by the recording thread, so recording never locks.
+// EndFrame (main thread, after the frame fence) collects the zones of every thread into the frame history,
+// which RenderUI shows as a timeline and ExportChromeTrace writes as Chrome trace JSON (chrome://tracing, Perfetto).
+// Without USE_PROFILER (stdafx.h) the zones compile to nothing.
+/*=============================================================================*/
+#ifndef ELITE_PROFILER
+#define	ELITE_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Elite
+{
+	// A finished zone, times in nanoseconds since the profiler was created
+	struct ProfileZone
+	{
+		const char* name; // string literal, zones keep the pointer
+		long long startNs;
+		long long endNs;
+		unsigned int depth;
+		unsigned int threadIdx;
+	};
+
+	struct ProfileFrame
+	{
+		long long startNs = 0;
+		long long endNs = 0;
+		std::vector<ProfileZone> zones; // per thread in the order they ended
+		int nrOfDroppedZones = 0; // zones overwritten before they were collected
+	};
+
+	class Profiler final : public ESingleton<Profiler>
+	{
+	public:
+		//=== Constructors & Destructors ===
+		Profiler();
+		~Profiler();
+
+		//=== Frame Functions ===
+		// Call both on the main thread, EndFrame after the frame fence so no job is still recording
+		void BeginFrame();
+		void EndFrame();
+
+		// While not recording zones cost a single check, the history stays as it is
+		bool IsRecording() const { return m_IsRecording.load(std::memory_order_relaxed); }
+		void SetRecording(bool isRecording) { m_IsRecording.store(isRecording, std::memory_order_relaxed); }
+
+		const std::deque<ProfileFrame>& GetFrames() const { return m_Frames; }
+		void ClearFrames() { m_Frames.clear(); m_SelectedFrame = -1; }
+		long long GetTimeNs() const { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_StartTime).count(); }
+		// Shown in the timeline and the trace, threads without a name are called "Thread <index>"
+		void SetThreadName(const std::string& name);
+
+		//=== Output ===
+		// Every frame in the history, false when the file can't be written
+		bool ExportChromeTrace(const std::string& filePath) const;
+		// Frame times, timeline of the selected frame and the zone totals of that frame
+		void RenderUI();
+		bool IsWindowVisible() const { return m_IsWindowVisible; }
+		void SetWindowVisible(bool isVisible) { m_IsWindowVisible = isVisible; }
+
+		//=== Zones (ProfileScope) ===
+		struct ThreadBuffer;
+		// Buffer of the calling thread, one level deeper until EndZone
+		ThreadBuffer* BeginZone();
+		static void EndZone(ThreadBuffer* pBuffer, const char* name, long long startNs, long long endNs);
+
+	private:
+		//=== Internal Functions ===
+		void RegisterThread();
+		void CollectZones(ProfileFrame& frame);
+		std::string GetThreadName(unsigned int threadIdx) const;
+
+		//=== Datamembers ===
+		static const size_t MaxNrOfFrames = 240;
+		const std::chrono::steady_clock::time_point m_StartTime;
+		std::atomic<bool> m_IsRecording{ true };
+
+		// Registered once per thread, read by EndFrame
+		mutable std::mutex m_ThreadMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_ThreadBuffers;
+
+		std::deque<ProfileFrame> m_Frames;
+		long long m_FrameStartNs = 0;
+
+		//UI
+		bool m_IsWindowVisible = false;
+		int m_SelectedFrame = -1; // -1 follows the last frame
+		float m_TimelineZoom = 1.f;
+		std::string m_ExportMessage;
+
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+	};
+
+	// Records the zone from construction to destruction on the calling thread
+	class ProfileScope final
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_pBuffer(Profiler::GetInstance()->IsRecording() ? Profiler::GetInstance()->BeginZone() : nullptr)
+			, m_Name(name)
+			, m_StartNs(m_pBuffer ? Profiler::GetInstance()->GetTimeNs() : 0)
+		{
+		}
+		~ProfileScope()
+		{
+			if (m_pBuffer)
+				Profiler::EndZone(m_pBuffer, m_Name, m_StartNs, Profiler::GetInstance()->GetTimeNs());
+		}
+
+	private:
+		Profiler::ThreadBuffer* const m_pBuffer;
+		const char* const m_Name;
+		const long long m_StartNs;
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+	};
+}
+
+#ifdef USE_PROFILER
+#define ELITE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ELITE_PROFILE_CONCAT(a, b) ELITE_PROFILE_CONCAT_INNER(a, b)
+#define ELITE_PROFILE_SCOPE(name) const Elite::ProfileScope ELITE_PROFILE_CONCAT(eliteProfileScope, __LINE__){ name }
+#define ELITE_PROFILE_THREAD(name) Elite::Profiler::GetInstance()->SetThreadName(name)
+#else
+#define ELITE_PROFILE_SCOPE(name)
+#define ELITE_PROFILE_THREAD(name)
+#endif
+#endif
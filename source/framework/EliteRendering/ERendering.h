@@ -12,7 +12,6 @@ typedef void* EliteRenderingContext;
 
 /* --- INCLUDES --- */
 #include "ERenderingTypes.h"
-#include "EFrameBase.h"
 #include "2DCamera/ECamera2D.h"
 #include "EDebugRenderer2D.h"
 
@@ -20,8 +19,12 @@ typedef void* EliteRenderingContext;
 #if (PLATFORM_ID == PLATFORM_WINDOWS)
 	#include "SDLIntegration/SDLDebugRenderer2D/SDLDebugRenderer2D.h"
 	typedef Elite::SDLDebugRenderer2D EliteDebugRenderer2D;
+	#include "EFrameBase.h" //The frame draws into the window, only the windowed platform has both
 	#include "SDLIntegration/SDLFrame/SDLFrame.h"
 	typedef Elite::SDLFrame EliteFrame;
+#elif (PLATFORM_ID == PLATFORM_HEADLESS)
+	#include "NullIntegration/NullDebugRenderer2D.h"
+	typedef Elite::NullDebugRenderer2D EliteDebugRenderer2D;
 #elif (PLATFORM_ID == PLATFORM_PS4)
 	//Nothing
 #endif
@@ -0,0 +1,50 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================
+NullDebugRenderer2D.h: debug renderer of the headless platform, accepts every draw call and draws nothing.
+=============================================================================*/
+#ifndef ELITE_NULL_RENDERER_2D_H
+#define ELITE_NULL_RENDERER_2D_H
+
+//--- Includes ---
+#include "../EDebugRenderer2D.h"
+#include "../ERenderingTypes.h"
+#include "../../EliteGeometry/EGeometry2DTypes.h"
+
+namespace Elite
+{
+	class NullDebugRenderer2D final : public EDebugRenderer2D<NullDebugRenderer2D>, public ESingleton<NullDebugRenderer2D>
+	{
+	public:
+		//--- Constructor & Destructor ---
+		NullDebugRenderer2D() = default;
+		~NullDebugRenderer2D() = default;
+
+		//--- Functions ---
+		void Initialize(Camera2D* pActiveCamera) { m_pActiveCamera = pActiveCamera; }
+		void Render() {}
+		unsigned int LoadShadersToProgram(const char*, const char*) { return 0; }
+		unsigned int LoadShadersToProgramFromEmbeddedSource(const char*, const char*) { return 0; }
+
+		//--- User Functions ---
+		void DrawPolygon(Elite::Polygon*, const Color&, float) {}
+		void DrawPolygon(Elite::Polygon*, const Color&) {}
+		void DrawPolygon(const Elite::Vector2*, int, const Color&, float) {}
+		void DrawSolidPolygon(Elite::Polygon*, const Color&, float, bool = false) {}
+		void DrawSolidPolygon(const Elite::Polygon*, const Color&, float) {}
+		void DrawSolidPolygon(const Elite::Vector2*, int, const Color&, float, bool = false) {}
+		void DrawCircle(const Elite::Vector2&, float, const Color&, float) {}
+		void DrawSolidCircle(const Elite::Vector2&, float, const Elite::Vector2&, const Color&, float) {}
+		void DrawSolidCircle(const Elite::Vector2&, float, const Elite::Vector2&, const Color&) {}
+		void DrawSegment(const Elite::Vector2&, const Elite::Vector2&, const Color&, float) {}
+		void DrawSegment(const Elite::Vector2&, const Elite::Vector2&, const Color&) {}
+		void DrawDirection(const Elite::Vector2&, const Elite::Vector2&, float, const Color&, float = 0.9f) {}
+		void DrawTransform(const Elite::Vector2&, const Elite::Vector2&, const Elite::Vector2&, float) {}
+		void DrawPoint(const Elite::Vector2&, float, const Color&, float = 0.9f) {}
+		void DrawString(int, int, const char*, ...) const {}
+		void DrawString(const Elite::Vector2&, const char*, ...) const {}
+
+		float NextDepthSlice() { return m_CurrDepthSlice; }
+	};
+}
+#endif
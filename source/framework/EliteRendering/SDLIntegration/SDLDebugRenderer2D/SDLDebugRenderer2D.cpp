@@ -1,5 +1,6 @@
 //Precompiled Header [ALWAYS ON TOP IN CPP]
 #include "stdafx.h"
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 #include "SDLDebugRenderer2D.h"
 using namespace Elite;
 
@@ -60,6 +61,8 @@ void SDLDebugRenderer2D::Initialize(Camera2D* pActiveCamera)
 
 void SDLDebugRenderer2D::Render()
 {
+	ELITE_PROFILE_SCOPE("SDLDebugRenderer2D::Render");
+
 	//Clear color
 	glClear(GL_COLOR_BUFFER_BIT);
 	glClear(GL_DEPTH_BUFFER_BIT);
@@ -638,4 +641,5 @@ unsigned int SDLDebugRenderer2D::LoadShadersToProgramFromEmbeddedSource(const ch
 
 	//IMPORTANT, return our program ID!
 	return programID;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 //=== General Includes ===
 #include "stdafx.h"
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 #include "SDLFrame.h"
 #include "../../ERendering.h"
 #include "../../../EliteUI/EImmediateUI.h"
@@ -54,4 +55,5 @@ void SDLFrame::SubmitAndFlipFrame(EImmediateUI* pImmediateUI)
 
 	//Swap buffers (aka Flip)
 	SDL_GL_SwapWindow(m_pWindow->GetRawWindowHandle());
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
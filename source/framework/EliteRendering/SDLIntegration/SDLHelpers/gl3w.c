@@ -28,6 +28,7 @@
 
 */
 #include "stdafx.h"
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 #include <GL/gl3w.h>
 
 #ifdef _WIN32
@@ -1871,3 +1872,4 @@ static void load_procs(void)
 	gl3wWeightPathsNV = (PFNGLWEIGHTPATHSNVPROC)get_proc("glWeightPathsNV");
 	gl3wWindowRectanglesEXT = (PFNGLWINDOWRECTANGLESEXTPROC)get_proc("glWindowRectanglesEXT");
 }
+#endif
@@ -0,0 +1,115 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EJobSystem.cpp: Engine-wide job system on top of the engine-wide work-stealing ThreadPool (THREADPOOL).
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EJobSystem.h"
+
+namespace Elite
+{
+	struct Job final
+	{
+		std::function<void()> task;
+
+		//Unfinished dependencies, plus one while the job is being scheduled
+		std::atomic<int> nrOfBlockers{ 1 };
+		//Drops to zero once the job ran
+		std::atomic<int> nrOfPending{ 1 };
+
+		std::mutex mutex;
+		bool isFinished = false;
+		std::vector<std::shared_ptr<Job>> dependents;
+	};
+}
+
+bool Elite::JobHandle::IsDone() const
+{
+	return !m_pJob || m_pJob->nrOfPending.load(std::memory_order_acquire) == 0;
+}
+
+Elite::EJobSystem::EJobSystem()
+{
+}
+
+Elite::EJobSystem::~EJobSystem()
+{
+	WaitForFrame();
+}
+
+Elite::JobHandle Elite::EJobSystem::Schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies)
+{
+	auto pJob = std::make_shared<Job>();
+	pJob->task = std::move(job);
+	++m_NrOfFrameJobs;
+
+	//Register with every dependency that isn't done yet, the last one to finish submits the job
+	for (const auto& dependency : dependencies)
+	{
+		if (!dependency.m_pJob)
+			continue;
+
+		std::lock_guard<std::mutex> lock{ dependency.m_pJob->mutex };
+		if (dependency.m_pJob->isFinished)
+			continue;
+
+		++pJob->nrOfBlockers;
+		dependency.m_pJob->dependents.push_back(pJob);
+	}
+
+	if (pJob->nrOfBlockers.fetch_sub(1) == 1)
+		Submit(pJob);
+
+	return JobHandle{ pJob };
+}
+
+Elite::JobHandle Elite::EJobSystem::ScheduleParallelFor(int count, int grainSize, std::function<void(int, int)> func, const std::vector<JobHandle>& dependencies)
+{
+	//The job deals the chunks out and helps running them, so the handle is only done with the last chunk
+	return Schedule([count, grainSize, func]()
+	{
+		THREADPOOL->ParallelFor(count, grainSize, func);
+	}, dependencies);
+}
+
+void Elite::EJobSystem::Wait(const JobHandle& handle)
+{
+	if (handle.m_pJob)
+		THREADPOOL->HelpUntil(handle.m_pJob->nrOfPending);
+}
+
+void Elite::EJobSystem::WaitForFrame()
+{
+	THREADPOOL->HelpUntil(m_NrOfFrameJobs);
+}
+
+void Elite::EJobSystem::Submit(const std::shared_ptr<Job>& pJob)
+{
+	THREADPOOL->Submit([this, pJob]()
+	{
+		{
+			ELITE_PROFILE_SCOPE("Job");
+			pJob->task();
+		}
+		Finish(pJob);
+	});
+}
+
+void Elite::EJobSystem::Finish(const std::shared_ptr<Job>& pJob)
+{
+	std::vector<std::shared_ptr<Job>> dependents{};
+	{
+		std::lock_guard<std::mutex> lock{ pJob->mutex };
+		pJob->isFinished = true;
+		dependents.swap(pJob->dependents);
+	}
+	pJob->nrOfPending.store(0, std::memory_order_release);
+
+	for (const auto& pDependent : dependents)
+	{
+		if (pDependent->nrOfBlockers.fetch_sub(1) == 1)
+			Submit(pDependent);
+	}
+
+	m_NrOfFrameJobs.fetch_sub(1, std::memory_order_release);
+}
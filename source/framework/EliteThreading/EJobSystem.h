@@ -0,0 +1,65 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EJobSystem.h: Engine-wide job system on top of the engine-wide work-stealing ThreadPool (THREADPOOL).
+// Jobs can depend on other jobs: a job is only queued once all of its dependencies finished.
+// Every job scheduled during a frame is finished by the frame fence (WaitForFrame) at the end of the main loop.
+/*=============================================================================*/
+#ifndef ELITE_JOBSYSTEM
+#define	ELITE_JOBSYSTEM
+
+#include "EThreadPool.h"
+
+namespace Elite
+{
+	struct Job;
+
+	// Handle to a scheduled job, to wait on it or to pass it as a dependency of other jobs
+	class JobHandle final
+	{
+	public:
+		JobHandle() = default;
+
+		bool IsValid() const { return m_pJob != nullptr; }
+		bool IsDone() const;
+
+	private:
+		friend class EJobSystem;
+		explicit JobHandle(std::shared_ptr<Job> pJob) : m_pJob(std::move(pJob)) {}
+
+		std::shared_ptr<Job> m_pJob = nullptr;
+	};
+
+	class EJobSystem final : public ESingleton<EJobSystem>
+	{
+	public:
+		//=== Constructors & Destructors ===
+		EJobSystem();
+		~EJobSystem();
+
+		//=== Job Functions ===
+		// Runs job on any thread once every dependency is done
+		JobHandle Schedule(std::function<void()> job, const std::vector<JobHandle>& dependencies = {});
+		// Runs func(begin, end) over [0, count) in chunks of grainSize once every dependency is done, the handle is done when all chunks are
+		JobHandle ScheduleParallelFor(int count, int grainSize, std::function<void(int, int)> func, const std::vector<JobHandle>& dependencies = {});
+		// Blocking parallel for, the calling thread helps until all chunks are done
+		void ParallelFor(int count, int grainSize, const std::function<void(int, int)>& func) { ThreadPool::GetInstance()->ParallelFor(count, grainSize, func); }
+
+		// The waiting thread runs other jobs in the meantime
+		void Wait(const JobHandle& handle);
+		// Frame fence: waits for every job scheduled so far
+		void WaitForFrame();
+
+		unsigned int GetNrOfThreads() const { return ThreadPool::GetInstance()->GetNrOfThreads(); }
+		ThreadPool& GetThreadPool() { return *ThreadPool::GetInstance(); }
+
+	private:
+		//=== Internal Functions ===
+		void Submit(const std::shared_ptr<Job>& pJob);
+		void Finish(const std::shared_ptr<Job>& pJob);
+
+		//=== Datamembers ===
+		std::atomic<int> m_NrOfFrameJobs{ 0 };
+	};
+}
+#endif
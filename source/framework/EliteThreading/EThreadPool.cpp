@@ -0,0 +1,155 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EThreadPool.cpp: Pool of worker threads with work-stealing task queues.
+/*=============================================================================*/
+#include "stdafx.h"
+#include "EThreadPool.h"
+
+namespace
+{
+	thread_local unsigned int tl_ThreadIndex = 0;
+}
+
+Elite::ThreadPool::ThreadPool(unsigned int nrOfThreads)
+{
+	if (nrOfThreads == 0)
+		nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	//Queue 0 belongs to whichever thread calls into the pool
+	for (unsigned int i = 0; i < nrOfThreads; ++i)
+		m_Queues.push_back(std::make_unique<TaskQueue>());
+
+	for (unsigned int i = 1; i < nrOfThreads; ++i)
+		m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+Elite::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		m_IsStopping = true;
+	}
+	m_WakeCondition.notify_all();
+
+	for (auto& worker : m_Workers)
+		worker.join();
+}
+
+unsigned int Elite::ThreadPool::GetCurrentThreadIndex()
+{
+	return tl_ThreadIndex;
+}
+
+void Elite::ThreadPool::Submit(std::function<void()> task)
+{
+	//Spread over the queues, idle threads steal the rest
+	Push(m_NextQueue++ % GetNrOfThreads(), std::move(task));
+	m_WakeCondition.notify_one();
+}
+
+void Elite::ThreadPool::ParallelFor(int count, int grainSize, const std::function<void(int, int)>& func)
+{
+	if (count <= 0)
+		return;
+	grainSize = std::max(1, grainSize);
+
+	const int nrOfChunks = (count + grainSize - 1) / grainSize;
+	if (nrOfChunks == 1 || GetNrOfThreads() == 1)
+	{
+		for (int begin = 0; begin < count; begin += grainSize)
+			func(begin, std::min(count, begin + grainSize));
+		return;
+	}
+
+	//Chunks are dealt round robin, so every thread starts with a share and only steals when it's done early
+	std::atomic<int> nrOfChunksLeft{ nrOfChunks };
+	for (int chunk = 0; chunk < nrOfChunks; ++chunk)
+	{
+		const int begin = chunk * grainSize;
+		const int end = std::min(count, begin + grainSize);
+		Push(chunk % GetNrOfThreads(), [&func, &nrOfChunksLeft, begin, end]()
+		{
+			ELITE_PROFILE_SCOPE("ThreadPool::ParallelFor");
+			func(begin, end);
+			nrOfChunksLeft.fetch_sub(1, std::memory_order_release);
+		});
+	}
+	m_WakeCondition.notify_all();
+
+	HelpUntil(nrOfChunksLeft);
+}
+
+void Elite::ThreadPool::HelpUntil(const std::atomic<int>& counter)
+{
+	const unsigned int index = tl_ThreadIndex < GetNrOfThreads() ? tl_ThreadIndex : 0;
+	while (counter.load(std::memory_order_acquire) > 0)
+	{
+		if (!TryRunTask(index))
+			std::this_thread::yield();
+	}
+}
+
+void Elite::ThreadPool::WorkerLoop(unsigned int index)
+{
+	tl_ThreadIndex = index;
+	ELITE_PROFILE_THREAD("Worker " + std::to_string(index));
+	while (true)
+	{
+		if (TryRunTask(index))
+			continue;
+
+		std::unique_lock<std::mutex> lock{ m_SleepMutex };
+		m_WakeCondition.wait(lock, [this]() { return m_IsStopping || m_NrOfQueuedTasks.load() > 0; });
+		if (m_IsStopping)
+			return;
+	}
+}
+
+bool Elite::ThreadPool::TryRunTask(unsigned int index)
+{
+	std::function<void()> task;
+
+	//Own queue first, newest task...
+	{
+		TaskQueue& queue = *m_Queues[index];
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+	}
+
+	//...then steal the oldest task of another thread
+	for (unsigned int offset = 1; !task && offset < GetNrOfThreads(); ++offset)
+	{
+		TaskQueue& queue = *m_Queues[(index + offset) % GetNrOfThreads()];
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		if (!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		}
+	}
+
+	if (!task)
+		return false;
+
+	--m_NrOfQueuedTasks;
+	task();
+	return true;
+}
+
+void Elite::ThreadPool::Push(unsigned int queueIndex, std::function<void()> task)
+{
+	{
+		TaskQueue& queue = *m_Queues[queueIndex];
+		std::lock_guard<std::mutex> lock{ queue.mutex };
+		queue.tasks.push_back(std::move(task));
+	}
+
+	//Taking the sleep mutex orders the increment with a worker checking the count before it waits
+	std::lock_guard<std::mutex> lock{ m_SleepMutex };
+	++m_NrOfQueuedTasks;
+}
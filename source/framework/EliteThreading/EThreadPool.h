@@ -0,0 +1,72 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// EThreadPool.h: Pool of worker threads with work-stealing task queues.
+// Every thread owns a queue: it takes its own tasks from the back (last in, first out, warm caches) and steals the
+// oldest tasks from the front of the other queues when it runs out. The thread that waits on a ParallelFor helps
+// instead of blocking, so a pool of N threads starts N - 1 workers.
+// THREADPOOL is the engine-wide pool using every hardware thread, other pools (for instance to benchmark a number of
+// threads) can be created next to it.
+/*=============================================================================*/
+#ifndef ELITE_THREADPOOL
+#define	ELITE_THREADPOOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Elite
+{
+	class ThreadPool final : public ESingleton<ThreadPool>
+	{
+	public:
+		// nrOfThreads counts the calling thread, 0 uses every hardware thread
+		explicit ThreadPool(unsigned int nrOfThreads = 0);
+		~ThreadPool();
+
+		unsigned int GetNrOfThreads() const { return static_cast<unsigned int>(m_Queues.size()); }
+
+		// Index of the calling thread: 1 to N - 1 on the workers of a pool, 0 on any other thread.
+		// Lets tasks pick per-thread scratch data without locking.
+		static unsigned int GetCurrentThreadIndex();
+
+		// Queues a task, any thread of the pool may run it
+		void Submit(std::function<void()> task);
+
+		// Runs func(begin, end) for the chunks of grainSize indices that make up [0, count) and returns when all are done.
+		// Which thread runs which chunk differs between runs, the chunks themselves don't.
+		void ParallelFor(int count, int grainSize, const std::function<void(int, int)>& func);
+
+		// Runs queued tasks on the calling thread until the given counter drops to zero
+		void HelpUntil(const std::atomic<int>& counter);
+
+	private:
+		struct TaskQueue final
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		void WorkerLoop(unsigned int index);
+		bool TryRunTask(unsigned int index);
+		void Push(unsigned int queueIndex, std::function<void()> task);
+
+		std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+
+		std::atomic<int> m_NrOfQueuedTasks{ 0 };
+		std::atomic<unsigned int> m_NextQueue{ 0 };
+		std::mutex m_SleepMutex;
+		std::condition_variable m_WakeCondition;
+		bool m_IsStopping = false;
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+	};
+}
+#endif
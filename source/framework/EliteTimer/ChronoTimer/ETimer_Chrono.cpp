@@ -0,0 +1,101 @@
+/*=============================================================================*/
+// Copyright 2021-2022 Elite Engine
+/*=============================================================================*/
+// ETimer_Chrono.cpp: std::chrono implementation of the ETimer, used by the headless platform (no SDL).
+/*=============================================================================*/
+#include "stdafx.h"
+#include "../ETimer.h"
+
+#if (PLATFORM_ID == PLATFORM_HEADLESS)
+namespace
+{
+	long long GetCounter()
+	{
+		return std::chrono::steady_clock::now().time_since_epoch().count();
+	}
+}
+
+template<>
+Elite::ETimer<PLATFORM_HEADLESS>::ETimer()
+{
+	m_SecondsPerCount = (float)std::chrono::steady_clock::period::num / std::chrono::steady_clock::period::den;
+}
+
+template<>
+void Elite::ETimer<PLATFORM_HEADLESS>::Reset()
+{
+	long long currentTime = GetCounter();
+
+	m_BaseTime = currentTime;
+	m_PreviousTime = currentTime;
+	m_StopTime = 0;
+	m_FPSTimer = 0.0f;
+	m_FPSCount = 0;
+	m_IsStopped = false;
+}
+
+template<>
+void Elite::ETimer<PLATFORM_HEADLESS>::Start()
+{
+	long long startTime = GetCounter();
+
+	if (m_IsStopped)
+	{
+		m_PausedTime += (startTime - m_StopTime);
+
+		m_PreviousTime = startTime;
+		m_StopTime = 0;
+		m_IsStopped = false;
+	}
+}
+
+template<>
+void Elite::ETimer<PLATFORM_HEADLESS>::Update()
+{
+	if (m_IsStopped)
+	{
+		m_FPS = 0;
+		m_ElapsedTime = 0.0f;
+		m_TotalTime = (float)(((m_StopTime - m_PausedTime) - m_BaseTime) * m_SecondsPerCount);
+		return;
+	}
+
+	long long currentTime = GetCounter();
+	m_CurrentTime = currentTime;
+
+	m_ElapsedTime = (float)((m_CurrentTime - m_PreviousTime) * m_SecondsPerCount);
+	m_PreviousTime = m_CurrentTime;
+
+	if (m_ElapsedTime < 0.0f)
+		m_ElapsedTime = 0.0f;
+
+	if (m_ForceElapsedUpperBound && m_ElapsedTime > m_ElapsedUpperBound)
+	{
+		m_ElapsedTime = m_ElapsedUpperBound;
+	}
+
+	m_TotalTime = (float)(((m_CurrentTime - m_PausedTime) - m_BaseTime) * m_SecondsPerCount);
+
+	//FPS LOGIC
+	m_FPSTimer += m_ElapsedTime;
+	++m_FPSCount;
+	if (m_FPSTimer >= 1.0f)
+	{
+		m_FPS = m_FPSCount;
+		m_FPSCount = 0;
+		m_FPSTimer -= 1.0f;
+	}
+}
+
+template<>
+void Elite::ETimer<PLATFORM_HEADLESS>::Stop()
+{
+	if (!m_IsStopped)
+	{
+		long long currentTime = GetCounter();
+
+		m_StopTime = currentTime;
+		m_IsStopped = true;
+	}
+}
+#endif
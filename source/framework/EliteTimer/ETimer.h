@@ -58,6 +58,8 @@ namespace Elite
 /* --- PLATFORM-SPECIFIC DEFINES & INCLUDES --- */
 #if (PLATFORM_ID == PLATFORM_WINDOWS)
 	typedef Elite::ETimer<PLATFORM_ID> EliteTimer;
-	#elif (PLATFORM_ID == PLATFORM_PS4)
+#elif (PLATFORM_ID == PLATFORM_HEADLESS)
+	typedef Elite::ETimer<PLATFORM_ID> EliteTimer;
+#elif (PLATFORM_ID == PLATFORM_PS4)
 //Nothing
 #endif
\ No newline at end of file
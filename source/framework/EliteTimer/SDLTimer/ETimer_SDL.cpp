@@ -6,6 +6,7 @@
 // Works on Windows, Mac OS X, Linux, iOS, and Android.
 /*=============================================================================*/
 #include "stdafx.h"
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 #include "../ETimer.h"
 
 template<>
@@ -91,4 +92,5 @@ void Elite::ETimer<PLATFORM_WINDOWS>::Stop()
 		m_StopTime = currentTime;
 		m_IsStopped = true;
 	}
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "stdafx.h"
 #include "EImmediateUI.h"
 
-#ifdef PLATFORM_WINDOWS
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 //Statics
 float Elite::EImmediateUI::m_sMouseWheel = 0.0f;
 bool Elite::EImmediateUI::m_sMousePressed[3] = { false, false, false };
@@ -380,4 +380,34 @@ void Elite::EImmediateUI::SetupStyle()
 	style.Colors[ImGuiCol_TextSelectedBg] = ImVec4(0.25f, 1.00f, 0.00f, 0.43f);
 	style.Colors[ImGuiCol_ModalWindowDarkening] = ImVec4(1.00f, 0.98f, 0.95f, 0.73f);
 }
+#else
+Elite::EImmediateUI::~EImmediateUI()
+{
+	ImGui::Shutdown();
+}
+
+void Elite::EImmediateUI::Initialize(EliteRawWindow pWindow)
+{
+	//No draw lists are rendered, but ImGui needs its font atlas built before the first frame
+	ImGuiIO& io = ImGui::GetIO();
+	io.RenderDrawListsFn = nullptr;
+	io.IniFilename = nullptr;
+
+	unsigned char* pixels;
+	int width, height;
+	io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+}
+
+void Elite::EImmediateUI::Render()
+{
+	ImGui::Render();
+}
+
+void Elite::EImmediateUI::NewFrame(EliteRawWindow pWindow, float deltaTime)
+{
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(static_cast<float>(DEBUGRENDERER2D->GetActiveCamera()->GetWidth()), static_cast<float>(DEBUGRENDERER2D->GetActiveCamera()->GetHeight()));
+	io.DeltaTime = deltaTime > 0.f ? deltaTime : 1.f / 60.f;
+	ImGui::NewFrame();
+}
 #endif
\ No newline at end of file
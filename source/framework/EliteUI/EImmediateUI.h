@@ -11,7 +11,7 @@ struct ImDrawData;
 
 namespace Elite
 {
-#ifdef PLATFORM_WINDOWS
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 	class EImmediateUI final
 	{
 	public:
@@ -47,17 +47,27 @@ namespace Elite
 		EImmediateUI(const EImmediateUI&) = default;
 		EImmediateUI& operator=(const EImmediateUI&) = default;
 	};
-#elif
+#else
+	//Headless: ImGui runs without a renderer, so the UI code of the apps still runs
 	class EImmediateUI final
 	{
 	public:
+		//--- Constructor & Destructor ---
+		EImmediateUI() = default;
+		~EImmediateUI();
+
 		//--- UI Functions ---
-		void Initialize(EliteRawWindow pWindow){};
-		void Render(){};
-		void EventProcessing(){};
-		static void StaticRender(ImDrawData* drawData){};
-		void NewFrame(EliteRawWindow pWindow, float deltaTime){};
+		void Initialize(EliteRawWindow pWindow);
+		void Render();
+		void EventProcessing() {};
+		static void StaticRender(ImDrawData* drawData) {};
+		void NewFrame(EliteRawWindow pWindow, float deltaTime);
 		bool FocussedOnUI() { return false; }
+
+	private:
+		//C++ make the class non-copyable
+		EImmediateUI(const EImmediateUI&) = delete;
+		EImmediateUI& operator=(const EImmediateUI&) = delete;
 	};
 #endif
 }
@@ -1,5 +1,6 @@
 //=== General Includes ===
 #include "stdafx.h"
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 #include "SDLWindow.h"
 using namespace Elite;
 
@@ -149,3 +150,4 @@ void SDLWindow::RequestShutdown()
 	e.type = SDL_QUIT;
 	SDL_PushEvent(&e);
 }
+#endif
\ No newline at end of file
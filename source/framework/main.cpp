@@ -6,17 +6,24 @@
 //-----------------------------------------------------------------
 //Application
 #include "EliteInterfaces/EIApp.h"
-#include "projects/App_Selector.h"
+#include "EliteInterfaces/EAppRegistry.h"
+#if (PLATFORM_ID == PLATFORM_HEADLESS)
+#include "EliteHeadless/EHeadlessRunner.h"
+#endif
 
 //Hotfix for genetic algorithms project
 bool gRequestShutdown = false;
 
+//App started when no --app is given, see EAppRegistry.h for how apps register
+const char* const DefaultAppName = "InfluenceMap";
+
 //Main
 #undef main //Undefine SDL_main as main
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 int main(int argc, char* argv[])
 {
 	int x{}, y{};
-	bool runExeWithCoordinates{ argc == 3 };
+	bool runExeWithCoordinates{ argc == 3 && std::string(argv[1]).compare(0, 2, "--") != 0 };
 
 	if (runExeWithCoordinates)
 	{
@@ -26,6 +33,12 @@ int main(int argc, char* argv[])
 
 	try
 	{
+		//Otherwise "--app <name>" and the parameters for the app, e.g. "--app Flocking --agents 5000"
+		const Elite::AppParameters appParameters{ runExeWithCoordinates ? Elite::AppParameters{} : Elite::AppParameters::FromArguments(argc, argv) };
+		const std::string appName{ appParameters.GetString("app", DefaultAppName) };
+		if (!APPREGISTRY->HasApp(appName))
+			throw Elite_Exception("Unknown app \"" + appName + "\"");
+
 		//Window Creation
 		Elite::WindowParams params;
 		EliteWindow* pWindow = new EliteWindow();
@@ -60,12 +73,21 @@ int main(int argc, char* argv[])
 		//Create Physics
 		PHYSICSWORLD; //Boot
 
+		//Create Profiler before the worker threads that record into it
+		PROFILER; //Boot
+
+		//Create Thread Pool (worker threads)
+		THREADPOOL; //Boot
+
+		//Create Job System (on the thread pool)
+		JOBSYSTEM; //Boot
+
 		//Start Timer
 		TIMER->Start();
 
 		//Application Creation
 		IApp* myApp = nullptr;
-		myApp = App_Selector::CreateApp();
+		myApp = APPREGISTRY->CreateApp(appName, appParameters);
 
 		ELITE_ASSERT(myApp, "Application has not been created.");
 		//Boot application
@@ -74,6 +96,8 @@ int main(int argc, char* argv[])
 		//Application Loop
 		while (!pWindow->ShutdownRequested())
 		{
+			PROFILER->BeginFrame();
+
 			//Timer
 			TIMER->Update();
 			auto const elapsed = TIMER->GetElapsed();
@@ -90,12 +114,27 @@ int main(int argc, char* argv[])
 			//Update (Physics, App)
 			PHYSICSWORLD->Simulate(elapsed);
 			pCamera->Update();
-			myApp->Update(elapsed);
+			{
+				ELITE_PROFILE_SCOPE("IApp::Update");
+				myApp->Update(elapsed);
+			}
 
 			//Render and Present Frame
 			PHYSICSWORLD->RenderDebug();
-			myApp->Render(elapsed);
+			{
+				ELITE_PROFILE_SCOPE("IApp::Render");
+				myApp->Render(elapsed);
+			}
+
+			//Profiler window (F1)
+			if (INPUTMANAGER->IsKeyboardKeyUp(Elite::eScancode_F1))
+				PROFILER->SetWindowVisible(!PROFILER->IsWindowVisible());
+			PROFILER->RenderUI();
 			pFrame->SubmitAndFlipFrame(pImmediateUI);
+
+			//Frame fence, no job outlives the frame it was scheduled in
+			JOBSYSTEM->WaitForFrame();
+			PROFILER->EndFrame();
 		}
 
 		//Reversed Deletion
@@ -106,10 +145,14 @@ int main(int argc, char* argv[])
 		SAFE_DELETE(pWindow);
 
 		//Shutdown All Singletons
+		JOBSYSTEM->Destroy();
+		THREADPOOL->Destroy();
+		PROFILER->Destroy();
 		PHYSICSWORLD->Destroy();
 		DEBUGRENDERER2D->Destroy();
 		INPUTMANAGER->Destroy();
 		TIMER->Destroy();
+		APPREGISTRY->Destroy();
 	}
 	catch (const Elite_Exception& e)
 	{
@@ -122,3 +165,61 @@ int main(int argc, char* argv[])
 
 	return 0;
 }
+#elif (PLATFORM_ID == PLATFORM_HEADLESS)
+int main(int argc, char* argv[])
+{
+	try
+	{
+		const Elite::AppParameters appParameters{ Elite::AppParameters::FromArguments(argc, argv) };
+		Elite::HeadlessParams params{};
+		if (!Elite::HeadlessRunner::ReadParameters(appParameters, params))
+		{
+			std::cout << Elite::HeadlessRunner::GetUsage() << std::endl;
+			return 1;
+		}
+
+		//Create Physics, Profiler, Thread Pool and Job System
+		PHYSICSWORLD; //Boot
+		PROFILER; //Boot
+		THREADPOOL; //Boot
+		JOBSYSTEM; //Boot
+
+		//Start Timer
+		TIMER->Start();
+
+		//Engine benchmarks first, they print their own results
+		Elite::HeadlessRunner::RunBenchmarks(params);
+
+		//Every app brings up its own runner (camera and UI)
+		if (!params.appNames.empty())
+		{
+			const std::string report{ Elite::HeadlessRunner::RunAll(params, appParameters) };
+			if (params.outputPath.empty())
+				std::cout << report;
+			else
+			{
+				std::ofstream file{ params.outputPath };
+				file << report;
+			}
+		}
+
+		//Shutdown All Singletons
+		JOBSYSTEM->Destroy();
+		THREADPOOL->Destroy();
+		PROFILER->Destroy();
+		PHYSICSWORLD->Destroy();
+		DEBUGRENDERER2D->Destroy();
+		INPUTMANAGER->Destroy();
+		TIMER->Destroy();
+		APPREGISTRY->Destroy();
+	}
+	catch (const Elite_Exception& e)
+	{
+		std::cout << e._msg << " Error: " << std::endl;
+		std::cout << Elite::HeadlessRunner::GetUsage() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
+#endif
\ No newline at end of file
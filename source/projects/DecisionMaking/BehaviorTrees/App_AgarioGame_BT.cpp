@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "App_AgarioGame_BT.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 #include "Behaviors.h"
 
 #include "projects/Shared/Agario/AgarioFood.h"
@@ -8,8 +9,52 @@
 #include "projects/Shared/NavigationColliderElement.h"
 
 using namespace Elite;
-App_AgarioGame_BT::App_AgarioGame_BT()
+
+namespace
 {
+	//Spreads the bits of a value over the whole hash, so sums of hashes rarely collide
+	unsigned int MixHash(unsigned int value)
+	{
+		value ^= value >> 16;
+		value *= 0x85ebca6bu;
+		value ^= value >> 13;
+		value *= 0xc2b2ae35u;
+		value ^= value >> 16;
+		return value;
+	}
+
+	unsigned int HashFloat(float value)
+	{
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		return MixHash(bits);
+	}
+
+	//Changes with every bit of the position and radius
+	unsigned int HashCircle(const Elite::Vector2& position, float radius)
+	{
+		return MixHash(MixHash(HashFloat(position.x) ^ HashFloat(position.y) * 31u) ^ HashFloat(radius));
+	}
+
+	//LOD tier of the decision making: every frame close to the focus, less often further away (see AIScheduler)
+	int GetDecisionTier(const Elite::Vector2& position, const Elite::Vector2& focusPos)
+	{
+		const float distanceSquared{ position.DistanceSquared(focusPos) };
+		if (distanceSquared < 50.f * 50.f)
+			return 0;
+		return distanceSquared < 100.f * 100.f ? 1 : 2;
+	}
+}
+REGISTER_APP(App_AgarioGame_BT, "BT")
+
+App_AgarioGame_BT::App_AgarioGame_BT(const AppParameters& params)
+{
+	m_AmountOfAgents = params.GetInt("agents", m_AmountOfAgents);
+	m_AmountOfSmartAgents = params.GetInt("smartAgents", m_AmountOfSmartAgents);
+	m_AmountOfFood = params.GetInt("food", m_AmountOfFood);
+	m_TrimWorldSize = params.GetFloat("worldSize", m_TrimWorldSize);
+	m_IsEventDriven = params.GetBool("eventDriven", m_IsEventDriven);
+	m_AIScheduler.SetBudgetMs(params.GetFloat("aiBudget", m_AIScheduler.GetBudgetMs()));
 }
 
 App_AgarioGame_BT::~App_AgarioGame_BT()
@@ -28,6 +73,7 @@ App_AgarioGame_BT::~App_AgarioGame_BT()
 
 	SAFE_DELETE(m_pContactListener);
 	SAFE_DELETE(m_pSmartAgent);
+	SAFE_DELETE(m_pWorldSnapshot);
 
 	for (auto pNC : m_vNavigationColliders)
 		SAFE_DELETE(pNC);
@@ -59,6 +105,32 @@ void App_AgarioGame_BT::Start()
 		m_pFoodVec.push_back(new AgarioFood(randomPos));
 	}
 
+	//Create the behavior trees, the agents share them and only keep their own blackboard.
+	//The trees of all agents tick as one batch (see UpdateDecisionMaking), not in AgarioAgent::Update.
+	m_pWorldSnapshot = new AgarioWorldSnapshot();
+	const auto pWanderTree = std::make_shared<const FlatBehaviorTree>(BehaviorAction(BT_Actions::ChangeToWander));
+	m_pSmartTree = std::make_shared<const FlatBehaviorTree>(
+		BehaviorSelector(
+		{
+			new BehaviorSequence(
+			{
+				new BehaviorConditional(BT_Conditions::IsBiggerAgentNearby, BT_Keys::Neighborhood),
+				new BehaviorAction(BT_Actions::ChangeToAvadeAgent)
+			}),
+			new BehaviorSequence(
+			{
+				new BehaviorConditional(BT_Conditions::IsSmallerAgentNearby, BT_Keys::Neighborhood),
+				new BehaviorAction(BT_Actions::ChangeToSeekAgent)
+			}),
+			new BehaviorSequence(
+			{
+				new BehaviorConditional(BT_Conditions::IsFoodNearby, BT_Keys::FoodNeighborhood),
+				new BehaviorAction(BT_Actions::ChangeToSeekFood)
+			}),
+			new BehaviorAction(BT_Actions::ChangeToWander)
+		})
+	);
+
 	//Create agents
 	m_pAgentVec.reserve(m_AmountOfAgents);
 	for (int i = 0; i < m_AmountOfAgents; i++)
@@ -67,13 +139,14 @@ void App_AgarioGame_BT::Start()
 		AgarioAgent* newAgent = new AgarioAgent(randomPos);
 
 		//1. Create Blackboard
-		Blackboard* pBlackboard = CreateBlackboard(newAgent);
+		Blackboard* pBlackboard = CreateBlackboard(newAgent, m_pWorldSnapshot);
 
 		//2. Create BehaviorTree
-		BehaviorTree* pBehaviorTree = new BehaviorTree(pBlackboard, new BehaviorAction(BT_Actions::ChangeToWander));
+		BehaviorTreeInstance* pBehaviorTree = new BehaviorTreeInstance(pBlackboard, i < m_AmountOfSmartAgents ? m_pSmartTree : pWanderTree);
 
 		//3. Set the BehaviorTree active on the agent 
 		newAgent->SetDecisionMaking(pBehaviorTree);
+		newAgent->SetAutoUpdateDecisionMaking(false);
 		
 		m_pAgentVec.push_back(newAgent);
 	}
@@ -88,33 +161,14 @@ void App_AgarioGame_BT::Start()
 
 	//Create and add the necessary blackboard data
 	//1. Create Blackboard
-	Blackboard* pBlackboard = CreateBlackboard(m_pSmartAgent);
+	Blackboard* pBlackboard = CreateBlackboard(m_pSmartAgent, m_pWorldSnapshot);
 
 	//2. Create BehaviorTree (make more conditions/actions and create a more advanced tree than the simple agents
-	BehaviorTree* pBehaviorTree = new BehaviorTree(pBlackboard,
-		new BehaviorSelector(
-		{
-			new BehaviorSequence(
-			{
-				new BehaviorConditional(BT_Conditions::IsBiggerAgentNearby),
-				new BehaviorAction(BT_Actions::ChangeToAvadeAgent)
-			}),
-			new BehaviorSequence(
-			{
-				new BehaviorConditional(BT_Conditions::IsSmallerAgentNearby),
-				new BehaviorAction(BT_Actions::ChangeToSeekAgent)
-			}),
-			new BehaviorSequence(
-			{
-				new BehaviorConditional(BT_Conditions::IsFoodNearby),
-				new BehaviorAction(BT_Actions::ChangeToSeekFood)
-			}),
-			new BehaviorAction(BT_Actions::ChangeToWander)
-		})
-	);
+	BehaviorTreeInstance* pBehaviorTree = new BehaviorTreeInstance(pBlackboard, m_pSmartTree);
 
 	//3. Set the BehaviorTree active on the agent 
 	m_pSmartAgent->SetDecisionMaking(pBehaviorTree);
+	m_pSmartAgent->SetAutoUpdateDecisionMaking(false);
 	m_pSmartAgent->SetRenderBehavior(true);
 }
 
@@ -128,6 +182,9 @@ void App_AgarioGame_BT::Update(float deltaTime)
 		m_GameOver = true;
 		return;
 	}
+	//Tick the behavior trees that are due and apply their commands
+	UpdateDecisionMaking(deltaTime);
+
 	//Update the custom agent
 	m_pSmartAgent->Update(deltaTime);
 	
@@ -162,20 +219,289 @@ void App_AgarioGame_BT::Render(float deltaTime) const
 	m_pSmartAgent->Render(deltaTime);
 }
 
-Blackboard* App_AgarioGame_BT::CreateBlackboard(AgarioAgent* a)
+Blackboard* App_AgarioGame_BT::CreateBlackboard(AgarioAgent* a, const AgarioWorldSnapshot* pWorld) const
 {
 	Elite::Blackboard* pBlackboard = new Elite::Blackboard();
-	pBlackboard->AddData("Agent", a);
-	pBlackboard->AddData("AgentsVec", &m_pAgentVec);
-	pBlackboard->AddData("FoodVec", &m_pFoodVec);
-	pBlackboard->AddData("WorldSize", m_TrimWorldSize);
-	pBlackboard->AddData("Target", Elite::Vector2{});
-	pBlackboard->AddData("AgentTarget", static_cast<AgarioAgent*>(nullptr)); // Needs the cast for the type
-	pBlackboard->AddData("Time", 0.0f); 
+	pBlackboard->AddData(BT_Keys::Agent, a);
+	pBlackboard->AddData(BT_Keys::World, pWorld);
+	pBlackboard->AddData(BT_Keys::Self, -1);
+	pBlackboard->AddData(BT_Keys::Command, AgarioCommand{});
+	pBlackboard->AddData(BT_Keys::Neighborhood, 0u);
+	pBlackboard->AddData(BT_Keys::FoodNeighborhood, 0u);
+	pBlackboard->AddData(BT_Keys::WorldSize, m_TrimWorldSize);
+	pBlackboard->AddData(BT_Keys::Target, Elite::Vector2{});
+	pBlackboard->AddData(BT_Keys::FoodTarget, Elite::Vector2{});
+	pBlackboard->AddData(BT_Keys::EvadeTarget, Elite::Vector2{});
+	pBlackboard->AddData(BT_Keys::AgentTarget, nullptr);
+	pBlackboard->AddData(BT_Keys::Time, 0.0f);
 
 	return pBlackboard;
 }
 
+void App_AgarioGame_BT::UpdateDecisionMaking(float deltaTime)
+{
+	//Gather the world the trees read this frame, the smart agent first
+	AgarioWorldSnapshot& world{ *m_pWorldSnapshot };
+	world.agents.clear();
+	world.foodPositions.clear();
+	m_pBlackboards.clear();
+	m_AIScheduler.Clear();
+
+	//The agents around the smart agent decide every frame, the ones further away less often
+	const Elite::Vector2 focusPos{ m_pSmartAgent->GetPosition() };
+	const auto gatherAgent = [this, &world, &focusPos](AgarioAgent* pAgent)
+	{
+		BehaviorTreeInstance* pBehaviorTree = static_cast<BehaviorTreeInstance*>(pAgent->GetDecisionMaking());
+		pBehaviorTree->SetEventDriven(m_IsEventDriven);
+		pBehaviorTree->GetBlackboard()->ChangeData(BT_Keys::Self, static_cast<int>(world.agents.size()));
+		pBehaviorTree->GetBlackboard()->ChangeData(BT_Keys::Command, AgarioCommand{});
+		world.agents.push_back({ pAgent->GetPosition(), pAgent->GetRadius(), pAgent });
+		m_pBlackboards.push_back(pBehaviorTree->GetBlackboard());
+		m_AIScheduler.Add(pBehaviorTree, GetDecisionTier(pAgent->GetPosition(), focusPos));
+	};
+
+	gatherAgent(m_pSmartAgent);
+	for (AgarioAgent* pAgent : m_pAgentVec)
+		gatherAgent(pAgent);
+	for (AgarioFood* pFood : m_pFoodVec)
+		world.foodPositions.push_back(pFood->GetPosition());
+
+	if (m_IsEventDriven)
+		UpdateNeighborhoods(world, m_TrimWorldSize, m_pBlackboards);
+
+	//Tick the due trees at once, then apply their commands here: the steering setters aren't thread-safe.
+	//Agents that didn't tick have no command and keep steering the way their last tick set.
+	m_BehaviorTreeBatch.Clear();
+	for (const AIScheduler::ScheduledTick& tick : m_AIScheduler.Schedule(deltaTime))
+		m_BehaviorTreeBatch.Add(static_cast<BehaviorTreeInstance*>(tick.pDecisionMaking));
+	m_BehaviorTreeBatch.Tick();
+	m_AIScheduler.EndFrame(m_BehaviorTreeBatch.GetLastTickMs());
+
+	for (const AgarioAgentSnapshot& agent : world.agents)
+		ApplyCommand(agent.pAgent);
+}
+
+void App_AgarioGame_BT::UpdateNeighborhoods(AgarioWorldSnapshot& world, float worldSize, const std::vector<Blackboard*>& pBlackboards)
+{
+	//The hash of a cell changes when an agent or food in it moves, grows, enters or leaves it.
+	//The neighborhoods of an agent hash its own position and radius with the cells within reach of its conditions,
+	//so they change whenever anything the conditions read changes: a cached condition has the result a full tick would have.
+	const int nrOfColumns{ static_cast<int>(worldSize / world.cellSize) + 1 };
+	world.nrOfColumns = nrOfColumns;
+	world.agentCellHashes.assign(nrOfColumns * nrOfColumns, 0);
+	world.foodCellHashes.assign(nrOfColumns * nrOfColumns, 0);
+
+	const auto getColumn = [&world, nrOfColumns](float position)
+	{
+		return Clamp(static_cast<int>(position / world.cellSize), 0, nrOfColumns - 1);
+	};
+
+	float maxAgentRadius{ 0.f };
+	for (const AgarioAgentSnapshot& agent : world.agents)
+	{
+		const unsigned int agentHash{ MixHash(static_cast<unsigned int>(reinterpret_cast<uintptr_t>(agent.pAgent))) ^ HashCircle(agent.position, agent.radius) };
+		world.agentCellHashes[getColumn(agent.position.y) * nrOfColumns + getColumn(agent.position.x)] += agentHash;
+		maxAgentRadius = std::max(maxAgentRadius, agent.radius);
+	}
+	for (const Elite::Vector2& foodPos : world.foodPositions)
+		world.foodCellHashes[getColumn(foodPos.y) * nrOfColumns + getColumn(foodPos.x)] += HashCircle(foodPos, 0.f);
+
+	for (size_t agentIdx{ 0 }; agentIdx < world.agents.size(); ++agentIdx)
+	{
+		const AgarioAgentSnapshot& agent{ world.agents[agentIdx] };
+
+		//Search radius of IsSmallerAgentNearby, the largest. The conditions subtract the radius of the other agent from its distance,
+		//so they reach the centers of agents up to the largest radius further.
+		const float range{ agent.radius + 30.f + maxAgentRadius };
+		const unsigned int selfHash{ HashCircle(agent.position, agent.radius) };
+		unsigned int neighborhood{ selfHash };
+		unsigned int foodNeighborhood{ selfHash };
+		for (int row{ getColumn(agent.position.y - range) }; row <= getColumn(agent.position.y + range); ++row)
+		{
+			for (int col{ getColumn(agent.position.x - range) }; col <= getColumn(agent.position.x + range); ++col)
+			{
+				const unsigned int cellIdx{ static_cast<unsigned int>(row * nrOfColumns + col) };
+				neighborhood += MixHash(cellIdx ^ world.agentCellHashes[cellIdx]);
+				foodNeighborhood += MixHash(cellIdx ^ world.foodCellHashes[cellIdx]);
+			}
+		}
+
+		pBlackboards[agentIdx]->ChangeData(BT_Keys::Neighborhood, neighborhood);
+		pBlackboards[agentIdx]->ChangeData(BT_Keys::FoodNeighborhood, foodNeighborhood);
+	}
+}
+
+void App_AgarioGame_BT::ApplyCommand(AgarioAgent* pAgent) const
+{
+	const Blackboard* pBlackboard = static_cast<BehaviorTreeInstance*>(pAgent->GetDecisionMaking())->GetBlackboard();
+
+	AgarioCommand command{};
+	pBlackboard->GetData(BT_Keys::Command, command);
+	switch (command.type)
+	{
+	case AgarioCommand::Type::Wander:
+		pAgent->SetToWander();
+		break;
+	case AgarioCommand::Type::Seek:
+		pAgent->SetToSeek(command.target);
+		break;
+	case AgarioCommand::Type::Flee:
+		pAgent->SetToFlee(command.target, command.radius);
+		break;
+	case AgarioCommand::Type::Pursuit:
+		pAgent->SetToPursuit(command.pTargetAgent);
+		break;
+	default:
+		//No command, keep the current steering
+		break;
+	}
+
+	//Search radii of the conditions, the trees can't draw from the worker threads
+	if (pAgent->CanRenderBehavior())
+	{
+		const Elite::Vector2 agentPos{ pAgent->GetPosition() };
+		const float agentRadius{ pAgent->GetRadius() };
+		DEBUGRENDERER2D->DrawCircle(agentPos, agentRadius + 25.f, Elite::Color{ 1.f, 0.f, 0.f }, DEBUGRENDERER2D->NextDepthSlice());
+		DEBUGRENDERER2D->DrawCircle(agentPos, agentRadius + 30.f, Elite::Color{ 0.f, 0.f, 1.f }, DEBUGRENDERER2D->NextDepthSlice());
+		DEBUGRENDERER2D->DrawCircle(agentPos, agentRadius + 20.f, Elite::Color{ 0.f, 1.f, 0.f }, DEBUGRENDERER2D->NextDepthSlice());
+	}
+}
+
+void App_AgarioGame_BT::RunBenchmark() const
+{
+	//Every agent runs the tree of the smart agent, at the agent and food density of the game
+	for (const int nrOfAgents : { 1000, 10000 })
+	{
+		//The conditions scan all agents, fewer ticks for the larger batch
+		const int nrOfTicks{ std::max(20000 / nrOfAgents, 2) };
+		const float density{ static_cast<float>(nrOfAgents) / std::max(m_AmountOfAgents, 1) };
+		const float worldSize{ m_TrimWorldSize * sqrtf(density) };
+
+		AgarioWorldSnapshot world{};
+		std::mt19937 randomEngine{ 1 };
+		std::uniform_real_distribution<float> randomPosition{ 0.f, worldSize };
+		std::uniform_real_distribution<float> randomRadius{ 1.f, 10.f };
+		for (int i{ 0 }; i < nrOfAgents; ++i)
+			world.agents.push_back({ { randomPosition(randomEngine), randomPosition(randomEngine) }, randomRadius(randomEngine), nullptr });
+		for (int i{ 0 }; i < static_cast<int>(m_AmountOfFood * density); ++i)
+			world.foodPositions.push_back({ randomPosition(randomEngine), randomPosition(randomEngine) });
+
+		std::vector<std::unique_ptr<BehaviorTreeInstance>> pInstances{};
+		BehaviorTreeBatch batch{ m_BehaviorTreeBatch.GetGrainSize() };
+		for (int i{ 0 }; i < nrOfAgents; ++i)
+		{
+			Blackboard* pBlackboard = CreateBlackboard(nullptr, &world);
+			pBlackboard->ChangeData(BT_Keys::Self, i);
+			pInstances.push_back(std::make_unique<BehaviorTreeInstance>(pBlackboard, m_pSmartTree));
+			batch.Add(pInstances.back().get());
+		}
+
+		float tickMs[2]{};
+		for (int isMultithreaded{ 0 }; isMultithreaded < 2; ++isMultithreaded)
+		{
+			batch.SetMultithreaded(isMultithreaded != 0);
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (int tick{ 0 }; tick < nrOfTicks; ++tick)
+				batch.Tick();
+			tickMs[isMultithreaded] = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfTicks;
+		}
+
+		//Event-driven in a world that stands still: after the first tick every condition is cached
+		for (const auto& pInstance : pInstances)
+			pInstance->SetEventDriven(true);
+		batch.Tick();
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int tick{ 0 }; tick < nrOfTicks; ++tick)
+			batch.Tick();
+		const float eventDrivenMs{ std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfTicks };
+
+		//Time-sliced within the budget of the game, the LOD tiers around the center of the world
+		for (const auto& pInstance : pInstances)
+			pInstance->SetEventDriven(false);
+		AIScheduler scheduler{ m_AIScheduler.GetBudgetMs(), m_AIScheduler.GetTierIntervals() };
+		const Elite::Vector2 centerPos{ worldSize * .5f, worldSize * .5f };
+		const int nrOfFrames{ 60 };
+		int nrOfTimeSlicedTicks{ 0 };
+		const auto timeSlicedStart = std::chrono::high_resolution_clock::now();
+		for (int frame{ 0 }; frame < nrOfFrames; ++frame)
+		{
+			scheduler.Clear();
+			for (int i{ 0 }; i < nrOfAgents; ++i)
+				scheduler.Add(pInstances[i].get(), GetDecisionTier(world.agents[i].position, centerPos));
+
+			batch.Clear();
+			for (const AIScheduler::ScheduledTick& tick : scheduler.Schedule(1.f / 60.f))
+				batch.Add(static_cast<BehaviorTreeInstance*>(tick.pDecisionMaking));
+			batch.Tick();
+			scheduler.EndFrame(batch.GetLastTickMs());
+			nrOfTimeSlicedTicks += scheduler.GetStats().nrOfTicked;
+		}
+		const float timeSlicedMs{ std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - timeSlicedStart).count() / nrOfFrames };
+
+		//Event-driven against full ticks in a world that moves: fresh trees for both, the same world every frame
+		std::vector<std::unique_ptr<BehaviorTreeInstance>> pFullInstances{}, pEventInstances{};
+		std::vector<Blackboard*> pEventBlackboards{};
+		BehaviorTreeBatch fullBatch{ m_BehaviorTreeBatch.GetGrainSize() }, eventBatch{ m_BehaviorTreeBatch.GetGrainSize() };
+		for (int i{ 0 }; i < nrOfAgents; ++i)
+		{
+			for (auto* pCopies : { &pFullInstances, &pEventInstances })
+			{
+				Blackboard* pBlackboard = CreateBlackboard(nullptr, &world);
+				pBlackboard->ChangeData(BT_Keys::Self, i);
+				pCopies->push_back(std::make_unique<BehaviorTreeInstance>(pBlackboard, m_pSmartTree));
+			}
+			pEventInstances.back()->SetEventDriven(true);
+			pEventBlackboards.push_back(pEventInstances.back()->GetBlackboard());
+			fullBatch.Add(pFullInstances.back().get());
+			eventBatch.Add(pEventInstances.back().get());
+		}
+
+		std::uniform_real_distribution<float> randomStep{ -.5f, .5f };
+		float movingTickMs[2]{};
+		int nrOfDifferentTypes{ 0 }, nrOfDifferentTargets{ 0 };
+		for (int tick{ 0 }; tick < nrOfTicks; ++tick)
+		{
+			for (AgarioAgentSnapshot& agent : world.agents)
+			{
+				agent.position.x = Clamp(agent.position.x + randomStep(randomEngine), 0.f, worldSize);
+				agent.position.y = Clamp(agent.position.y + randomStep(randomEngine), 0.f, worldSize);
+			}
+			UpdateNeighborhoods(world, worldSize, pEventBlackboards);
+
+			BehaviorTreeBatch* const pBatches[2]{ &fullBatch, &eventBatch };
+			for (int batchIdx{ 0 }; batchIdx < 2; ++batchIdx)
+			{
+				for (const auto& pInstance : (batchIdx == 0 ? pFullInstances : pEventInstances))
+					pInstance->GetBlackboard()->ChangeData(BT_Keys::Command, AgarioCommand{});
+				pBatches[batchIdx]->Tick();
+				movingTickMs[batchIdx] += pBatches[batchIdx]->GetLastTickMs() / nrOfTicks;
+			}
+
+			for (int i{ 0 }; i < nrOfAgents; ++i)
+			{
+				AgarioCommand fullCommand{}, eventCommand{};
+				pFullInstances[i]->GetBlackboard()->GetData(BT_Keys::Command, fullCommand);
+				pEventInstances[i]->GetBlackboard()->GetData(BT_Keys::Command, eventCommand);
+				if (fullCommand.type != eventCommand.type)
+					++nrOfDifferentTypes;
+				else if (fullCommand.target != eventCommand.target || fullCommand.radius != eventCommand.radius || fullCommand.pTargetAgent != eventCommand.pTargetAgent)
+					++nrOfDifferentTargets;
+			}
+		}
+
+		std::cout << "[BT Benchmark] " << nrOfAgents << " agents: " << tickMs[0] << " ms/tick on 1 thread, "
+			<< tickMs[1] << " ms/tick on " << JOBSYSTEM->GetNrOfThreads() << " threads, "
+			<< eventDrivenMs << " ms/tick event-driven without changes" << std::endl;
+		std::cout << "[BT Benchmark] " << nrOfAgents << " agents time-sliced in " << scheduler.GetBudgetMs() << " ms: "
+			<< timeSlicedMs << " ms/frame, " << nrOfTimeSlicedTicks / nrOfFrames << " trees/frame, "
+			<< scheduler.GetNrOfOverBudgetFrames() << "/" << nrOfFrames << " frames over budget" << std::endl;
+		std::cout << "[BT Benchmark] " << nrOfAgents << " agents moving for " << nrOfTicks << " ticks: " << movingTickMs[0] << " ms/tick full, "
+			<< movingTickMs[1] << " ms/tick event-driven, of " << nrOfAgents * nrOfTicks << " commands " << nrOfDifferentTypes
+			<< " differ from the full tick in type, " << nrOfDifferentTargets << " only in target" << std::endl;
+		assert(nrOfDifferentTypes == 0 && nrOfDifferentTargets == 0 && "<App_AgarioGame_BT::RunBenchmark>: event-driven trees have to give the commands of full ticks");
+	}
+}
+
 void App_AgarioGame_BT::UpdateImGui()
 {
 	//------- UI --------
@@ -196,6 +522,18 @@ void App_AgarioGame_BT::UpdateImGui()
 		//Elements
 		ImGui::Text("CONTROLS");
 		ImGui::Indent();
+		bool isMultithreaded{ m_BehaviorTreeBatch.IsMultithreaded() };
+		if (ImGui::Checkbox("Multithreaded", &isMultithreaded))
+			m_BehaviorTreeBatch.SetMultithreaded(isMultithreaded);
+		ImGui::Checkbox("Event-driven", &m_IsEventDriven);
+		bool isTimeSliced{ m_AIScheduler.IsEnabled() };
+		if (ImGui::Checkbox("Time-sliced", &isTimeSliced))
+			m_AIScheduler.SetEnabled(isTimeSliced);
+		float budgetMs{ m_AIScheduler.GetBudgetMs() };
+		if (ImGui::SliderFloat("Budget", &budgetMs, 0.1f, 10.f, "%.1f ms"))
+			m_AIScheduler.SetBudgetMs(budgetMs);
+		if (ImGui::Button("Run Benchmark"))
+			RunBenchmark();
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -207,6 +545,11 @@ void App_AgarioGame_BT::UpdateImGui()
 		ImGui::Indent();
 		ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 		ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+		ImGui::Text("%.3f ms AI", m_BehaviorTreeBatch.GetLastTickMs());
+		const AISchedulerStats& aiStats{ m_AIScheduler.GetStats() };
+		ImGui::Text("%d/%d trees ticked", aiStats.nrOfTicked, aiStats.nrOfAgents);
+		ImGui::Text("%d deferred", aiStats.nrOfDeferred);
+		ImGui::Text("%d/%d over budget", m_AIScheduler.GetNrOfOverBudgetFrames(), m_AIScheduler.GetNrOfFrames());
 		ImGui::Unindent();
 
 		ImGui::Spacing();
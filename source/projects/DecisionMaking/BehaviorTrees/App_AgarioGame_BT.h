@@ -1,19 +1,25 @@
-#ifndef AGARIO_GAME_APPLICATION_H
-#define AGARIO_GAME_APPLICATION_H
+#ifndef AGARIO_GAME_BT_APPLICATION_H
+#define AGARIO_GAME_BT_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "framework/EliteInterfaces/EAppParameters.h"
 
 class AgarioFood;
 class AgarioAgent;
 class AgarioContactListener;
 class NavigationColliderElement;
+struct AgarioWorldSnapshot;
 
 class App_AgarioGame_BT final : public IApp
 {
 public:
-	App_AgarioGame_BT();
+	//Parameters: agents, food, worldSize, smartAgents (agents running the tree of the smart agent), eventDriven, aiBudget (ms)
+	//eventDriven ticks the trees with FlatBehaviorTree::TickEventDriven: the conditions only run again when the agent itself or
+	//an agent or food within their reach moves, grows, appears or disappears. The commands are the ones of the full tree,
+	//RunBenchmark asserts it. Conditions of agents in a part of the world that stands still are skipped.
+	explicit App_AgarioGame_BT(const Elite::AppParameters& params);
 	~App_AgarioGame_BT();
 
 	void Start() override;
@@ -21,12 +27,21 @@ public:
 	void Render(float deltaTime) const override;
 private:
 	float m_TrimWorldSize = 150.f;
-	const int m_AmountOfAgents{ 20 };
+	int m_AmountOfAgents{ 20 };
+	int m_AmountOfSmartAgents{ 0 };
 	std::vector<AgarioAgent*> m_pAgentVec{};
 
 	AgarioAgent* m_pSmartAgent = nullptr;
+	std::shared_ptr<const Elite::FlatBehaviorTree> m_pSmartTree = nullptr;
 
-	const int m_AmountOfFood{ 40 };
+	//--Decision Making--
+	AgarioWorldSnapshot* m_pWorldSnapshot = nullptr;
+	Elite::BehaviorTreeBatch m_BehaviorTreeBatch{};
+	Elite::AIScheduler m_AIScheduler{};
+	bool m_IsEventDriven = false;
+	std::vector<Elite::Blackboard*> m_pBlackboards{}; //Per agent of the world snapshot
+
+	int m_AmountOfFood{ 40 };
 	const float m_FoodSpawnDelay{ 2.f };
 	float m_TimeSinceLastFoodSpawn{ 0.f };
 	std::vector<AgarioFood*> m_pFoodVec{};
@@ -40,8 +55,12 @@ private:
 	template<class T_AgarioType>
 	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime);
 
-	Elite::Blackboard* CreateBlackboard(AgarioAgent* a);
+	Elite::Blackboard* CreateBlackboard(AgarioAgent* a, const AgarioWorldSnapshot* pWorld) const;
+	void UpdateDecisionMaking(float deltaTime);
+	static void UpdateNeighborhoods(AgarioWorldSnapshot& world, float worldSize, const std::vector<Elite::Blackboard*>& pBlackboards);
+	void ApplyCommand(AgarioAgent* pAgent) const;
 	void UpdateImGui();
+	void RunBenchmark() const;
 private:
 	//C++ make the class non-copyable
 	App_AgarioGame_BT(const App_AgarioGame_BT&) {};
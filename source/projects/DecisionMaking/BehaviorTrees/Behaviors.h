@@ -14,6 +14,85 @@
 #include "projects/Shared/Agario/AgarioFood.h"
 #include "projects/Movement/SteeringBehaviors/Steering/SteeringBehaviors.h"
 
+//-----------------------------------------------------------------
+// World Snapshot & Commands
+//-----------------------------------------------------------------
+//The trees tick in parallel: conditions only read the snapshot of the frame, actions only write a command to their own blackboard.
+//The app applies the commands to the agents afterwards, on the main thread.
+struct AgarioAgentSnapshot
+{
+	Elite::Vector2 position;
+	float radius;
+	AgarioAgent* pAgent;
+};
+
+struct AgarioWorldSnapshot
+{
+	std::vector<AgarioAgentSnapshot> agents;
+	std::vector<Elite::Vector2> foodPositions;
+
+	//Event-driven trees: hash of the positions and sizes in each cell of a grid over the world (see App_AgarioGame_BT::UpdateNeighborhoods)
+	float cellSize = 10.f;
+	int nrOfColumns = 0;
+	std::vector<unsigned int> agentCellHashes;
+	std::vector<unsigned int> foodCellHashes;
+};
+
+struct AgarioCommand
+{
+	enum class Type { None, Wander, Seek, Flee, Pursuit };
+
+	Type type = Type::None;
+	Elite::Vector2 target = {};
+	float radius = 0.f;
+	AgarioAgent* pTargetAgent = nullptr;
+
+	bool operator==(const AgarioCommand& other) const
+	{
+		return type == other.type && target == other.target && radius == other.radius && pTargetAgent == other.pTargetAgent;
+	}
+};
+
+//-----------------------------------------------------------------
+// Blackboard Keys
+//-----------------------------------------------------------------
+
+namespace BT_Keys
+{
+	const Elite::BlackboardKey<AgarioAgent*> Agent{ "Agent" };
+	const Elite::BlackboardKey<const AgarioWorldSnapshot*> World{ "World" };
+	//Index of the agent in the snapshot, set every frame
+	const Elite::BlackboardKey<int> Self{ "Self" };
+	const Elite::BlackboardKey<AgarioCommand> Command{ "Command" };
+	//Change when anything the conditions read changes (the agent, agents or food within reach), observed by event-driven trees
+	const Elite::BlackboardKey<unsigned int> Neighborhood{ "Neighborhood" };
+	const Elite::BlackboardKey<unsigned int> FoodNeighborhood{ "FoodNeighborhood" };
+	const Elite::BlackboardKey<float> WorldSize{ "WorldSize" };
+	//Every condition writes its own target, so a cached condition still has the target it found
+	const Elite::BlackboardKey<Elite::Vector2> Target{ "Target" };
+	const Elite::BlackboardKey<Elite::Vector2> FoodTarget{ "FoodTarget" };
+	const Elite::BlackboardKey<Elite::Vector2> EvadeTarget{ "EvadeTarget" };
+	const Elite::BlackboardKey<AgarioAgent*> AgentTarget{ "AgentTarget" };
+	const Elite::BlackboardKey<float> Time{ "Time" };
+}
+
+namespace BT_Helpers
+{
+	const AgarioAgentSnapshot* GetSelf(Elite::Blackboard* pBlackboard, const AgarioWorldSnapshot*& pWorld)
+	{
+		int selfIdx;
+		if (!pBlackboard->GetData(BT_Keys::World, pWorld) || pWorld == nullptr) return nullptr;
+		if (!pBlackboard->GetData(BT_Keys::Self, selfIdx) || selfIdx < 0 || selfIdx >= static_cast<int>(pWorld->agents.size())) return nullptr;
+
+		return &pWorld->agents[selfIdx];
+	}
+
+	bool SetCommand(Elite::Blackboard* pBlackboard, const AgarioCommand& command)
+	{
+		return pBlackboard->ChangeData(BT_Keys::Command, command);
+	}
+}
+
 //-----------------------------------------------------------------
 // Behaviors
 //-----------------------------------------------------------------
@@ -22,58 +101,69 @@ namespace BT_Actions
 {
 	Elite::BehaviorState ChangeToWander(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return Elite::BehaviorState::Failure;
+		AgarioCommand command{};
+		command.type = AgarioCommand::Type::Wander;
+		if (!BT_Helpers::SetCommand(pBlackboard, command)) return Elite::BehaviorState::Failure;
 
-		pAgent->SetToWander();
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState ChangeToSeekFood(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return Elite::BehaviorState::Failure;
-
 		Elite::Vector2 targetPos;
-		if (!pBlackboard->GetData("Target", targetPos)) return Elite::BehaviorState::Failure;
+		if (!pBlackboard->GetData(BT_Keys::FoodTarget, targetPos)) return Elite::BehaviorState::Failure;
+
+		AgarioCommand command{};
+		command.type = AgarioCommand::Type::Seek;
+		command.target = targetPos;
+		if (!BT_Helpers::SetCommand(pBlackboard, command)) return Elite::BehaviorState::Failure;
 
-		pAgent->SetToSeek(targetPos);
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState ChangeToAvadeAgent(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return Elite::BehaviorState::Failure;
+		const AgarioWorldSnapshot* pWorld;
+		const AgarioAgentSnapshot* pSelf{ BT_Helpers::GetSelf(pBlackboard, pWorld) };
+		if (pSelf == nullptr) return Elite::BehaviorState::Failure;
+
+		Elite::Vector2 evadePos;
+		if (!pBlackboard->GetData(BT_Keys::EvadeTarget, evadePos)) return Elite::BehaviorState::Failure;
 
-		AgarioAgent* pEvadeAgent;
-		if (!pBlackboard->GetData("AgentTarget", pEvadeAgent) || pEvadeAgent == nullptr) return Elite::BehaviorState::Failure;
+		AgarioCommand command{};
+		command.type = AgarioCommand::Type::Flee;
+		command.target = evadePos;
+		command.radius = pSelf->radius + 25.f;
+		if (!BT_Helpers::SetCommand(pBlackboard, command)) return Elite::BehaviorState::Failure;
 
-		pAgent->SetToFlee(pEvadeAgent->GetPosition(), pAgent->GetRadius() + 25.f);
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState ChangeToSeekAgent(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return Elite::BehaviorState::Failure;
-
 		Elite::Vector2 targetPos;
-		if (!pBlackboard->GetData("Target", targetPos)) return Elite::BehaviorState::Failure;
+		if (!pBlackboard->GetData(BT_Keys::Target, targetPos)) return Elite::BehaviorState::Failure;
+
+		AgarioCommand command{};
+		command.type = AgarioCommand::Type::Seek;
+		command.target = targetPos;
+		if (!BT_Helpers::SetCommand(pBlackboard, command)) return Elite::BehaviorState::Failure;
 
-		pAgent->SetToSeek(targetPos);
 		return Elite::BehaviorState::Success;
 	}
 
 	Elite::BehaviorState ChangeToPursuitAgent(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return Elite::BehaviorState::Failure;
-
 		AgarioAgent* pTargetAgent;
-		if (!pBlackboard->GetData("AgentTarget", pTargetAgent) || pTargetAgent == nullptr) return Elite::BehaviorState::Failure;
+		if (!pBlackboard->GetData(BT_Keys::AgentTarget, pTargetAgent) || pTargetAgent == nullptr) return Elite::BehaviorState::Failure;
 
-		pAgent->SetToPursuit(pTargetAgent);
+		//The target is only read when the command is applied, on the main thread
+		AgarioCommand command{};
+		command.type = AgarioCommand::Type::Pursuit;
+		command.pTargetAgent = pTargetAgent;
+		if (!BT_Helpers::SetCommand(pBlackboard, command)) return Elite::BehaviorState::Failure;
+
+		return Elite::BehaviorState::Success;
 	}
 }
 
@@ -86,33 +176,29 @@ namespace BT_Conditions
 {
 	bool IsFoodNearby(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return false;
+		const AgarioWorldSnapshot* pWorld;
+		const AgarioAgentSnapshot* pSelf{ BT_Helpers::GetSelf(pBlackboard, pWorld) };
+		if (pSelf == nullptr || pWorld->foodPositions.empty()) return false;
 
-		std::vector<AgarioFood*>* pFoodVec;
-		if (!pBlackboard->GetData("FoodVec", pFoodVec) || pFoodVec == nullptr || pFoodVec->empty()) return false;
-
-		const float searchRadius{ pAgent->GetRadius() + 20.f };
+		const float searchRadius{ pSelf->radius + 20.f };
 		float closestDistSqr{ searchRadius * searchRadius };
-		AgarioFood* pClosestFood{ nullptr };
-		Elite::Vector2 agentPos{ pAgent->GetPosition() };
-
-		DEBUGRENDERER2D->DrawCircle(agentPos, searchRadius, Elite::Color{ 0.f, 1.f, 0.f }, DEBUGRENDERER2D->NextDepthSlice());
+		const Elite::Vector2* pClosestFood{ nullptr };
+		const Elite::Vector2 agentPos{ pSelf->position };
 
-		for (auto& pFood : *pFoodVec)
+		for (const Elite::Vector2& foodPos : pWorld->foodPositions)
 		{
-			float distSqr{ pFood->GetPosition().DistanceSquared(agentPos) };
+			float distSqr{ foodPos.DistanceSquared(agentPos) };
 
 			if (distSqr < closestDistSqr)
 			{
 				closestDistSqr = distSqr;
-				pClosestFood = pFood;
+				pClosestFood = &foodPos;
 			}
 		}
 
 		if (pClosestFood != nullptr) 
 		{
-			pBlackboard->ChangeData("Target", pClosestFood->GetPosition());
+			pBlackboard->ChangeData(BT_Keys::FoodTarget, *pClosestFood);
 			return true;
 		}
 
@@ -121,35 +207,31 @@ namespace BT_Conditions
 	
 	bool IsBiggerAgentNearby(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return false;
-		
-		std::vector<AgarioAgent*>* pOtherAgents;
-		if (!pBlackboard->GetData("AgentsVec", pOtherAgents) || pOtherAgents == nullptr || pOtherAgents->empty()) return false;
+		const AgarioWorldSnapshot* pWorld;
+		const AgarioAgentSnapshot* pSelf{ BT_Helpers::GetSelf(pBlackboard, pWorld) };
+		if (pSelf == nullptr) return false;
 
-		const float fleeRadius{ pAgent->GetRadius() + 25.f };
+		const float fleeRadius{ pSelf->radius + 25.f };
 		float closestDistSqr{ fleeRadius * fleeRadius };
-		AgarioAgent* pClosestAgent{ nullptr };
-		Elite::Vector2 agentPos{ pAgent->GetPosition() };
-
-		DEBUGRENDERER2D->DrawCircle(agentPos, fleeRadius, Elite::Color{ 1.f, 0.f, 0.f }, DEBUGRENDERER2D->NextDepthSlice());
+		const AgarioAgentSnapshot* pClosestAgent{ nullptr };
+		const Elite::Vector2 agentPos{ pSelf->position };
 
-		for (auto& pOtherAgent : *pOtherAgents)
+		for (const AgarioAgentSnapshot& other : pWorld->agents)
 		{
-			if (pOtherAgent->GetRadius() <= pAgent->GetRadius() + 1) continue;
+			if (other.radius <= pSelf->radius + 1) continue;
 
-			float distSqr{ pOtherAgent->GetPosition().DistanceSquared(agentPos) - pOtherAgent->GetRadius() * pOtherAgent->GetRadius() };
+			float distSqr{ other.position.DistanceSquared(agentPos) - other.radius * other.radius };
 
 			if (distSqr < closestDistSqr)
 			{
 				closestDistSqr = distSqr;
-				pClosestAgent = pOtherAgent;
+				pClosestAgent = &other;
 			}	
 		}
 
 		if (pClosestAgent != nullptr)
 		{
-			pBlackboard->ChangeData("AgentTarget", pClosestAgent);
+			pBlackboard->ChangeData(BT_Keys::EvadeTarget, pClosestAgent->position);
 			return true;
 		}
 
@@ -158,37 +240,33 @@ namespace BT_Conditions
 
 	bool IsSmallerAgentNearby(Elite::Blackboard* pBlackboard)
 	{
-		AgarioAgent* pAgent;
-		if (!pBlackboard->GetData("Agent", pAgent) || pAgent == nullptr) return false;
+		const AgarioWorldSnapshot* pWorld;
+		const AgarioAgentSnapshot* pSelf{ BT_Helpers::GetSelf(pBlackboard, pWorld) };
+		if (pSelf == nullptr) return false;
 
-		std::vector<AgarioAgent*>* pOtherAgents;
-		if (!pBlackboard->GetData("AgentsVec", pOtherAgents) || pOtherAgents == nullptr || pOtherAgents->empty()) return false;
-
-		const float agentRadius{ pAgent->GetRadius() };
+		const float agentRadius{ pSelf->radius };
 		const float chaseRadius{ agentRadius + 30.f };
 		float closestDistSqr{ chaseRadius * chaseRadius };
-		AgarioAgent* pClosestAgent{ nullptr };
-		Elite::Vector2 agentPos{ pAgent->GetPosition() };
-
-		DEBUGRENDERER2D->DrawCircle(agentPos, chaseRadius, Elite::Color{ 0.f, 0.f, 1.f }, DEBUGRENDERER2D->NextDepthSlice());
+		const AgarioAgentSnapshot* pClosestAgent{ nullptr };
+		const Elite::Vector2 agentPos{ pSelf->position };
 
-		for (auto& pOtherAgent : *pOtherAgents)
+		for (const AgarioAgentSnapshot& other : pWorld->agents)
 		{
-			if (pOtherAgent->GetRadius() + 1 >= pAgent->GetRadius()) continue;
+			if (other.radius + 1 >= agentRadius) continue;
 
-			float distSqr{ pOtherAgent->GetPosition().DistanceSquared(agentPos) - pOtherAgent->GetRadius() * pOtherAgent->GetRadius()};
+			float distSqr{ other.position.DistanceSquared(agentPos) - other.radius * other.radius };
 
 			if (distSqr < closestDistSqr)
 			{
 				closestDistSqr = distSqr;
-				pClosestAgent = pOtherAgent;
+				pClosestAgent = &other;
 			}
 		}
 
 		if (pClosestAgent != nullptr)
 		{
-			pBlackboard->ChangeData("Target", pClosestAgent->GetPosition());
-			pBlackboard->ChangeData("AgentTarget", pClosestAgent);
+			pBlackboard->ChangeData(BT_Keys::Target, pClosestAgent->position);
+			pBlackboard->ChangeData(BT_Keys::AgentTarget, pClosestAgent->pAgent);
 			return true;
 		}
 
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "App_AgarioGame.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 #include "StatesAndTransitions.h"
 
 
@@ -12,8 +13,14 @@
 using namespace Elite;
 using namespace FSMStates;
 using namespace FSMConditions;
-App_AgarioGame::App_AgarioGame()
+REGISTER_APP(App_AgarioGame, "FSM")
+
+App_AgarioGame::App_AgarioGame(const AppParameters& params)
 {
+	m_AmountOfAgents = params.GetInt("agents", m_AmountOfAgents);
+	m_AmountOfFood = params.GetInt("food", m_AmountOfFood);
+	m_TrimWorldSize = params.GetFloat("worldSize", m_TrimWorldSize);
+	m_AIScheduler.SetBudgetMs(params.GetFloat("aiBudget", m_AIScheduler.GetBudgetMs()));
 }
 
 App_AgarioGame::~App_AgarioGame()
@@ -72,6 +79,7 @@ void App_AgarioGame::Start()
 
 		FiniteStateMachine* pStateMachine = new FiniteStateMachine(pWanderState, pBlackboard);
 		newAgent->SetDecisionMaking(pStateMachine);
+		newAgent->SetAutoUpdateDecisionMaking(false);
 
 		m_pAgentVec.push_back(newAgent);
 	}
@@ -136,6 +144,7 @@ void App_AgarioGame::Start()
 
 	//6. Activate the decision making stucture on the custom agent by calling the SetDecisionMaking function
 	m_pCustomAgent->SetDecisionMaking(pStateMachine);
+	m_pCustomAgent->SetAutoUpdateDecisionMaking(false);
 	m_pCustomAgent->SetRenderBehavior(true);
 }
 
@@ -148,11 +157,15 @@ void App_AgarioGame::Update(float deltaTime)
 	{
 		m_GameOver = true;
 
-		//Update the other agents and food
+		//Run the state machines of the other agents, update them and the food
+		UpdateDecisionMaking(deltaTime);
 		UpdateAgarioEntities(m_pFoodVec, deltaTime);
 		UpdateAgarioEntities(m_pAgentVec, deltaTime);
 		return;
 	}
+	//Run the state machines that are due
+	UpdateDecisionMaking(deltaTime);
+
 	//Update the custom agent
 	m_pCustomAgent->Update(deltaTime);
 	m_pCustomAgent->TrimToWorld(m_TrimWorldSize, false);
@@ -201,6 +214,23 @@ Blackboard* App_AgarioGame::CreateBlackboard(AgarioAgent* a)
 	return pBlackboard;
 }
 
+void App_AgarioGame::UpdateDecisionMaking(float deltaTime)
+{
+	//The custom agent decides every frame, the other agents less often the further they are from it.
+	//Between their ticks the agents keep the steering their state set.
+	const Elite::Vector2 focusPos{ m_pCustomAgent->GetPosition() };
+	m_AIScheduler.Clear();
+	if (!m_GameOver)
+		m_AIScheduler.Add(m_pCustomAgent->GetDecisionMaking());
+	for (AgarioAgent* pAgent : m_pAgentVec)
+	{
+		const float distanceSquared{ pAgent->GetPosition().DistanceSquared(focusPos) };
+		m_AIScheduler.Add(pAgent->GetDecisionMaking(), distanceSquared < 30.f * 30.f ? 0 : distanceSquared < 60.f * 60.f ? 1 : 2);
+	}
+
+	m_AIScheduler.Update(deltaTime);
+}
+
 void App_AgarioGame::UpdateImGui()
 {
 	//------- UI --------
@@ -221,6 +251,12 @@ void App_AgarioGame::UpdateImGui()
 		//Elements
 		ImGui::Text("CONTROLS");
 		ImGui::Indent();
+		bool isTimeSliced{ m_AIScheduler.IsEnabled() };
+		if (ImGui::Checkbox("Time-sliced", &isTimeSliced))
+			m_AIScheduler.SetEnabled(isTimeSliced);
+		float budgetMs{ m_AIScheduler.GetBudgetMs() };
+		if (ImGui::SliderFloat("Budget", &budgetMs, 0.1f, 10.f, "%.1f ms"))
+			m_AIScheduler.SetBudgetMs(budgetMs);
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -232,6 +268,10 @@ void App_AgarioGame::UpdateImGui()
 		ImGui::Indent();
 		ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 		ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+		const AISchedulerStats& aiStats{ m_AIScheduler.GetStats() };
+		ImGui::Text("%.3f ms AI", aiStats.usedMs);
+		ImGui::Text("%d/%d FSMs ticked", aiStats.nrOfTicked, aiStats.nrOfAgents);
+		ImGui::Text("%d/%d over budget", m_AIScheduler.GetNrOfOverBudgetFrames(), m_AIScheduler.GetNrOfFrames());
 		ImGui::Unindent();
 
 		ImGui::Spacing();
@@ -1,9 +1,10 @@
-#ifndef AGARIO_GAME_APPLICATION_H
-#define AGARIO_GAME_APPLICATION_H
+#ifndef AGARIO_GAME_FSM_APPLICATION_H
+#define AGARIO_GAME_FSM_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "framework/EliteInterfaces/EAppParameters.h"
 
 class AgarioFood;
 class AgarioAgent;
@@ -12,7 +13,8 @@ class AgarioContactListener;
 class App_AgarioGame final : public IApp
 {
 public:
-	App_AgarioGame();
+	//Parameters: agents, food, worldSize, aiBudget (ms)
+	explicit App_AgarioGame(const Elite::AppParameters& params);
 	~App_AgarioGame();
 
 	void Start() override;
@@ -20,12 +22,12 @@ public:
 	void Render(float deltaTime) const override;
 private:
 	float m_TrimWorldSize = 100.f;
-	const int m_AmountOfAgents{ 30 };
+	int m_AmountOfAgents{ 30 };
 	std::vector<AgarioAgent*> m_pAgentVec{};
 
 	AgarioAgent* m_pCustomAgent = nullptr;
 
-	const int m_AmountOfFood{ 40 };
+	int m_AmountOfFood{ 40 };
 	const float m_FoodSpawnDelay{ 2.f };
 	float m_TimeSinceLastFoodSpawn{ 0.f };
 	std::vector<AgarioFood*> m_pFoodVec{};
@@ -35,12 +37,14 @@ private:
 
 	std::vector<Elite::FSMState*> m_pStates{};
 	std::vector<Elite::FSMCondition*> m_pConditions{};
+	Elite::AIScheduler m_AIScheduler{};
 
 private:	
 	template<class T_AgarioType>
 	void UpdateAgarioEntities(std::vector<T_AgarioType*>& entities, float deltaTime);
 
 	Elite::Blackboard* CreateBlackboard(AgarioAgent* a);
+	void UpdateDecisionMaking(float deltaTime);
 	void UpdateImGui();
 private:
 	//C++ make the class non-copyable
@@ -4,14 +4,27 @@ using namespace Elite;
 
 //Includes
 #include "App_InfluenceMap.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 #include "projects/Movement/SteeringBehaviors/SteeringAgent.h"
 #include "projects/Movement/SteeringBehaviors/Steering/SteeringBehaviors.h"
 
-//Destructor
+REGISTER_APP(App_InfluenceMap, "InfluenceMap")
+
+//Constructor & Destructor
+App_InfluenceMap::App_InfluenceMap(const AppParameters& params)
+{
+	m_Columns = params.GetInt("columns", m_Columns);
+	m_Rows = params.GetInt("rows", m_Rows);
+	m_CellSize = params.GetInt("cellSize", m_CellSize);
+	m_UseIncrementalPropagation = params.GetBool("incremental", m_UseIncrementalPropagation);
+}
+
+
 App_InfluenceMap::~App_InfluenceMap()
 {
 	SAFE_DELETE(m_pInfluenceGrid);
 	SAFE_DELETE(m_pInfluenceGraph2D);
+	SAFE_DELETE(m_pTacticalGrid);
 }
 
 //Functions
@@ -24,17 +37,34 @@ void App_InfluenceMap::Start()
 	DEBUGRENDERER2D->GetActiveCamera()->SetMoveLocked(true);
 
 	m_pInfluenceGrid = new InfluenceMap<InfluenceGrid>(false);
-	m_pInfluenceGrid->InitializeGrid(10, 10, 10, false, true);
+	m_pInfluenceGrid->InitializeGrid(m_Columns, m_Rows, m_CellSize, false, true);
 	m_pInfluenceGrid->InitializeBuffer();
 
 	m_pInfluenceGraph2D = new InfluenceMap<InfluenceGraph>(false);
 	m_pInfluenceGraph2D->InitializeBuffer();
+	m_pInfluenceGrid->SetUseIncrementalPropagation(m_UseIncrementalPropagation);
+	m_pInfluenceGraph2D->SetUseIncrementalPropagation(m_UseIncrementalPropagation);
+
+	m_pTacticalGrid = new LayeredInfluenceMap<InfluenceGrid>(false);
+	m_pTacticalGrid->InitializeGrid(20, 20, 5, false, true);
+	m_AlliesLayer = m_pTacticalGrid->AddLayer();
+	m_ThreatLayer = m_pTacticalGrid->AddLayer();
+	m_pTacticalGrid->AddDerivedLayer(DerivedInfluence::Sum, m_AlliesLayer, m_ThreatLayer); //Tension
+	m_VulnerabilityLayer = m_pTacticalGrid->AddDerivedLayer(DerivedInfluence::Difference, m_ThreatLayer, m_AlliesLayer);
+	m_pTacticalGrid->AddDerivedLayer(DerivedInfluence::Frontier, m_AlliesLayer, m_ThreatLayer);
 
 	m_GraphRenderer.SetNumberPrintPrecision(0);
 }
 
 void App_InfluenceMap::Update(float deltaTime)
 {
+	if (m_UseTacticalLayers)
+	{
+		UpdateTacticalLayers(deltaTime);
+		UpdateUI();
+		return;
+	}
+
 	if (m_EditGraphEnabled)
 	{
 		if (m_UseWaypointGraph)
@@ -106,6 +136,9 @@ void App_InfluenceMap::UpdateUI()
 	ImGui::Checkbox("Use waypoint graph", &m_UseWaypointGraph);
 	ImGui::Checkbox("Enable graph editing", &m_EditGraphEnabled);
 	ImGui::Checkbox("Render as graph", &m_RenderAsGraph);
+	ImGui::Checkbox("Tactical layers", &m_UseTacticalLayers);
+	if (m_UseTacticalLayers)
+		ImGui::Combo("Layer", &m_DisplayedLayer, "Allies\0Threat\0Tension\0Vulnerability\0Frontier", 5);
 
 	auto momentum = m_pInfluenceGrid->GetMomentum();
 	auto decay = m_pInfluenceGrid->GetDecay();
@@ -116,6 +149,21 @@ void App_InfluenceMap::UpdateUI()
 	ImGui::SliderFloat("Propagation Interval", &propagationInterval, 0.f, 2.f, "%.2");
 	ImGui::Spacing();
 
+	if (ImGui::Checkbox("Flat propagation", &m_UseFlatPropagation))
+	{
+		m_pInfluenceGrid->SetUseFlatPropagation(m_UseFlatPropagation);
+		m_pInfluenceGraph2D->SetUseFlatPropagation(m_UseFlatPropagation);
+	}
+	if (ImGui::Checkbox("Incremental propagation", &m_UseIncrementalPropagation))
+	{
+		m_pInfluenceGrid->SetUseIncrementalPropagation(m_UseIncrementalPropagation);
+		m_pInfluenceGraph2D->SetUseIncrementalPropagation(m_UseIncrementalPropagation);
+	}
+	ImGui::Text("%d nodes propagating", m_UseWaypointGraph ? m_pInfluenceGraph2D->GetNrOfPropagatingNodes() : m_pInfluenceGrid->GetNrOfPropagatingNodes());
+	if (ImGui::Button("Benchmark 512x512"))
+		RunPropagationBenchmark();
+	ImGui::Spacing();
+
 	//Set data
 	m_pInfluenceGrid->SetMomentum(momentum);
 	m_pInfluenceGrid->SetDecay(decay);
@@ -125,6 +173,13 @@ void App_InfluenceMap::UpdateUI()
 	m_pInfluenceGraph2D->SetDecay(decay);
 	m_pInfluenceGraph2D->SetPropagationInterval(propagationInterval);
 
+	for (const int layer : { m_AlliesLayer, m_ThreatLayer })
+	{
+		m_pTacticalGrid->SetMomentum(layer, momentum);
+		m_pTacticalGrid->SetDecay(layer, decay);
+	}
+	m_pTacticalGrid->SetPropagationInterval(propagationInterval);
+
 	//End
 	ImGui::PopAllowKeyboardFocus();
 	ImGui::End();
@@ -132,6 +187,17 @@ void App_InfluenceMap::UpdateUI()
 
 void App_InfluenceMap::Render(float deltaTime) const
 {
+	if (m_UseTacticalLayers)
+	{
+		m_pTacticalGrid->SetNodeColorsBasedOnLayer(m_DisplayedLayer);
+		m_GraphRenderer.RenderGraph(m_pTacticalGrid, true, false, false, true);
+
+		//Most vulnerable spot near the mouse that still has allies around
+		if (m_BestNodeIdx != invalid_node_index)
+			DEBUGRENDERER2D->DrawCircle(m_pTacticalGrid->GetNodeWorldPos(m_BestNodeIdx), 2.f, Color{ 1.f, 1.f, 0.f }, DEBUGRENDERER2D->NextDepthSlice());
+		DEBUGRENDERER2D->DrawCircle(m_MousePos, m_SearchRadius, Color{ 1.f, 1.f, 1.f }, DEBUGRENDERER2D->NextDepthSlice());
+		return;
+	}
 
 	if (m_UseWaypointGraph)
 	{
@@ -160,3 +226,90 @@ void App_InfluenceMap::AddInfluenceOnMouseClick(Elite::InputMouseButton mouseBtn
 	else
 		m_pInfluenceGrid->SetInfluenceAtPosition(mousePos, inf);
 }
+
+void App_InfluenceMap::UpdateTacticalLayers(float deltaTime)
+{
+	if (INPUTMANAGER->IsMouseMoving())
+	{
+		auto mouseData = INPUTMANAGER->GetMouseData(Elite::InputType::eMouseMotion);
+		m_MousePos = DEBUGRENDERER2D->GetActiveCamera()->ConvertScreenToWorld(Vector2{ (float)mouseData.X, (float)mouseData.Y });
+	}
+
+	if (INPUTMANAGER->IsMouseButtonUp(InputMouseButton::eLeft))
+		m_pTacticalGrid->StampInfluence(m_AlliesLayer, m_MousePos, 100.f, m_StampRadius);
+	if (INPUTMANAGER->IsMouseButtonUp(InputMouseButton::eRight))
+		m_pTacticalGrid->StampInfluence(m_ThreatLayer, m_MousePos, 100.f, m_StampRadius);
+
+	m_pTacticalGrid->PropagateInfluence(deltaTime);
+
+	m_BestNodeIdx = m_pTacticalGrid->FindBestNode(m_MousePos, m_SearchRadius, { { m_VulnerabilityLayer, 1.f }, { m_AlliesLayer, 0.5f } });
+}
+
+void App_InfluenceMap::RunPropagationBenchmark() const
+{
+	const int size{ 512 };
+	const int nrOfSteps{ 20 };
+
+	//Dense: influence all over the map, sparse: a few sources that converge (the incremental propagation only pays off there)
+	for (const int nrOfSources : { 256, 4 })
+	{
+		//All maps start from the same scattered influences, the last one only stops propagating nodes when they converged exactly
+		InfluenceMap<InfluenceGrid> nodeMap{ false };
+		InfluenceMap<InfluenceGrid> flatMap{ false };
+		InfluenceMap<InfluenceGrid> incrementalMap{ false };
+		InfluenceMap<InfluenceGrid> exactIncrementalMap{ false };
+		const std::vector<InfluenceMap<InfluenceGrid>*> pMaps{ &nodeMap, &flatMap, &incrementalMap, &exactIncrementalMap };
+		for (auto pMap : pMaps)
+		{
+			pMap->InitializeGrid(size, size, 1, false, true);
+			pMap->InitializeBuffer();
+			pMap->SetPropagationInterval(0.f);
+			pMap->SetMomentum(m_pInfluenceGrid->GetMomentum());
+			pMap->SetDecay(m_pInfluenceGrid->GetDecay());
+
+			std::mt19937 randomEngine{ 1 };
+			std::uniform_int_distribution<int> randomIdx{ 0, size * size - 1 };
+			for (int i{ 0 }; i < nrOfSources; ++i)
+				pMap->GetNode(randomIdx(randomEngine))->SetInfluence(i % 2 == 0 ? 100.f : -100.f);
+		}
+		nodeMap.SetUseFlatPropagation(false);
+		incrementalMap.SetUseIncrementalPropagation(true);
+		incrementalMap.SetConvergenceEpsilon(m_pInfluenceGrid->GetConvergenceEpsilon());
+		exactIncrementalMap.SetUseIncrementalPropagation(true);
+		exactIncrementalMap.SetConvergenceEpsilon(0.f);
+
+		std::vector<float> stepMs{};
+		for (auto pMap : pMaps)
+		{
+			//The first step bakes the graph, it isn't timed
+			pMap->PropagateInfluence(1.f);
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (int step{ 1 }; step < nrOfSteps; ++step)
+				pMap->PropagateInfluence(1.f);
+			stepMs.push_back(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / (nrOfSteps - 1));
+		}
+
+		//Every map against the node based one
+		std::vector<int> nrOfMismatches(pMaps.size());
+		std::vector<float> maxDifferences(pMaps.size());
+		for (size_t mapIdx{ 1 }; mapIdx < pMaps.size(); ++mapIdx)
+		{
+			for (int idx{ 0 }; idx < size * size; ++idx)
+			{
+				const float influence{ pMaps[mapIdx]->GetNode(idx)->GetInfluence() };
+				if (nodeMap.GetNode(idx)->GetInfluence() != influence)
+					++nrOfMismatches[mapIdx];
+				maxDifferences[mapIdx] = std::max(maxDifferences[mapIdx], abs(nodeMap.GetNode(idx)->GetInfluence() - influence));
+			}
+		}
+
+		std::cout << "[InfluenceMap Benchmark] " << size << "x" << size << " grid, " << nrOfSources << " sources: node based "
+			<< stepMs[0] << " ms/step, flat " << stepMs[1] << " ms/step on " << JOBSYSTEM->GetNrOfThreads() << " threads ("
+			<< nrOfMismatches[1] << " nodes differ, max difference " << maxDifferences[1] << ")" << std::endl;
+		std::cout << "[InfluenceMap Benchmark] incremental (epsilon " << incrementalMap.GetConvergenceEpsilon() << ") " << stepMs[2]
+			<< " ms/step, " << incrementalMap.GetNrOfPropagatingNodes() << " nodes left (" << nrOfMismatches[2]
+			<< " nodes differ, max difference " << maxDifferences[2] << "), exact incremental " << stepMs[3] << " ms/step ("
+			<< nrOfMismatches[3] << " nodes differ)" << std::endl;
+	}
+}
@@ -4,10 +4,12 @@
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "framework/EliteInterfaces/EAppParameters.h"
 
 //--- Includes and Forward Declarations ---
 #include "projects/Movement/SteeringBehaviors/SteeringHelpers.h"
 #include "framework\EliteAI\EliteGraphs\EInfluenceMap.h"
+#include "framework\EliteAI\EliteGraphs\ELayeredInfluenceMap.h"
 #include "framework\EliteAI\EliteGraphs\EGraph2D.h"
 #include "framework\EliteAI\EliteGraphs\EGridGraph.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphUtilities\EGraphEditor.h"
@@ -26,7 +28,8 @@ class App_InfluenceMap final : public IApp
 {
 public:
 	//Constructor & Destructor
-	App_InfluenceMap() = default;
+	//Parameters: columns, rows, cellSize (of the influence grid), incremental
+	explicit App_InfluenceMap(const Elite::AppParameters& params);
 	virtual ~App_InfluenceMap() final;
 
 	//App Functions
@@ -40,6 +43,9 @@ public:
 
 private:
 	Elite::InfluenceMap<InfluenceGrid>* m_pInfluenceGrid = nullptr;
+	int m_Columns = 10;
+	int m_Rows = 10;
+	int m_CellSize = 10;
 	Elite::GraphEditor m_WaypointGraphEditor{};
 	Elite::InfluenceMap<InfluenceGraph>* m_pInfluenceGraph2D = nullptr;
 	Elite::GraphEditor m_GridEditor{};
@@ -49,7 +55,26 @@ private:
 	bool m_EditGraphEnabled = false;
 	bool m_RenderAsGraph = false;
 
+	bool m_UseFlatPropagation = true;
+	bool m_UseIncrementalPropagation = false;
+
+	//Tactical layers: allies (LMB) and threat (RMB) with the maps derived from them
+	Elite::LayeredInfluenceMap<InfluenceGrid>* m_pTacticalGrid = nullptr;
+	bool m_UseTacticalLayers = false;
+	int m_AlliesLayer = 0;
+	int m_ThreatLayer = 0;
+	int m_VulnerabilityLayer = 0;
+	int m_DisplayedLayer = 0;
+	int m_BestNodeIdx = invalid_node_index;
+	Elite::Vector2 m_MousePos{};
+	const float m_StampRadius = 15.f;
+	const float m_SearchRadius = 20.f;
+
+	void UpdateTacticalLayers(float deltaTime);
+
 	void AddInfluenceOnMouseClick(Elite::InputMouseButton mouseBtn, float inf);
+	// Propagates a 512x512 influence grid with the node based, the flat and the incremental kernel, prints the timings and compares the results
+	void RunPropagationBenchmark() const;
 private:
 	//C++ make the class non-copyable
 	App_InfluenceMap(const App_InfluenceMap&) = delete;
@@ -3,14 +3,69 @@
 
 //Includes
 #include "App_PathfindingAStar.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EAstar.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EBFS.h"
+#include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EJumpPointSearch.h"
 
 using namespace Elite;
+REGISTER_APP(App_PathfindingAStar, "AStar")
+
+namespace
+{
+	// Cost of a path as AStar counts it (1 + connection cost per step), negative when two consecutive cells aren't connected
+	float GetPathCost(const ImplicitGridGraph& grid, const std::vector<int>& path)
+	{
+		float cost = 0.f;
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			float stepCost = -1.f;
+			grid.ForEachNeighbor(path[i - 1], [&](int nextIdx, float connectionCost)
+			{
+				if (nextIdx == path[i])
+					stepCost = 1 + connectionCost;
+			});
+			if (stepCost < 0.f)
+				return -1.f;
+			cost += stepCost;
+		}
+		return cost;
+	}
+
+	// Maze-like benchmark terrain: walls every 8 cells, with random gaps
+	void MakeMaze(ImplicitGridGraph& grid, std::mt19937& randomEngine)
+	{
+		std::uniform_int_distribution<int> gapOffset{ 1, 7 };
+		for (int r = 0; r < grid.GetRows(); ++r)
+		{
+			for (int c = 0; c < grid.GetColumns(); c += 8)
+			{
+				if (r % 8 != gapOffset(randomEngine))
+					grid.SetTerrainType(grid.GetIndex(c, r), TerrainType::Water);
+			}
+		}
+		for (int r = 0; r < grid.GetRows(); r += 8)
+		{
+			for (int c = 0; c < grid.GetColumns(); ++c)
+			{
+				if (c % 8 != gapOffset(randomEngine))
+					grid.SetTerrainType(grid.GetIndex(c, r), TerrainType::Water);
+			}
+		}
+	}
+}
+
+//Constructor & Destructor
+App_PathfindingAStar::App_PathfindingAStar(const AppParameters& params)
+{
+	m_Columns = params.GetInt("columns", m_Columns);
+	m_Rows = params.GetInt("rows", m_Rows);
+	m_SizeCell = static_cast<unsigned int>(params.GetInt("cellSize", static_cast<int>(m_SizeCell)));
+}
 
-//Destructor
 App_PathfindingAStar::~App_PathfindingAStar()
 {
+	SAFE_DELETE(m_pHPAStar);
 	SAFE_DELETE(m_pGridGraph);
 	SAFE_DELETE(m_pGraphRenderer);
 	SAFE_DELETE(m_pGraphEditor);
@@ -64,6 +119,12 @@ void App_PathfindingAStar::Update(float deltaTime)
 	//UPDATE/CHECK GRID HAS CHANGED
 	if (m_pGraphEditor->UpdateGraph(m_pGridGraph))
 	{
+		//Only the clusters around the edited cells are rebuilt
+		for (const int idx : m_pGridGraph->GetModifiedNodes())
+			m_pHPAStar->InvalidateNode(idx);
+		m_pGridGraph->ClearModifiedNodes();
+		m_pHPAStar->Update();
+
 		CalculatePath();
 	}
 }
@@ -92,11 +153,20 @@ void App_PathfindingAStar::Render(float deltaTime) const
 		m_pGraphRenderer->HighlightNodes(m_pGridGraph, m_vPath);
 	}
 
+	//Render the transitions of the HPA* abstraction
+	if (m_DebugSettings.DrawHPATransitions)
+	{
+		std::vector<GridTerrainNode*> transitions{};
+		for (const int idx : m_pHPAStar->GetTransitions())
+			transitions.push_back(m_pGridGraph->GetNode(idx));
+		m_pGraphRenderer->HighlightNodes(m_pGridGraph, transitions, Color{ 0.8f, 0.4f, 0.9f });
+	}
+
 }
 
 void App_PathfindingAStar::MakeGridGraph()
 {
-	m_pGridGraph = new GridGraph<GridTerrainNode, GraphConnection>(COLUMNS, ROWS, m_SizeCell, false, false, 1.f, 1.5f);
+	m_pGridGraph = new GridGraph<GridTerrainNode, GraphConnection>(m_Columns, m_Rows, m_SizeCell, false, false, 1.f, 1.5f);
 
 	//Setup default terrain
 	m_pGridGraph->GetNode(86)->SetTerrainType(TerrainType::Water);
@@ -107,6 +177,9 @@ void App_PathfindingAStar::MakeGridGraph()
 	m_pGridGraph->RemoveConnectionsToAdjacentNodes(66);
 	m_pGridGraph->RemoveConnectionsToAdjacentNodes(67);
 	m_pGridGraph->RemoveConnectionsToAdjacentNodes(47);
+	m_pGridGraph->ClearModifiedNodes();
+
+	m_pHPAStar = new HPAStar<GridGraph<GridTerrainNode, GraphConnection>>(m_pGridGraph, CLUSTER_SIZE, m_pHeuristicFunction);
 }
 
 void App_PathfindingAStar::UpdateImGui()
@@ -185,6 +258,22 @@ void App_PathfindingAStar::UpdateImGui()
 				m_pHeuristicFunction = HeuristicFunctions::Chebyshev;
 				break;
 			}
+			m_pHPAStar->SetHeuristicFunction(m_pHeuristicFunction);
+		}
+		ImGui::Spacing();
+
+		if (ImGui::Checkbox("Use HPA*", &m_UseHPAStar))
+		{
+			CalculatePath();
+		}
+		ImGui::Checkbox("HPA* Transitions", &m_DebugSettings.DrawHPATransitions);
+		ImGui::Spacing();
+
+		if (ImGui::Button("Run Benchmark"))
+		{
+			RunBenchmark();
+			RunJumpPointBenchmark();
+			RunHierarchicalBenchmark();
 		}
 		ImGui::Spacing();
 
@@ -209,7 +298,17 @@ void App_PathfindingAStar::CalculatePath()
 		auto startNode = m_pGridGraph->GetNode(startPathIdx);
 		auto endNode = m_pGridGraph->GetNode(endPathIdx);
 
-		m_vPath = pathfinder.FindPath(startNode, endNode);
+		if (m_UseHPAStar)
+		{
+			m_vPath.clear();
+			m_pHPAStar->FindPath(startPathIdx, endPathIdx, m_SearchContext, m_vIndexPath);
+			for (const int idx : m_vIndexPath)
+				m_vPath.push_back(m_pGridGraph->GetNode(idx));
+		}
+		else
+		{
+			pathfinder.FindPath(startNode, endNode, m_SearchContext, m_vPath);
+		}
 
 
 		std::cout << "New Path Calculated" << std::endl;
@@ -220,3 +319,225 @@ void App_PathfindingAStar::CalculatePath()
 		m_vPath.clear();
 	}
 }
+
+void App_PathfindingAStar::RunBenchmark() const
+{
+	// Corner to corner queries on empty grids, with the currently selected heuristic
+	const int gridSizes[]{ 256, 1024 };
+	const int nrOfQueries = 10;
+
+	for (const int size : gridSizes)
+	{
+		auto buildStart = std::chrono::high_resolution_clock::now();
+		auto pGrid = new GridGraph<GridTerrainNode, GraphConnection>(size, size, m_SizeCell, false, false, 1.f, 1.5f);
+		auto buildEnd = std::chrono::high_resolution_clock::now();
+
+		auto pathfinder = AStar<GridTerrainNode, GraphConnection>(pGrid, m_pHeuristicFunction);
+		size_t nrOfContextAllocations = 0;
+		SearchContext context{ pGrid->GetNrOfNodes(), &nrOfContextAllocations };
+		std::vector<GridTerrainNode*> path{};
+
+		auto queryStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < nrOfQueries; ++i)
+		{
+			pathfinder.FindPath(pGrid->GetNode(0, 0), pGrid->GetNode(size - 1, size - 1), context, path);
+		}
+		auto queryEnd = std::chrono::high_resolution_clock::now();
+
+		// The context and path are sized by now, so further queries must not allocate.
+		// The std::vector buffers only allocate when their capacity grows.
+		nrOfContextAllocations = 0;
+		size_t capacities = path.capacity() + context.GetIndexPath().capacity();
+		for (int i = 0; i < nrOfQueries; ++i)
+		{
+			pathfinder.FindPath(pGrid->GetNode(0, 0), pGrid->GetNode(size - 1, size - 1), context, path);
+		}
+		const bool isGridAllocationFree = nrOfContextAllocations == 0 && capacities == path.capacity() + context.GetIndexPath().capacity();
+
+		const auto buildMs = std::chrono::duration<float, std::milli>(buildEnd - buildStart).count();
+		const auto queryMs = std::chrono::duration<float, std::milli>(queryEnd - queryStart).count() / nrOfQueries;
+		// Estimate: node + pointer per cell, connection + list node (two links and the payload pointer) per connection
+		const size_t gridBytes = pGrid->GetNrOfNodes() * (sizeof(GridTerrainNode) + sizeof(GridTerrainNode*) + sizeof(std::list<GraphConnection*>))
+			+ pGrid->GetNrOfConnections() * (sizeof(GraphConnection) + 3 * sizeof(void*));
+		std::cout << "[A* Benchmark] " << size << "x" << size << " GridGraph: build " << buildMs << " ms, ~"
+			<< gridBytes / (1024 * 1024) << " MB, " << queryMs << " ms/query, path length " << path.size()
+			<< (isGridAllocationFree ? ", no allocations in steady state" : ", steady-state queries allocated") << std::endl;
+		assert(isGridAllocationFree && "<App_PathfindingAStar::RunBenchmark>: A* allocated on a sized search context");
+
+		SAFE_DELETE(pGrid);
+
+		// Same grid, but the connections are generated during the search
+		buildStart = std::chrono::high_resolution_clock::now();
+		const ImplicitGridGraph implicitGrid{ size, size, (int)m_SizeCell, false, 1.f, 1.5f };
+		buildEnd = std::chrono::high_resolution_clock::now();
+
+		const IndexedAStar<ImplicitGridGraph> implicitPathfinder{ &implicitGrid, m_pHeuristicFunction };
+		std::vector<int> indexPath{};
+
+		queryStart = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < nrOfQueries; ++i)
+		{
+			implicitPathfinder.FindPath(implicitGrid.GetIndex(0, 0), implicitGrid.GetIndex(size - 1, size - 1), context, indexPath);
+		}
+		queryEnd = std::chrono::high_resolution_clock::now();
+
+		nrOfContextAllocations = 0;
+		capacities = indexPath.capacity();
+		for (int i = 0; i < nrOfQueries; ++i)
+		{
+			implicitPathfinder.FindPath(implicitGrid.GetIndex(0, 0), implicitGrid.GetIndex(size - 1, size - 1), context, indexPath);
+		}
+		const bool isImplicitAllocationFree = nrOfContextAllocations == 0 && capacities == indexPath.capacity();
+
+		const auto implicitBuildMs = std::chrono::duration<float, std::milli>(buildEnd - buildStart).count();
+		const auto implicitQueryMs = std::chrono::duration<float, std::milli>(queryEnd - queryStart).count() / nrOfQueries;
+		std::cout << "[A* Benchmark] " << size << "x" << size << " ImplicitGridGraph: build " << implicitBuildMs << " ms, "
+			<< implicitGrid.GetMemoryFootprint() / 1024 << " KB, " << implicitQueryMs << " ms/query, path length " << indexPath.size()
+			<< (isImplicitAllocationFree ? ", no allocations in steady state" : ", steady-state queries allocated") << std::endl;
+		assert(isImplicitAllocationFree && "<App_PathfindingAStar::RunBenchmark>: IndexedAStar allocated on a sized search context");
+	}
+}
+
+void App_PathfindingAStar::RunJumpPointBenchmark() const
+{
+	// Random queries on diagonally connected 256x256 grids, A* versus Jump Point Search (octile heuristic)
+	const int size = 256;
+	const int nrOfQueries = 100;
+	std::mt19937 randomEngine{ 1 };
+
+	ImplicitGridGraph randomGrid{ size, size, (int)m_SizeCell, true };
+	std::bernoulli_distribution isWater{ 0.25 };
+	for (int idx = 0; idx < randomGrid.GetNrOfNodes(); ++idx)
+	{
+		if (isWater(randomEngine))
+			randomGrid.SetTerrainType(idx, TerrainType::Water);
+	}
+
+	ImplicitGridGraph mazeGrid{ size, size, (int)m_SizeCell, true };
+	MakeMaze(mazeGrid, randomEngine);
+
+	const std::pair<const char*, const ImplicitGridGraph*> grids[]{ { "random", &randomGrid }, { "maze", &mazeGrid } };
+	for (const auto& grid : grids)
+	{
+		const ImplicitGridGraph* pGrid = grid.second;
+		std::uniform_int_distribution<int> randomIdx{ 0, pGrid->GetNrOfNodes() - 1 };
+		std::vector<std::pair<int, int>> queries{};
+		while ((int)queries.size() < nrOfQueries)
+		{
+			const int from = randomIdx(randomEngine);
+			const int to = randomIdx(randomEngine);
+			if (pGrid->GetTerrainType(from) != TerrainType::Water && pGrid->GetTerrainType(to) != TerrainType::Water)
+				queries.emplace_back(from, to);
+		}
+
+		const IndexedAStar<ImplicitGridGraph> aStar{ pGrid, HeuristicFunctions::Octile };
+		const JumpPointSearch<ImplicitGridGraph> jps{ pGrid, HeuristicFunctions::Octile };
+		SearchContext context{ pGrid->GetNrOfNodes() };
+		std::vector<int> path{};
+
+		long long aStarExpanded = 0, jpsExpanded = 0;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (const auto& query : queries)
+		{
+			aStar.FindPath(query.first, query.second, context, path);
+			aStarExpanded += context.GetNrOfExpandedNodes();
+		}
+		const auto aStarUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+		start = std::chrono::high_resolution_clock::now();
+		for (const auto& query : queries)
+		{
+			jps.FindPath(query.first, query.second, context, path);
+			jpsExpanded += context.GetNrOfExpandedNodes();
+		}
+		const auto jpsUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+		// Outside of the timing: JPS has to find a valid path of the same cost as A* for every query
+		int nrOfMismatches = 0;
+		for (const auto& query : queries)
+		{
+			const bool aStarFound = aStar.FindPath(query.first, query.second, context, path);
+			const float aStarCost = aStarFound ? GetPathCost(*pGrid, path) : -1.f;
+			const bool jpsFound = jps.FindPath(query.first, query.second, context, path);
+			const float jpsCost = jpsFound ? GetPathCost(*pGrid, path) : -1.f;
+
+			if (aStarFound == jpsFound && AreEqual(aStarCost, jpsCost, 1e-3f * std::max(1.f, aStarCost)))
+				continue;
+
+			++nrOfMismatches;
+			std::cout << "[JPS Benchmark] " << grid.first << " mismatch " << query.first << " -> " << query.second << ": A* "
+				<< (aStarFound ? "cost " + std::to_string(aStarCost) : std::string{ "no path" }) << ", JPS "
+				<< (!jpsFound ? std::string{ "no path" } : jpsCost < 0.f ? std::string{ "invalid path" } : "cost " + std::to_string(jpsCost)) << std::endl;
+		}
+
+		std::cout << "[JPS Benchmark] " << grid.first << " " << size << "x" << size << ": A* " << aStarUs << " us/query, "
+			<< aStarExpanded / nrOfQueries << " nodes expanded | JPS " << jpsUs << " us/query, "
+			<< jpsExpanded / nrOfQueries << " nodes expanded | " << nrOfMismatches << " cost mismatches" << std::endl;
+	}
+}
+
+void App_PathfindingAStar::RunHierarchicalBenchmark() const
+{
+	// Long random queries on a large maze-like grid: A* versus HPA* (octile heuristic, 16x16 clusters)
+	const int size = 1024;
+	const int clusterSize = 16;
+	const int nrOfQueries = 20;
+	std::mt19937 randomEngine{ 1 };
+
+	ImplicitGridGraph grid{ size, size, (int)m_SizeCell, true };
+	MakeMaze(grid, randomEngine);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	HPAStar<ImplicitGridGraph> hpaStar{ &grid, clusterSize, HeuristicFunctions::Octile };
+	const auto buildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::uniform_int_distribution<int> randomIdx{ 0, grid.GetNrOfNodes() - 1 };
+	std::vector<std::pair<int, int>> queries{};
+	while ((int)queries.size() < nrOfQueries)
+	{
+		const int from = randomIdx(randomEngine);
+		const int to = randomIdx(randomEngine);
+		if (grid.GetTerrainType(from) != TerrainType::Water && grid.GetTerrainType(to) != TerrainType::Water)
+			queries.emplace_back(from, to);
+	}
+
+	const IndexedAStar<ImplicitGridGraph> aStar{ &grid, HeuristicFunctions::Octile };
+	SearchContext context{ grid.GetNrOfNodes() };
+	std::vector<int> path{};
+	size_t aStarPathLength = 0, hpaPathLength = 0;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& query : queries)
+	{
+		aStar.FindPath(query.first, query.second, context, path);
+		aStarPathLength += path.size();
+	}
+	const auto aStarMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& query : queries)
+		hpaStar.FindAbstractPath(query.first, query.second, context, path);
+	const auto abstractMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& query : queries)
+	{
+		hpaStar.FindPath(query.first, query.second, context, path);
+		hpaPathLength += path.size();
+	}
+	const auto hpaMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	// Local edit: only the clusters around the cell are rebuilt
+	const int editIdx = grid.GetIndex(size / 2 + 3, size / 2 + 3);
+	grid.SetTerrainType(editIdx, TerrainType::Water);
+	start = std::chrono::high_resolution_clock::now();
+	hpaStar.InvalidateNode(editIdx);
+	hpaStar.Update();
+	const auto updateMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << "[HPA* Benchmark] maze " << size << "x" << size << ": build " << buildMs << " ms, " << hpaStar.GetNrOfTransitions()
+		<< " transitions, local update " << updateMs << " ms | A* " << aStarMs << " ms/query | HPA* abstract " << abstractMs
+		<< " ms/query, refined " << hpaMs << " ms/query, path length +"
+		<< (aStarPathLength > 0 ? 100.f * (float(hpaPathLength) / aStarPathLength - 1.f) : 0.f) << "%" << std::endl;
+}
@@ -4,10 +4,14 @@
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "framework/EliteInterfaces/EAppParameters.h"
 #include "framework\EliteAI\EliteGraphs\EGridGraph.h"
+#include "framework\EliteAI\EliteGraphs\EImplicitGridGraph.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphUtilities\EGraphEditor.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphUtilities\EGraphRenderer.h"
 #include "framework\EliteAI\EliteNavigation\ENavigation.h"
+#include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\ESearchContext.h"
+#include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EHPAStar.h"
 
 
 //-----------------------------------------------------------------
@@ -17,7 +21,8 @@ class App_PathfindingAStar final : public IApp
 {
 public:
 	//Constructor & Destructor
-	App_PathfindingAStar() = default;
+	//Parameters: columns, rows, cellSize
+	explicit App_PathfindingAStar(const Elite::AppParameters& params);
 	virtual ~App_PathfindingAStar();
 
 	//App Functions
@@ -32,6 +37,7 @@ private:
 		bool DrawNodeNumbers{ false };
 		bool DrawConnections{ false };
 		bool DrawConnectionCosts{ false };
+		bool DrawHPATransitions{ false };
 	};
 
 	//Datamembers
@@ -40,8 +46,9 @@ private:
 	Elite::Vector2 m_TargetPosition = Elite::ZeroVector2;
 
 	//Grid datamembers
-	static const int COLUMNS = 20;
-	static const int ROWS = 10;
+	int m_Columns = 20;
+	int m_Rows = 10;
+	static const int CLUSTER_SIZE = 5;
 	unsigned int m_SizeCell = 15;
 	Elite::GridGraph<Elite::GridTerrainNode, Elite::GraphConnection>* m_pGridGraph;
 
@@ -49,6 +56,10 @@ private:
 	int startPathIdx = invalid_node_index;
 	int endPathIdx = invalid_node_index;
 	std::vector<Elite::GridTerrainNode*> m_vPath;
+	Elite::SearchContext m_SearchContext{};
+	Elite::HPAStar<Elite::GridGraph<Elite::GridTerrainNode, Elite::GraphConnection>>* m_pHPAStar{ nullptr };
+	std::vector<int> m_vIndexPath;
+	bool m_UseHPAStar = false;
 
 	//Editor and Visualisation
 	Elite::GraphEditor* m_pGraphEditor{ nullptr};
@@ -65,6 +76,9 @@ private:
 	void MakeGridGraph();
 	void UpdateImGui();
 	void CalculatePath();
+	void RunBenchmark() const;
+	void RunJumpPointBenchmark() const;
+	void RunHierarchicalBenchmark() const;
 
 	//C++ make the class non-copyable
 	App_PathfindingAStar(const App_PathfindingAStar&) = delete;
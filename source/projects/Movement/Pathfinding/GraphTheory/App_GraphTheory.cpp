@@ -4,9 +4,12 @@
 //Includes
 #include "App_GraphTheory.h"
 #include "framework\EliteAI\EliteGraphs\EliteGraphAlgorithms\EEularianPath.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 
 using namespace Elite;
 using namespace std;
+REGISTER_APP(App_GraphTheory, "GraphTheory")
+
 //Destructor
 App_GraphTheory::~App_GraphTheory()
 {
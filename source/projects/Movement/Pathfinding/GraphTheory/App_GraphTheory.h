@@ -1,5 +1,5 @@
-#ifndef INFLUENCE_MAP_APPLICATION_H
-#define INFLUENCE_MAP_APPLICATION_H
+#ifndef GRAPH_THEORY_APPLICATION_H
+#define GRAPH_THEORY_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
@@ -11,6 +11,53 @@ using namespace Elite;
 
 
 #include "framework\EliteAI\EliteNavigation\Algorithms\ENavGraphPathfinding.h"
+#include <thread>
+#include "framework/EliteInterfaces/EAppRegistry.h"
+
+REGISTER_APP(App_NavMeshGraph, "NavMeshGraph")
+
+namespace
+{
+	// Reads the obstacle outlines of a .gppl level file: the world size, followed by groups of shapes with their merged outlines
+	bool LoadLevelObstacles(const std::string& filePath, std::vector<Elite::Polygon>& vObstacles, Elite::Vector2& worldSize)
+	{
+		std::ifstream file{ filePath, std::ios::binary };
+		if (!file)
+			return false;
+
+		auto readInt = [&file]() { int value = 0; file.read(reinterpret_cast<char*>(&value), sizeof(value)); return value; };
+		auto readVector = [&file]() { Elite::Vector2 value{}; file.read(reinterpret_cast<char*>(&value.x), sizeof(float)); file.read(reinterpret_cast<char*>(&value.y), sizeof(float)); return value; };
+
+		worldSize = readVector();
+		const int nrOfGroups = readInt();
+		for (int g = 0; g < nrOfGroups && file; ++g)
+		{
+			readVector(); // center
+			readVector(); // size
+			const int nrOfShapes = readInt();
+			for (int s = 0; s < nrOfShapes && file; ++s)
+			{
+				const int nrOfVertices = readInt();
+				for (int v = 0; v < nrOfVertices && file; ++v)
+					readVector();
+			}
+
+			const int nrOfOutlines = readInt();
+			for (int o = 0; o < nrOfOutlines && file; ++o)
+			{
+				std::vector<Elite::Vector2> vertices(readInt());
+				for (auto& vertex : vertices)
+					vertex = readVector();
+
+				// Obstacles are holes in the navmesh, wound like the shapes of the physics world
+				Elite::Polygon obstacle{ vertices };
+				obstacle.OrientateWithChildren(Elite::Winding::CW);
+				vObstacles.push_back(obstacle);
+			}
+		}
+		return bool(file);
+	}
+}
 
 //Statics
 bool App_NavMeshGraph::sShowPolygon = true;
@@ -18,6 +65,7 @@ bool App_NavMeshGraph::sShowGraph = false;
 bool App_NavMeshGraph::sDrawPortals = false;
 bool App_NavMeshGraph::sDrawFinalPath = true;
 bool App_NavMeshGraph::sDrawNonOptimisedPath = false;
+bool App_NavMeshGraph::sUseMonotoneTriangulation = false;
 
 //Destructor
 App_NavMeshGraph::~App_NavMeshGraph()
@@ -47,10 +95,7 @@ void App_NavMeshGraph::Start()
 	m_vNavigationColliders.push_back(new NavigationColliderElement(Elite::Vector2(15.f, -21.f), 50.0f, 3.0f));
 
 	//----------- NAVMESH  ------------
-	std::list<Elite::Vector2> baseBox
-	{ { -60, 30 },{ -60, -30 },{ 60, -30 },{ 60, 30 } };
-
-	m_pNavGraph = new Elite::NavGraph(Elite::Polygon(baseBox), m_AgentRadius);
+	RebuildNavGraph();
 
 	//----------- AGENT ------------
 	m_pSeekBehavior = new Seek();
@@ -66,6 +111,21 @@ void App_NavMeshGraph::Start()
 
 }
 
+void App_NavMeshGraph::RebuildNavGraph()
+{
+	std::list<Elite::Vector2> baseBox
+	{ { -60, 30 },{ -60, -30 },{ 60, -30 },{ 60, 30 } };
+
+	SAFE_DELETE(m_pNavGraph);
+	m_pNavGraph = new Elite::NavGraph(Elite::Polygon(baseBox), m_AgentRadius,
+		sUseMonotoneTriangulation ? TriangulationMethod::MonotonePartition : TriangulationMethod::EarClipping);
+
+	//The old path and debug info refer to the previous triangles
+	m_vPath.clear();
+	m_DebugNodePositions.clear();
+	m_Portals.clear();
+}
+
 void App_NavMeshGraph::Update(float deltaTime)
 {
 	//Update target/path based on input
@@ -74,7 +134,9 @@ void App_NavMeshGraph::Update(float deltaTime)
 		auto mouseData = INPUTMANAGER->GetMouseData(Elite::InputType::eMouseButton, Elite::InputMouseButton::eMiddle);
 		Elite::Vector2 mouseTarget = DEBUGRENDERER2D->GetActiveCamera()->ConvertScreenToWorld(
 			Elite::Vector2((float)mouseData.X, (float)mouseData.Y));
-		m_vPath = NavMeshPathfinding::FindPath(m_pAgent->GetPosition(), mouseTarget, m_pNavGraph, m_DebugNodePositions, m_Portals);
+		m_NavMeshQuery.FindPath(m_pAgent->GetPosition(), mouseTarget, m_pNavGraph, m_vPath);
+		m_DebugNodePositions = m_NavMeshQuery.GetDebugNodePositions();
+		m_Portals = m_NavMeshQuery.GetDebugPortals();
 	}
 
 	//Check if a path exist and move to the following point
@@ -203,6 +265,8 @@ void App_NavMeshGraph::UpdateImGui()
 		ImGui::Checkbox("Show Portals", &sDrawPortals);
 		ImGui::Checkbox("Show Path Nodes", &sDrawNonOptimisedPath);
 		ImGui::Checkbox("Show Final Path", &sDrawFinalPath);
+		if (ImGui::Checkbox("Monotone Triangulation", &sUseMonotoneTriangulation))
+			RebuildNavGraph();
 		ImGui::Spacing();
 		ImGui::Spacing();
 
@@ -210,6 +274,12 @@ void App_NavMeshGraph::UpdateImGui()
 		{
 			m_pAgent->SetMaxLinearSpeed(m_AgentSpeed);
 		}
+		ImGui::Spacing();
+
+		if (ImGui::Button("Run Benchmark"))
+		{
+			RunBenchmark();
+		}
 		
 		//End
 		ImGui::PopAllowKeyboardFocus();
@@ -217,4 +287,144 @@ void App_NavMeshGraph::UpdateImGui()
 	}
 #pragma endregion
 #endif
-}
\ No newline at end of file
+}
+
+void App_NavMeshGraph::RunBenchmark() const
+{
+	// Navmesh construction of the shipped levels
+	for (const std::string levelName : { "LevelOne", "LevelTwo", "LevelThree", "GameLevel" })
+	{
+		std::vector<Elite::Polygon> vObstacles = {};
+		Elite::Vector2 worldSize{};
+		if (!LoadLevelObstacles("../data/" + levelName + ".gppl", vObstacles, worldSize))
+		{
+			std::cout << "[NavMesh Benchmark] " << levelName << ": could not load level" << std::endl;
+			continue;
+		}
+
+		const Elite::Vector2 halfSize = worldSize / 2.f;
+		std::list<Elite::Vector2> levelBox
+		{ { -halfSize.x, halfSize.y },{ -halfSize.x, -halfSize.y },{ halfSize.x, -halfSize.y },{ halfSize.x, halfSize.y } };
+
+		for (const auto method : { TriangulationMethod::EarClipping, TriangulationMethod::MonotonePartition })
+		{
+			const int nrOfBuilds = 20;
+			size_t nrOfTriangles = 0, nrOfLines = 0;
+			int nrOfNodes = 0;
+			const auto levelStart = std::chrono::high_resolution_clock::now();
+			for (int i = 0; i < nrOfBuilds; ++i)
+			{
+				const NavGraph levelGraph{ Elite::Polygon(levelBox), vObstacles, m_AgentRadius, method };
+				nrOfTriangles = levelGraph.GetNavMeshPolygon()->GetTriangles().size();
+				nrOfLines = levelGraph.GetNavMeshPolygon()->GetLines().size();
+				nrOfNodes = levelGraph.GetNrOfNodes();
+			}
+			const auto levelMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - levelStart).count() / nrOfBuilds;
+
+			std::cout << "[NavMesh Benchmark] " << levelName << (method == TriangulationMethod::EarClipping ? " (ear clipping): " : " (monotone): ")
+				<< vObstacles.size() << " obstacles, " << nrOfTriangles << " triangles, " << nrOfLines << " lines, " << nrOfNodes << " nodes, build "
+				<< levelMs << " ms" << std::endl;
+		}
+	}
+
+	// Large navmesh: the level's colliders plus a field of pillars, triangulated into a few thousand triangles.
+	// The grid is slightly skewed, exactly aligned pillars give collinear hole bridges the ear clipper can get stuck on
+	// (the monotone partition handles aligned grids, the skew keeps the comparison between both methods fair).
+	std::vector<NavigationColliderElement*> vPillars = {};
+	for (int c = 0; c < 20; ++c)
+	{
+		for (int r = 0; r < 14; ++r)
+			vPillars.push_back(new NavigationColliderElement(Elite::Vector2(90.f + c * 24.f + r * 0.37f, -260.f + r * 40.f + c * 0.53f), 6.0f, 12.0f));
+	}
+
+	std::list<Elite::Vector2> baseBox
+	{ { -100, 300 },{ -100, -300 },{ 600, -300 },{ 600, 300 } };
+
+	auto buildStart = std::chrono::high_resolution_clock::now();
+	const NavGraph navGraph{ Elite::Polygon(baseBox), m_AgentRadius };
+	const auto buildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+
+	buildStart = std::chrono::high_resolution_clock::now();
+	const NavGraph monotoneNavGraph{ Elite::Polygon(baseBox), m_AgentRadius, TriangulationMethod::MonotonePartition };
+	const auto monotoneBuildMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - buildStart).count();
+
+	// Random queries between points on the navmesh
+	const int nrOfQueries = 200;
+	std::mt19937 randomEngine{ 1 };
+	std::uniform_real_distribution<float> randomX{ -100.f, 600.f };
+	std::uniform_real_distribution<float> randomY{ -300.f, 300.f };
+	std::vector<std::pair<Elite::Vector2, Elite::Vector2>> vQueries = {};
+	while ((int)vQueries.size() < nrOfQueries)
+	{
+		const Elite::Vector2 start{ randomX(randomEngine), randomY(randomEngine) };
+		const Elite::Vector2 end{ randomX(randomEngine), randomY(randomEngine) };
+		if (navGraph.GetNavMeshPolygon()->GetTriangleFromPosition(start) && navGraph.GetNavMeshPolygon()->GetTriangleFromPosition(end))
+			vQueries.emplace_back(start, end);
+	}
+
+	// Triangle lookups: testing every triangle versus the polygon's grid
+	const Elite::Polygon* pNavMeshPolygon = navGraph.GetNavMeshPolygon();
+	int nrOfLinearHits = 0, nrOfGridHits = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (const auto& q : vQueries)
+	{
+		for (const auto t : pNavMeshPolygon->GetTriangles())
+		{
+			if (Elite::PointInTriangle(q.first, t->p1, t->p2, t->p3, false))
+			{
+				++nrOfLinearHits;
+				break;
+			}
+		}
+	}
+	const auto linearLookupUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& q : vQueries)
+		nrOfGridHits += pNavMeshPolygon->GetTriangleFromPosition(q.first) != nullptr;
+	const auto gridLookupUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	// What every query used to pay before searching: a deep copy of the whole graph
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < nrOfQueries; ++i)
+	{
+		auto pCopy = navGraph.Clone();
+	}
+	const auto cloneUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	NavMeshQuery query{};
+	std::vector<Elite::Vector2> path = {};
+	start = std::chrono::high_resolution_clock::now();
+	for (const auto& q : vQueries)
+		query.FindPath(q.first, q.second, &navGraph, path);
+	const auto queryUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	// Same queries spread over several threads, every thread has its own query object on the shared graph
+	const unsigned int nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+	start = std::chrono::high_resolution_clock::now();
+	std::vector<std::thread> vThreads = {};
+	for (unsigned int t = 0; t < nrOfThreads; ++t)
+	{
+		vThreads.emplace_back([&navGraph, &vQueries, t, nrOfThreads]()
+		{
+			NavMeshQuery threadQuery{};
+			std::vector<Elite::Vector2> threadPath = {};
+			for (size_t i = t; i < vQueries.size(); i += nrOfThreads)
+				threadQuery.FindPath(vQueries[i].first, vQueries[i].second, &navGraph, threadPath);
+		});
+	}
+	for (auto& thread : vThreads)
+		thread.join();
+	const auto parallelUs = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / nrOfQueries;
+
+	std::cout << "[NavMesh Benchmark] " << navGraph.GetNavMeshPolygon()->GetTriangles().size() << " triangles, " << navGraph.GetNrOfNodes()
+		<< " nodes, build " << buildMs << " ms | graph copy (old per-query overhead) " << cloneUs << " us | query " << queryUs
+		<< " us | " << nrOfThreads << " threads " << parallelUs << " us/query" << std::endl;
+	std::cout << "[NavMesh Benchmark] pillar field build: ear clipping " << buildMs << " ms, monotone " << monotoneBuildMs << " ms ("
+		<< monotoneNavGraph.GetNavMeshPolygon()->GetTriangles().size() << " triangles)" << std::endl;
+	std::cout << "[NavMesh Benchmark] triangle lookup: linear " << linearLookupUs << " us, grid " << gridLookupUs << " us ("
+		<< nrOfLinearHits << "/" << nrOfGridHits << " found)" << std::endl;
+
+	for (auto pPillar : vPillars)
+		SAFE_DELETE(pPillar);
+}
@@ -1,5 +1,5 @@
-#ifndef INFLUENCE_MAP_APPLICATION_H
-#define INFLUENCE_MAP_APPLICATION_H
+#ifndef NAVMESH_GRAPH_APPLICATION_H
+#define NAVMESH_GRAPH_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
@@ -8,6 +8,7 @@
 
 #include "framework\EliteAI\EliteGraphs\EliteGraphUtilities\EGraphRenderer.h"
 #include "framework\EliteAI\EliteNavigation\Algorithms\EPathSmoothing.h"
+#include "framework\EliteAI\EliteNavigation\Algorithms\ENavGraphPathfinding.h"
 
 class NavigationColliderElement;
 class SteeringAgent;
@@ -48,6 +49,7 @@ private:
 
 	// --Pathfinder--
 	std::vector<Elite::Vector2> m_vPath;
+	Elite::NavMeshQuery m_NavMeshQuery{};
 
 	// --Graph--
 	Elite::NavGraph* m_pNavGraph = nullptr;
@@ -61,8 +63,11 @@ private:
 	static bool sDrawPortals;
 	static bool sDrawFinalPath;
 	static bool sDrawNonOptimisedPath;
+	static bool sUseMonotoneTriangulation;
 
 	void UpdateImGui();
+	void RebuildNavGraph();
+	void RunBenchmark() const;
 private:
 	//C++ make the class non-copyable
 	App_NavMeshGraph(const App_NavMeshGraph&) = delete;
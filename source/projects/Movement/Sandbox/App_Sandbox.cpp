@@ -4,6 +4,9 @@
 //Includes
 #include "App_Sandbox.h"
 #include "SandboxAgent.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
+
+REGISTER_APP(App_Sandbox, "Sandbox")
 
 //Destructor
 App_Sandbox::~App_Sandbox()
@@ -6,8 +6,11 @@
 #include "../SteeringAgent.h"
 #include "CombinedSteeringBehaviors.h"
 #include "projects\Movement\SteeringBehaviors\Obstacle.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 
 using namespace Elite;
+REGISTER_APP(App_CombinedSteering, "CombinedSteering")
+
 App_CombinedSteering::~App_CombinedSteering()
 {	
 	SAFE_DELETE(m_pDrunkAgent);
@@ -1,5 +1,5 @@
-#ifndef STEERINGBEHAVIORS_APPLICATION_H
-#define STEERINGBEHAVIORS_APPLICATION_H
+#ifndef COMBINED_STEERING_APPLICATION_H
+#define COMBINED_STEERING_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
@@ -3,12 +3,20 @@
 
 //Includes
 #include "App_Flocking.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 #include "../SteeringAgent.h"
 #include "Flock.h"
 
 using namespace Elite;
+REGISTER_APP(App_Flocking, "Flocking")
+
+//Constructor & Destructor
+App_Flocking::App_Flocking(const AppParameters& params)
+{
+	m_FlockSize = params.GetInt("agents", m_FlockSize);
+	m_TrimWorldSize = params.GetFloat("worldSize", m_TrimWorldSize);
+}
 
-//Destructor
 App_Flocking::~App_Flocking()
 {	
 	SAFE_DELETE(m_pFlock);
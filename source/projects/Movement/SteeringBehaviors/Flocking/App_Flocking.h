@@ -1,9 +1,10 @@
-#ifndef STEERINGBEHAVIORS_APPLICATION_H
-#define STEERINGBEHAVIORS_APPLICATION_H
+#ifndef FLOCKING_APPLICATION_H
+#define FLOCKING_APPLICATION_H
 //-----------------------------------------------------------------
 // Includes & Forward Declarations
 //-----------------------------------------------------------------
 #include "framework/EliteInterfaces/EIApp.h"
+#include "framework/EliteInterfaces/EAppParameters.h"
 #include "../Steering/SteeringBehaviors.h"
 
 class SteeringAgent;
@@ -16,7 +17,8 @@ class App_Flocking final : public IApp
 {
 public:
 	//Constructor & Destructor
-	App_Flocking() = default;
+	//Parameters: agents, worldSize
+	explicit App_Flocking(const Elite::AppParameters& params);
 	virtual ~App_Flocking();
 
 	//App Functions
@@ -31,7 +33,7 @@ private:
 	bool m_VisualizeMouseTarget = true;
 	
 	float m_TrimWorldSize = 500.f;
-	int m_FlockSize = 5000;
+	int m_FlockSize = 10000;
 
 	Flock* m_pFlock = nullptr;
 	SteeringAgent* m_pAgentToEvade = nullptr;
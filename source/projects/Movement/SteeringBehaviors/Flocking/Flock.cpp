@@ -4,6 +4,7 @@
 #include "../SteeringAgent.h"
 #include "../Steering/SteeringBehaviors.h"
 #include "../CombinedSteering/CombinedSteeringBehaviors.h"
+#include <cstring>
 
 using namespace Elite;
 
@@ -18,12 +19,13 @@ Flock::Flock(
 	, m_TrimWorldSize{ worldSize }
 	, m_FlockSize{ flockSize }
 	, m_NeighborhoodRadius{ 5 }
-	, m_NrOfNeighbors{ 0 }
 	, m_pAgentToEvade{ pAgentToEvade }
 	, m_CellSpace{ }
-	, m_OldPositionAgent(m_FlockSize)
 {
-	m_CellSpace = CellSpace(m_TrimWorldSize, m_TrimWorldSize, 35, 35, m_FlockSize);
+	//Cells as wide as the neighborhood, so a query never looks at more than 3x3 cells
+	const int nrOfCells{ std::max(1, static_cast<int>(m_TrimWorldSize / (2.f * m_NeighborhoodRadius))) };
+	m_CellSpace = CellSpace(m_TrimWorldSize, m_TrimWorldSize, nrOfCells, nrOfCells, m_FlockSize);
+	m_FlockSoA = FlockSoA(m_TrimWorldSize, 2.f * m_NeighborhoodRadius);
 
 #pragma region Behaviors
 
@@ -32,6 +34,7 @@ Flock::Flock(
 	m_pCohesionBehavior = new Cohesion(this);
 	m_pVelMatchBehavior = new VelocityMatch(this);
 	m_pWanderBehavior = new Wander();
+	m_pFlockWanderBehavior = new FlockWander(this);
 	m_pEvadeBehavior = new Evade();
 
 	m_pBlendedSteering = new BlendedSteering({
@@ -39,7 +42,7 @@ Flock::Flock(
 		{m_pSeparationBehavior, 0.65f},
 		{m_pVelMatchBehavior, 0.5f},
 		{m_pSeekBehavior, 0.5f},
-		{m_pWanderBehavior, 0.5f}
+		{m_pFlockWanderBehavior, 0.5f}
 		});
 
 	m_pPrioritySteering = new PrioritySteering({ m_pEvadeBehavior, m_pBlendedSteering });
@@ -49,7 +52,10 @@ Flock::Flock(
 #pragma region Agents
 
 	m_Agents.resize(m_FlockSize);
-	m_Neighbors.resize(m_FlockSize);
+	m_SteeringOutputs.resize(m_FlockSize);
+	m_WanderAngles.resize(m_FlockSize);
+	m_NextWanderAngles.resize(m_FlockSize);
+	ResizeNeighborhoods(THREADPOOL->GetNrOfThreads());
 
 	for (int i{ 0 }; i < m_FlockSize; ++i)
 	{
@@ -59,7 +65,6 @@ Flock::Flock(
 		m_Agents[i]->SetMass(0.f);
 		m_Agents[i]->SetAutoOrient(true);
 		m_Agents[i]->SetBodyColor({ 1, 1, 0 });
-		m_OldPositionAgent[i] = m_Agents[i]->GetPosition();
 		m_CellSpace.AddAgent(m_Agents[i]);
 	}
 
@@ -80,6 +85,8 @@ Flock::~Flock()
 	SAFE_DELETE(m_pSeparationBehavior);
 	SAFE_DELETE(m_pVelMatchBehavior);
 	SAFE_DELETE(m_pSeekBehavior);
+	SAFE_DELETE(m_pWanderBehavior);
+	SAFE_DELETE(m_pFlockWanderBehavior);
 	SAFE_DELETE(m_pEvadeBehavior);
 	SAFE_DELETE(m_pBlendedSteering);
 	SAFE_DELETE(m_pPrioritySteering);
@@ -90,11 +97,13 @@ Flock::~Flock()
 		SAFE_DELETE(pAgent);
 	}
 	m_Agents.clear();
-	m_Neighbors.clear();
+	m_Neighborhoods.clear();
 }
 
 void Flock::Update(float deltaT)
 {
+	const auto updateStart = std::chrono::high_resolution_clock::now();
+
 	m_pAgentToEvade->Update(deltaT);
 	if (m_TrimWorld)
 	{
@@ -103,24 +112,29 @@ void Flock::Update(float deltaT)
 
 	UpdateEvadeTarget();
 
-	for(int i{0}; i < m_Agents.size(); ++i)
+	if (m_IsDataOriented)
 	{
-		
-		RegisterNeighbors(m_Agents[i]);
-		m_Agents[i]->Update(deltaT);
+		m_FlockSoA.Update(deltaT, GetDataOrientedSettings());
+		m_LastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - updateStart).count();
+		return;
+	}
 
-		m_CellSpace.UpdateAgentCell(m_Agents[i], m_OldPositionAgent[i]);
-		m_OldPositionAgent[i] = m_Agents[i]->GetPosition();
+	//Agents are bucketed by their position at the start of the frame
+	if (m_IsUsingSpacePartitioning)
+		m_CellSpace.UpdateCells(m_Agents);
 
-		if (m_TrimWorld)
-		{
-			m_Agents[i]->TrimToWorld(m_TrimWorldSize);
-		}
-	}
+	CalculateSteering(deltaT, m_IsMultithreaded ? THREADPOOL : nullptr);
+	ApplySteering(deltaT);
+
+	m_LastUpdateMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - updateStart).count();
 }
 
 void Flock::Render(float deltaT)
 {
+	//The agents are only up to date in data-oriented mode when they are rendered
+	if (m_IsDataOriented && m_FlockSize <= 100)
+		WriteBackAgents(m_FlockSize);
+
 	for (const auto pAgent : m_Agents)
 	{
 		if (m_FlockSize > 100) break;
@@ -132,15 +146,16 @@ void Flock::Render(float deltaT)
 		m_pAgentToEvade->Render(deltaT);
 	}
 
-	if(m_CanDebugRenderSP)
+	if(m_CanDebugRenderSP && !m_IsDataOriented)
 	{
 		m_CellSpace.RenderCells(m_Agents[0], m_NeighborhoodRadius);
 	}
 
-	if (m_CanDebugRender)
+	if (m_CanDebugRender && !m_IsDataOriented)
 	{
 		const float rayLength{ 5.f };
 		SteeringAgent* agentToDebug{m_Agents[0]};
+		GetNeighborhood().agentIndex = 0;
 		RegisterNeighbors(agentToDebug);
 
 		const Vector2 dirToAvgNeighborPos{ GetAverageNeighborPos() - agentToDebug->GetPosition() };
@@ -164,7 +179,7 @@ void Flock::Render(float deltaT)
 		DEBUGRENDERER2D->DrawDirection(agentPos, desiredVelocity, desiredVelocity.Magnitude(), { 1,1,0 }, 0.f);
 		DEBUGRENDERER2D->DrawDirection(agentPos, separationVelocity, rayLength, { 1,0,0 }, 0.f);
 
-		if(m_NrOfNeighbors > 0)
+		if(GetNrOfNeighbors() > 0)
 		{
 			DEBUGRENDERER2D->DrawDirection(agentPos, avgNeighborVel, rayLength, { 0,1,1 }, 0.f);
 			DEBUGRENDERER2D->DrawDirection(agentPos, dirToAvgNeighborPos, dirToAvgNeighborPos.Magnitude(), { 0,1,0 }, 0.f);
@@ -211,6 +226,7 @@ void Flock::UpdateAndRenderUI()
 	ImGui::Indent();
 	ImGui::Text("%.3f ms/frame", 1000.0f / ImGui::GetIO().Framerate);
 	ImGui::Text("%.1f FPS", ImGui::GetIO().Framerate);
+	ImGui::Text("%.3f ms flock update", m_LastUpdateMs);
 	ImGui::Unindent();
 
 	ImGui::Spacing();
@@ -237,6 +253,26 @@ void Flock::UpdateAndRenderUI()
 	{
 		ImGui::Checkbox("Debug Space Partitioning", &m_CanDebugRenderSP);
 	}
+	if (ImGui::Button("Benchmark Neighbors"))
+	{
+		RunNeighborBenchmark();
+	}
+
+	ImGui::Checkbox("Multithreaded", &m_IsMultithreaded);
+	if (ImGui::Button("Benchmark Threads"))
+	{
+		RunThreadScalingBenchmark();
+	}
+
+	bool isDataOriented{ m_IsDataOriented };
+	if (ImGui::Checkbox("Data-Oriented (SoA)", &isDataOriented))
+	{
+		SetDataOriented(isDataOriented);
+	}
+	if (ImGui::Button("Benchmark Data-Oriented"))
+	{
+		RunDataOrientedBenchmark();
+	}
 
 	ImGui::Spacing();
 	ImGui::Separator();
@@ -260,13 +296,14 @@ void Flock::UpdateAndRenderUI()
 
 void Flock::RegisterNeighbors(SteeringAgent* pAgent)
 {
+	Neighborhood& neighborhood{ GetNeighborhood() };
 	if(m_IsUsingSpacePartitioning)
 	{
-		m_NrOfNeighbors = m_CellSpace.RegisterNeighbors(pAgent, m_NeighborhoodRadius, m_Neighbors);
+		neighborhood.nrOfNeighbors = m_CellSpace.RegisterNeighbors(pAgent, m_NeighborhoodRadius, neighborhood.neighbors);
 		return;
 	}
 
-	m_NrOfNeighbors = 0;
+	neighborhood.nrOfNeighbors = 0;
 	const Vector2 agentPos = pAgent->GetPosition();
 
 	for (const auto pOtherAgent : m_Agents)
@@ -275,43 +312,198 @@ void Flock::RegisterNeighbors(SteeringAgent* pAgent)
 
 		if(DistanceSquared(agentPos, pOtherAgent->GetPosition()) <= Square(m_NeighborhoodRadius))
 		{
-			m_Neighbors[m_NrOfNeighbors] = pOtherAgent;
-			++m_NrOfNeighbors;
+			neighborhood.neighbors[neighborhood.nrOfNeighbors] = pOtherAgent;
+			++neighborhood.nrOfNeighbors;
 		}
 	}
 }
 
+void Flock::RunNeighborBenchmark()
+{
+	const bool wasUsingSpacePartitioning{ m_IsUsingSpacePartitioning };
+	const int nrOfRuns{ 5 };
+
+	//Brute force: every agent tests every other agent
+	m_IsUsingSpacePartitioning = false;
+	long long nrOfBruteForceNeighbors{ 0 };
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int run{ 0 }; run < nrOfRuns; ++run)
+	{
+		for (const auto pAgent : m_Agents)
+		{
+			RegisterNeighbors(pAgent);
+			nrOfBruteForceNeighbors += GetNrOfNeighbors();
+		}
+	}
+	const auto bruteForceMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfRuns;
+
+	//Uniform grid: rebuilding the cells is part of every frame, so it's timed as well
+	m_IsUsingSpacePartitioning = true;
+	long long nrOfGridNeighbors{ 0 };
+	start = std::chrono::high_resolution_clock::now();
+	for (int run{ 0 }; run < nrOfRuns; ++run)
+	{
+		m_CellSpace.UpdateCells(m_Agents);
+		for (const auto pAgent : m_Agents)
+		{
+			RegisterNeighbors(pAgent);
+			nrOfGridNeighbors += GetNrOfNeighbors();
+		}
+	}
+	const auto gridMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfRuns;
+
+	m_IsUsingSpacePartitioning = wasUsingSpacePartitioning;
+	GetNeighborhood().nrOfNeighbors = 0;
+
+	std::cout << "[Flock Benchmark] " << m_Agents.size() << " agents, neighbor search per frame: brute force " << bruteForceMs
+		<< " ms, space partitioning " << gridMs << " ms (" << nrOfBruteForceNeighbors / nrOfRuns << "/" << nrOfGridNeighbors / nrOfRuns
+		<< " neighbors found)" << std::endl;
+}
+
 Elite::Vector2 Flock::GetAverageNeighborPos() const
 {
-	if (m_NrOfNeighbors == 0) return Vector2();
+	const Neighborhood& neighborhood{ GetNeighborhood() };
+	if (neighborhood.nrOfNeighbors == 0) return Vector2();
 	Vector2 combinedPos{};
 	
-	for (int i{0}; i < m_NrOfNeighbors; ++i)
+	for (int i{0}; i < neighborhood.nrOfNeighbors; ++i)
 	{
-		combinedPos += m_Neighbors[i]->GetPosition();
+		combinedPos += neighborhood.neighbors[i]->GetPosition();
 	}
 
-	combinedPos /= static_cast<float>(m_NrOfNeighbors);
+	combinedPos /= static_cast<float>(neighborhood.nrOfNeighbors);
 	return combinedPos;
 }
 
 Elite::Vector2 Flock::GetAverageNeighborVel() const
 {
-	if (m_NrOfNeighbors == 0) return Vector2();
+	const Neighborhood& neighborhood{ GetNeighborhood() };
+	if (neighborhood.nrOfNeighbors == 0) return Vector2();
 
 	Vector2 combinedVelocity{};
-	for (int i{ 0 }; i < m_NrOfNeighbors; ++i)
+	for (int i{ 0 }; i < neighborhood.nrOfNeighbors; ++i)
 	{
-		combinedVelocity += m_Neighbors[i]->GetLinearVelocity();
+		combinedVelocity += neighborhood.neighbors[i]->GetLinearVelocity();
 	}
 
-	combinedVelocity /= static_cast<float>(m_NrOfNeighbors);
+	combinedVelocity /= static_cast<float>(neighborhood.nrOfNeighbors);
 	return combinedVelocity.GetNormalized();
 }
 
+float Flock::UpdateWanderAngle(float maxAngleChange)
+{
+	//Hash of the frame and the agent instead of a shared random engine, so the order agents are evaluated in doesn't matter
+	const int agentIndex{ GetNeighborhood().agentIndex };
+	unsigned int hash{ m_FrameCount * 0x9E3779B1u ^ (static_cast<unsigned int>(agentIndex) + 1u) * 0x85EBCA77u };
+	hash ^= hash >> 16;
+	hash *= 0x7FEB352Du;
+	hash ^= hash >> 15;
+	hash *= 0x846CA68Bu;
+	hash ^= hash >> 16;
+
+	const float randomClamped{ static_cast<float>(hash >> 8) / static_cast<float>(1u << 23) - 1.f };
+	m_NextWanderAngles[agentIndex] = m_WanderAngles[agentIndex] + randomClamped * maxAngleChange;
+	return m_NextWanderAngles[agentIndex];
+}
+
+void Flock::ResizeNeighborhoods(unsigned int nrOfThreads)
+{
+	if (m_Neighborhoods.size() >= nrOfThreads) return;
+
+	m_Neighborhoods.resize(nrOfThreads);
+	for (auto& neighborhood : m_Neighborhoods)
+		neighborhood.neighbors.resize(m_FlockSize);
+}
+
+void Flock::CalculateSteering(float deltaT, Elite::ThreadPool* pThreadPool)
+{
+	ResizeNeighborhoods(pThreadPool ? pThreadPool->GetNrOfThreads() : 1);
+
+	//Agents that don't wander this frame keep their angle
+	m_NextWanderAngles = m_WanderAngles;
+
+	auto calculateRange = [this, deltaT](int begin, int end)
+	{
+		Neighborhood& neighborhood{ GetNeighborhood() };
+		for (int i{ begin }; i < end; ++i)
+		{
+			neighborhood.agentIndex = i;
+			RegisterNeighbors(m_Agents[i]);
+			m_SteeringOutputs[i] = m_Agents[i]->CalculateSteering(deltaT);
+		}
+	};
+
+	if (pThreadPool)
+		pThreadPool->ParallelFor(m_FlockSize, 64, calculateRange);
+	else
+		calculateRange(0, m_FlockSize);
+}
+
+void Flock::ApplySteering(float deltaT)
+{
+	for (int i{ 0 }; i < m_FlockSize; ++i)
+	{
+		m_Agents[i]->ApplySteering(deltaT, m_SteeringOutputs[i]);
+
+		if (m_TrimWorld)
+		{
+			m_Agents[i]->TrimToWorld(m_TrimWorldSize);
+		}
+	}
+
+	m_WanderAngles.swap(m_NextWanderAngles);
+	++m_FrameCount;
+}
+
+void Flock::RunThreadScalingBenchmark()
+{
+	const float deltaT{ 1.f / 60.f };
+	const int nrOfRuns{ 10 };
+	const unsigned int maxNrOfThreads{ std::max(1u, std::thread::hardware_concurrency()) };
+
+	//Only the read phase is timed, it doesn't change the agents so every run starts from the same state
+	if (m_IsUsingSpacePartitioning)
+		m_CellSpace.UpdateCells(m_Agents);
+
+	std::vector<SteeringOutput> referenceOutputs{};
+	float referenceMs{ 0.f };
+	for (unsigned int nrOfThreads{ 1 }; nrOfThreads <= maxNrOfThreads; ++nrOfThreads)
+	{
+		Elite::ThreadPool threadPool{ nrOfThreads };
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (int run{ 0 }; run < nrOfRuns; ++run)
+			CalculateSteering(deltaT, &threadPool);
+		const auto steeringMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfRuns;
+
+		bool isIdentical{ true };
+		if (nrOfThreads == 1)
+		{
+			referenceOutputs = m_SteeringOutputs;
+			referenceMs = steeringMs;
+		}
+		else
+		{
+			//Bitwise, not within an epsilon
+			for (int i{ 0 }; i < m_FlockSize && isIdentical; ++i)
+			{
+				const SteeringOutput& output{ m_SteeringOutputs[i] };
+				const SteeringOutput& reference{ referenceOutputs[i] };
+				isIdentical = memcmp(&output.LinearVelocity, &reference.LinearVelocity, sizeof(Vector2)) == 0
+					&& memcmp(&output.AngularVelocity, &reference.AngularVelocity, sizeof(float)) == 0
+					&& output.IsValid == reference.IsValid;
+			}
+		}
+
+		std::cout << "[Flock Benchmark] " << m_FlockSize << " agents, " << nrOfThreads << " thread(s): " << steeringMs
+			<< " ms steering, speedup " << referenceMs / steeringMs << (isIdentical ? ", identical" : ", DIFFERENT") << std::endl;
+	}
+}
+
 void Flock::SetTarget_Seek(TargetData target)
 {
 	m_pSeekBehavior->SetTarget(target);
+	m_SeekTarget = target;
 }
 
 float* Flock::GetWeight(ISteeringBehavior* pBehavior) 
@@ -343,3 +535,104 @@ void Flock::UpdateEvadeTarget()
 	target.Orientation = m_pAgentToEvade->GetRotation();
 	m_pEvadeBehavior->SetTarget(target);
 }
+
+void Flock::SetDataOriented(bool isDataOriented)
+{
+	if (isDataOriented == m_IsDataOriented) return;
+	m_IsDataOriented = isDataOriented;
+
+	if (!m_IsDataOriented)
+	{
+		WriteBackAgents(m_FlockSize);
+		return;
+	}
+
+	m_FlockSoA.Clear();
+	for (const auto pAgent : m_Agents)
+	{
+		m_FlockSoA.AddBoid(pAgent->GetPosition(), pAgent->GetLinearVelocity(), pAgent->GetMaxLinearSpeed());
+		//Stop the rigid bodies, they're only moved on write back from now on
+		pAgent->SetLinearVelocity(Vector2{});
+	}
+}
+
+FlockSoASettings Flock::GetDataOrientedSettings()
+{
+	FlockSoASettings settings{};
+	settings.neighborhoodRadius = m_NeighborhoodRadius;
+
+	settings.cohesionWeight = *GetWeight(m_pCohesionBehavior);
+	settings.separationWeight = *GetWeight(m_pSeparationBehavior);
+	settings.velocityMatchWeight = *GetWeight(m_pVelMatchBehavior);
+	settings.seekWeight = *GetWeight(m_pSeekBehavior);
+	settings.wanderWeight = *GetWeight(m_pFlockWanderBehavior);
+	settings.seekTarget = m_SeekTarget.Position;
+
+	settings.wanderOffset = m_pFlockWanderBehavior->GetWanderOffset();
+	settings.wanderRadius = m_pFlockWanderBehavior->GetWanderRadius();
+	settings.wanderMaxAngleChange = m_pFlockWanderBehavior->GetMaxAngleChange();
+
+	settings.isEvading = m_pAgentToEvade != nullptr;
+	if (m_pAgentToEvade)
+	{
+		settings.evadeTargetPosition = m_pAgentToEvade->GetPosition();
+		settings.evadeTargetVelocity = m_pAgentToEvade->GetLinearVelocity();
+	}
+	settings.evadeRadius = m_pEvadeBehavior->GetEvadeRadius();
+
+	settings.trimWorld = m_TrimWorld;
+	settings.worldSize = m_TrimWorldSize;
+	return settings;
+}
+
+void Flock::WriteBackAgents(int nrOfAgents)
+{
+	for (int i{ 0 }; i < nrOfAgents; ++i)
+	{
+		SteeringAgent* const pAgent{ m_Agents[i] };
+		const Vector2 linearVelocity{ m_FlockSoA.GetLinearVelocity(i) };
+		pAgent->SetPosition(m_FlockSoA.GetPosition(i));
+		pAgent->SetLinearVelocity(m_IsDataOriented ? Vector2{} : linearVelocity);
+		if (pAgent->IsAutoOrienting())
+			pAgent->SetRotation(VectorToOrientation(linearVelocity));
+	}
+}
+
+void Flock::RunDataOrientedBenchmark()
+{
+	const FlockSoASettings settings{ GetDataOrientedSettings() };
+	const float deltaT{ 1.f / 60.f };
+	const int nrOfFrames{ 20 };
+
+	//Same boid density as this flock, so the neighbor counts stay comparable
+	for (const int nrOfBoids : { 1000, 10000, 100000 })
+	{
+		FlockSoASettings benchmarkSettings{ settings };
+		benchmarkSettings.worldSize = m_TrimWorldSize * sqrtf(static_cast<float>(nrOfBoids) / m_FlockSize);
+		benchmarkSettings.seekTarget = Vector2{ benchmarkSettings.worldSize, benchmarkSettings.worldSize } / 2.f;
+		benchmarkSettings.isEvading = false;
+
+		float updateMs[2]{};
+		for (int useSimd{ 0 }; useSimd < 2; ++useSimd)
+		{
+			FlockSoA flock{ benchmarkSettings.worldSize, 2.f * m_NeighborhoodRadius };
+			flock.SetUseSimd(useSimd != 0);
+
+			std::mt19937 randomEngine{ 1 };
+			std::uniform_real_distribution<float> randomPosition{ 0.f, benchmarkSettings.worldSize };
+			for (int i{ 0 }; i < nrOfBoids; ++i)
+				flock.AddBoid({ randomPosition(randomEngine), randomPosition(randomEngine) }, {}, m_Agents[0]->GetMaxLinearSpeed());
+
+			const auto start = std::chrono::high_resolution_clock::now();
+			for (int frame{ 0 }; frame < nrOfFrames; ++frame)
+				flock.Update(deltaT, benchmarkSettings);
+			updateMs[useSimd] = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / nrOfFrames;
+		}
+
+		std::cout << "[Flock Benchmark] data-oriented, " << nrOfBoids << " boids: " << updateMs[0] << " ms/update scalar, "
+			<< updateMs[1] << " ms/update SIMD" << std::endl;
+	}
+
+	if (!m_IsDataOriented)
+		std::cout << "[Flock Benchmark] agents, " << m_FlockSize << " boids: " << m_LastUpdateMs << " ms/update (last frame)" << std::endl;
+}
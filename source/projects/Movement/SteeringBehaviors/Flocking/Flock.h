@@ -2,6 +2,8 @@
 #include "../SteeringHelpers.h"
 #include "FlockingSteeringBehaviors.h"
 #include "../SpacePartitioning/SpacePartitioning.h"
+#include "FlockSoA.h"
+#include "framework/EliteThreading/EThreadPool.h"
 
 class ISteeringBehavior;
 class SteeringAgent;
@@ -24,14 +26,25 @@ public:
 	void UpdateAndRenderUI() ;
 	void Render(float deltaT);
 
+	// Neighbors are registered per thread: the behaviors evaluating an agent see the neighbors its thread registered
 	void RegisterNeighbors(SteeringAgent* pAgent);
-	int GetNrOfNeighbors() const { return m_NrOfNeighbors; }
-	const std::vector<SteeringAgent*>& GetNeighbors() const { return m_Neighbors; }
+	// Times the neighbor search of every agent with and without space partitioning, prints the results
+	void RunNeighborBenchmark();
+	// Times the data-oriented update at 1k, 10k and 100k boids without agents, prints the results
+	void RunDataOrientedBenchmark();
+	// Times the steering of every agent with 1 up to every hardware thread, checks the results are identical and prints them
+	void RunThreadScalingBenchmark();
+	int GetNrOfNeighbors() const { return GetNeighborhood().nrOfNeighbors; }
+	const std::vector<SteeringAgent*>& GetNeighbors() const { return GetNeighborhood().neighbors; }
 
 	Elite::Vector2 GetAverageNeighborPos() const;
 	Elite::Vector2 GetAverageNeighborVel() const;
 	float GetNeighborhoodRadius() { return m_NeighborhoodRadius; }
 
+	// Wander angle of the agent being evaluated turned by a random amount, which only depends on the frame and the agent.
+	// The new angle is used from the next frame on.
+	float UpdateWanderAngle(float maxAngleChange);
+
 	void SetTarget_Seek(TargetData target);
 	void SetWorldTrimSize(float size) { m_TrimWorldSize = size; }
 	
@@ -42,16 +55,37 @@ private:
 	//Datamembers
 	int m_FlockSize = 0;
 	std::vector<SteeringAgent*> m_Agents;
-	std::vector<SteeringAgent*> m_Neighbors;
-	std::vector<Elite::Vector2> m_OldPositionAgent;
+
+	// Agent being evaluated by a thread and its neighbors
+	struct Neighborhood
+	{
+		int agentIndex = 0;
+		std::vector<SteeringAgent*> neighbors;
+		int nrOfNeighbors = 0;
+	};
+	// One per thread, indexed by Elite::ThreadPool::GetCurrentThreadIndex()
+	std::vector<Neighborhood> m_Neighborhoods;
+
+	// Two-phase update: the steering of all agents is calculated from the previous frame (in parallel),
+	// then applied in agent order, so the result doesn't depend on the number of threads
+	bool m_IsMultithreaded = true;
+	std::vector<SteeringOutput> m_SteeringOutputs;
+	std::vector<float> m_WanderAngles;
+	std::vector<float> m_NextWanderAngles;
+	unsigned int m_FrameCount = 0;
 
 	bool m_CanDebugRender = false;
 	float m_NeighborhoodRadius = 5.f;
-	int m_NrOfNeighbors = 0;
 
 	bool m_IsUsingSpacePartitioning = true;
 	bool m_CanDebugRenderSP = false;
 
+	// Data-oriented mode: the boids live in m_FlockSoA, the agents are only updated to render them
+	bool m_IsDataOriented = false;
+	FlockSoA m_FlockSoA;
+	TargetData m_SeekTarget = {};
+	float m_LastUpdateMs = 0.f;
+
 	SteeringAgent* m_pAgentToEvade = nullptr;
 	
 	CellSpace m_CellSpace;
@@ -62,6 +96,7 @@ private:
 	Cohesion* m_pCohesionBehavior = nullptr;
 	VelocityMatch* m_pVelMatchBehavior = nullptr;
 	Wander* m_pWanderBehavior = nullptr;
+	FlockWander* m_pFlockWanderBehavior = nullptr;
 	Evade* m_pEvadeBehavior = nullptr;
 
 	BlendedSteering* m_pBlendedSteering = nullptr;
@@ -70,6 +105,18 @@ private:
 	float* GetWeight(ISteeringBehavior* pBehaviour);
 	void UpdateEvadeTarget();
 
+	const Neighborhood& GetNeighborhood() const { return m_Neighborhoods[Elite::ThreadPool::GetCurrentThreadIndex()]; }
+	Neighborhood& GetNeighborhood() { return m_Neighborhoods[Elite::ThreadPool::GetCurrentThreadIndex()]; }
+	void ResizeNeighborhoods(unsigned int nrOfThreads);
+	// Read phase: fills m_SteeringOutputs, the agents aren't changed. Runs on the calling thread without a pool.
+	void CalculateSteering(float deltaT, Elite::ThreadPool* pThreadPool);
+	// Write phase: moves the agents
+	void ApplySteering(float deltaT);
+
+	void SetDataOriented(bool isDataOriented);
+	FlockSoASettings GetDataOrientedSettings();
+	void WriteBackAgents(int nrOfAgents);
+
 	Flock(const Flock& other);
 	Flock& operator=(const Flock& other);
 };
\ No newline at end of file
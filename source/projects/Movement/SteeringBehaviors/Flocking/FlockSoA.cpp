@@ -0,0 +1,317 @@
+#include "stdafx.h"
+#include "FlockSoA.h"
+#include <climits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+using namespace Elite;
+
+namespace
+{
+	// Velocity of length maxSpeed towards direction, zero when there is no direction
+	Vector2 ScaledDirection(float x, float y, float maxSpeed)
+	{
+		const float lengthSquared = x * x + y * y;
+		if (lengthSquared <= 0.f)
+			return {};
+		const float scale = maxSpeed / sqrtf(lengthSquared);
+		return { x * scale, y * scale };
+	}
+}
+
+FlockSoA::FlockSoA(float worldSize, float cellSize)
+	: m_CellSize(cellSize)
+	, m_NrOfCols(std::max(1, static_cast<int>(ceilf(worldSize / cellSize))))
+	, m_NrOfRows(std::max(1, static_cast<int>(ceilf(worldSize / cellSize))))
+	, m_CellStartIndices(m_NrOfCols * m_NrOfRows + 1, 0)
+{
+}
+
+void FlockSoA::AddBoid(const Vector2& position, const Vector2& velocity, float maxLinearSpeed)
+{
+	m_PositionsX.push_back(position.x);
+	m_PositionsY.push_back(position.y);
+	m_VelocitiesX.push_back(velocity.x);
+	m_VelocitiesY.push_back(velocity.y);
+	m_MaxLinearSpeeds.push_back(maxLinearSpeed);
+	m_WanderAngles.push_back(0.f);
+}
+
+void FlockSoA::Clear()
+{
+	m_PositionsX.clear();
+	m_PositionsY.clear();
+	m_VelocitiesX.clear();
+	m_VelocitiesY.clear();
+	m_MaxLinearSpeeds.clear();
+	m_WanderAngles.clear();
+}
+
+void FlockSoA::Update(float deltaT, const FlockSoASettings& settings)
+{
+	const int nrOfBoids = GetNrOfBoids();
+	if (nrOfBoids == 0)
+		return;
+
+	SortIntoCells();
+
+	const float radiusSquared = settings.neighborhoodRadius * settings.neighborhoodRadius;
+	const float totalWeight = settings.cohesionWeight + settings.separationWeight + settings.velocityMatchWeight + settings.seekWeight + settings.wanderWeight;
+	const float weightScale = totalWeight > 0.f ? 1.f / totalWeight : 0.f;
+
+	//Steering reads the sorted copies only, so every boid sees the positions at the start of the update
+	for (int boid = 0; boid < nrOfBoids; ++boid)
+	{
+		const float x = m_PositionsX[boid];
+		const float y = m_PositionsY[boid];
+		const float maxSpeed = m_MaxLinearSpeeds[boid];
+		Vector2 desiredVelocity{};
+
+		const float toEvaderX = x - settings.evadeTargetPosition.x;
+		const float toEvaderY = y - settings.evadeTargetPosition.y;
+		const float evaderDistance = sqrtf(toEvaderX * toEvaderX + toEvaderY * toEvaderY);
+		if (settings.isEvading && evaderDistance <= settings.evadeRadius)
+		{
+			//Evade: flee from where the target will be
+			const float evadeFactor = maxSpeed > 0.f ? evaderDistance / maxSpeed : 0.f;
+			desiredVelocity = ScaledDirection(toEvaderX - settings.evadeTargetVelocity.x * evadeFactor,
+				toEvaderY - settings.evadeTargetVelocity.y * evadeFactor, maxSpeed);
+		}
+		else
+		{
+			NeighborSums sums{};
+			AccumulateNeighbors(boid, radiusSquared, sums);
+
+			Vector2 blended{};
+			if (sums.count > 0.f)
+			{
+				const float invCount = 1.f / sums.count;
+				blended += settings.cohesionWeight * ScaledDirection(sums.positionX * invCount - x, sums.positionY * invCount - y, maxSpeed);
+				blended += settings.separationWeight * ScaledDirection(-sums.separationX, -sums.separationY, maxSpeed);
+				blended += settings.velocityMatchWeight * ScaledDirection(sums.velocityX, sums.velocityY, maxSpeed);
+			}
+			blended += settings.seekWeight * ScaledDirection(settings.seekTarget.x - x, settings.seekTarget.y - y, maxSpeed);
+
+			//Wander: seek a point on a circle in front of the boid
+			float& wanderAngle = m_WanderAngles[boid];
+			wanderAngle += RandomClamped() * settings.wanderMaxAngleChange;
+			const Vector2 direction = ScaledDirection(m_VelocitiesX[boid], m_VelocitiesY[boid], 1.f);
+			const float wanderX = direction.x * settings.wanderOffset + cosf(wanderAngle) * settings.wanderRadius;
+			const float wanderY = direction.y * settings.wanderOffset + sinf(wanderAngle) * settings.wanderRadius;
+			blended += settings.wanderWeight * ScaledDirection(wanderX, wanderY, maxSpeed);
+
+			desiredVelocity = blended * weightScale;
+		}
+
+		//Same integration as SteeringAgent::Update with unit mass, the position step is what the physics world would do
+		float& velocityX = m_VelocitiesX[boid];
+		float& velocityY = m_VelocitiesY[boid];
+		velocityX += (desiredVelocity.x - velocityX) * deltaT;
+		velocityY += (desiredVelocity.y - velocityY) * deltaT;
+
+		float newX = x + velocityX * deltaT;
+		float newY = y + velocityY * deltaT;
+		if (settings.trimWorld)
+		{
+			if (newX > settings.worldSize) newX = 0.f;
+			else if (newX < 0.f) newX = settings.worldSize;
+			if (newY > settings.worldSize) newY = 0.f;
+			else if (newY < 0.f) newY = settings.worldSize;
+		}
+		m_PositionsX[boid] = newX;
+		m_PositionsY[boid] = newY;
+	}
+}
+
+void FlockSoA::SortIntoCells()
+{
+	const int nrOfBoids = GetNrOfBoids();
+	const int nrOfCells = m_NrOfCols * m_NrOfRows;
+	m_BoidCellIndices.resize(nrOfBoids);
+	m_SortedPositionsX.resize(nrOfBoids);
+	m_SortedPositionsY.resize(nrOfBoids);
+	m_SortedVelocitiesX.resize(nrOfBoids);
+	m_SortedVelocitiesY.resize(nrOfBoids);
+
+	//Counting sort, same as CellSpace::UpdateCells, but the boid data itself is moved into cell order
+	std::fill(m_CellStartIndices.begin(), m_CellStartIndices.end(), 0);
+	for (int boid = 0; boid < nrOfBoids; ++boid)
+	{
+		const int col = ConvertPositionToIndex(m_PositionsX[boid], m_NrOfCols);
+		const int row = ConvertPositionToIndex(m_PositionsY[boid], m_NrOfRows);
+		m_BoidCellIndices[boid] = row * m_NrOfCols + col;
+		++m_CellStartIndices[m_BoidCellIndices[boid]];
+	}
+
+	for (int c = 1; c < nrOfCells; ++c)
+		m_CellStartIndices[c] += m_CellStartIndices[c - 1];
+	m_CellStartIndices[nrOfCells] = nrOfBoids;
+
+	for (int boid = nrOfBoids - 1; boid >= 0; --boid)
+	{
+		const int slot = --m_CellStartIndices[m_BoidCellIndices[boid]];
+		m_SortedPositionsX[slot] = m_PositionsX[boid];
+		m_SortedPositionsY[slot] = m_PositionsY[boid];
+		m_SortedVelocitiesX[slot] = m_VelocitiesX[boid];
+		m_SortedVelocitiesY[slot] = m_VelocitiesY[boid];
+	}
+}
+
+void FlockSoA::AccumulateNeighbors(int boid, float radiusSquared, NeighborSums& sums) const
+{
+	const float x = m_PositionsX[boid];
+	const float y = m_PositionsY[boid];
+	const float radius = sqrtf(radiusSquared);
+
+	const int firstCol = ConvertPositionToIndex(x - radius, m_NrOfCols);
+	const int lastCol = ConvertPositionToIndex(x + radius, m_NrOfCols);
+	const int firstRow = ConvertPositionToIndex(y - radius, m_NrOfRows);
+	const int lastRow = ConvertPositionToIndex(y + radius, m_NrOfRows);
+
+	for (int row = firstRow; row <= lastRow; ++row)
+	{
+		//The cells of one row are next to each other, so are their boids
+		const int begin = m_CellStartIndices[row * m_NrOfCols + firstCol];
+		const int end = m_CellStartIndices[row * m_NrOfCols + lastCol + 1];
+		if (m_UseSimd)
+			AccumulateRangeSimd(x, y, radiusSquared, begin, end, sums);
+		else
+			AccumulateRange(x, y, radiusSquared, begin, end, sums);
+	}
+}
+
+void FlockSoA::AccumulateRange(float x, float y, float radiusSquared, int begin, int end, NeighborSums& sums) const
+{
+	//The boid itself (and any boid on the exact same spot) is at distance 0 and skipped
+	for (int i = begin; i < end; ++i)
+	{
+		const float dx = m_SortedPositionsX[i] - x;
+		const float dy = m_SortedPositionsY[i] - y;
+		const float distanceSquared = dx * dx + dy * dy;
+		if (distanceSquared >= radiusSquared || distanceSquared <= 0.f)
+			continue;
+
+		sums.count += 1.f;
+		sums.positionX += m_SortedPositionsX[i];
+		sums.positionY += m_SortedPositionsY[i];
+		sums.velocityX += m_SortedVelocitiesX[i];
+		sums.velocityY += m_SortedVelocitiesY[i];
+		sums.separationX += dx / distanceSquared;
+		sums.separationY += dy / distanceSquared;
+	}
+}
+
+#if defined(__AVX__)
+void FlockSoA::AccumulateRangeSimd(float x, float y, float radiusSquared, int begin, int end, NeighborSums& sums) const
+{
+	const __m256 boidX = _mm256_set1_ps(x);
+	const __m256 boidY = _mm256_set1_ps(y);
+	const __m256 radius2 = _mm256_set1_ps(radiusSquared);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.f);
+	__m256 count = zero, positionX = zero, positionY = zero, velocityX = zero, velocityY = zero, separationX = zero, separationY = zero;
+
+	int i = begin;
+	for (; i + 8 <= end; i += 8)
+	{
+		const __m256 otherX = _mm256_loadu_ps(&m_SortedPositionsX[i]);
+		const __m256 otherY = _mm256_loadu_ps(&m_SortedPositionsY[i]);
+		const __m256 dx = _mm256_sub_ps(otherX, boidX);
+		const __m256 dy = _mm256_sub_ps(otherY, boidY);
+		const __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		const __m256 mask = _mm256_and_ps(_mm256_cmp_ps(distanceSquared, radius2, _CMP_LT_OQ), _mm256_cmp_ps(distanceSquared, zero, _CMP_GT_OQ));
+
+		//Masked out lanes divide by zero, the and with the mask drops their result
+		const __m256 invDistanceSquared = _mm256_and_ps(mask, _mm256_div_ps(one, distanceSquared));
+		count = _mm256_add_ps(count, _mm256_and_ps(mask, one));
+		positionX = _mm256_add_ps(positionX, _mm256_and_ps(mask, otherX));
+		positionY = _mm256_add_ps(positionY, _mm256_and_ps(mask, otherY));
+		velocityX = _mm256_add_ps(velocityX, _mm256_and_ps(mask, _mm256_loadu_ps(&m_SortedVelocitiesX[i])));
+		velocityY = _mm256_add_ps(velocityY, _mm256_and_ps(mask, _mm256_loadu_ps(&m_SortedVelocitiesY[i])));
+		separationX = _mm256_add_ps(separationX, _mm256_mul_ps(dx, invDistanceSquared));
+		separationY = _mm256_add_ps(separationY, _mm256_mul_ps(dy, invDistanceSquared));
+	}
+
+	auto horizontalSum = [](__m256 v)
+	{
+		alignas(32) float lanes[8];
+		_mm256_store_ps(lanes, v);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+	};
+	sums.count += horizontalSum(count);
+	sums.positionX += horizontalSum(positionX);
+	sums.positionY += horizontalSum(positionY);
+	sums.velocityX += horizontalSum(velocityX);
+	sums.velocityY += horizontalSum(velocityY);
+	sums.separationX += horizontalSum(separationX);
+	sums.separationY += horizontalSum(separationY);
+
+	AccumulateRange(x, y, radiusSquared, i, end, sums);
+}
+#else
+void FlockSoA::AccumulateRangeSimd(float x, float y, float radiusSquared, int begin, int end, NeighborSums& sums) const
+{
+	const __m128 boidX = _mm_set1_ps(x);
+	const __m128 boidY = _mm_set1_ps(y);
+	const __m128 radius2 = _mm_set1_ps(radiusSquared);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	__m128 count = zero, positionX = zero, positionY = zero, velocityX = zero, velocityY = zero, separationX = zero, separationY = zero;
+
+	int i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		const __m128 otherX = _mm_loadu_ps(&m_SortedPositionsX[i]);
+		const __m128 otherY = _mm_loadu_ps(&m_SortedPositionsY[i]);
+		const __m128 dx = _mm_sub_ps(otherX, boidX);
+		const __m128 dy = _mm_sub_ps(otherY, boidY);
+		const __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+		const __m128 mask = _mm_and_ps(_mm_cmplt_ps(distanceSquared, radius2), _mm_cmpgt_ps(distanceSquared, zero));
+
+		//Masked out lanes divide by zero, the and with the mask drops their result
+		const __m128 invDistanceSquared = _mm_and_ps(mask, _mm_div_ps(one, distanceSquared));
+		count = _mm_add_ps(count, _mm_and_ps(mask, one));
+		positionX = _mm_add_ps(positionX, _mm_and_ps(mask, otherX));
+		positionY = _mm_add_ps(positionY, _mm_and_ps(mask, otherY));
+		velocityX = _mm_add_ps(velocityX, _mm_and_ps(mask, _mm_loadu_ps(&m_SortedVelocitiesX[i])));
+		velocityY = _mm_add_ps(velocityY, _mm_and_ps(mask, _mm_loadu_ps(&m_SortedVelocitiesY[i])));
+		separationX = _mm_add_ps(separationX, _mm_mul_ps(dx, invDistanceSquared));
+		separationY = _mm_add_ps(separationY, _mm_mul_ps(dy, invDistanceSquared));
+	}
+
+	auto horizontalSum = [](__m128 v)
+	{
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, v);
+		return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	};
+	sums.count += horizontalSum(count);
+	sums.positionX += horizontalSum(positionX);
+	sums.positionY += horizontalSum(positionY);
+	sums.velocityX += horizontalSum(velocityX);
+	sums.velocityY += horizontalSum(velocityY);
+	sums.separationX += horizontalSum(separationX);
+	sums.separationY += horizontalSum(separationY);
+
+	AccumulateRange(x, y, radiusSquared, i, end, sums);
+}
+#endif
+
+int FlockSoA::ConvertPositionToIndex(float pos, int nrOfCells) const
+{
+	//Positions outside of the world end up in the border cells
+	return Clamp(static_cast<int>(floorf(pos / m_CellSize)), 0, nrOfCells - 1);
+}
+
+float FlockSoA::RandomClamped()
+{
+	//xorshift, cheaper than rand() and the same sequence on every platform
+	m_RandomState ^= m_RandomState << 13;
+	m_RandomState ^= m_RandomState >> 17;
+	m_RandomState ^= m_RandomState << 5;
+	return static_cast<float>(m_RandomState) / static_cast<float>(UINT_MAX) * 2.f - 1.f;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include "framework/EliteMath/EVector2.h"
+
+// Settings of one data-oriented flock update, filled from the flock's steering behaviors every frame
+struct FlockSoASettings
+{
+	float neighborhoodRadius = 5.f;
+
+	// BlendedSteering weights
+	float cohesionWeight = 0.f;
+	float separationWeight = 0.f;
+	float velocityMatchWeight = 0.f;
+	float seekWeight = 0.f;
+	float wanderWeight = 0.f;
+
+	Elite::Vector2 seekTarget = {};
+
+	// Wander parameters
+	float wanderOffset = 6.f;
+	float wanderRadius = 4.f;
+	float wanderMaxAngleChange = 0.f;
+
+	// Evade has priority over the blended behaviors when the evade target is within the radius
+	bool isEvading = false;
+	Elite::Vector2 evadeTargetPosition = {};
+	Elite::Vector2 evadeTargetVelocity = {};
+	float evadeRadius = 10.f;
+
+	// Positions loop around [0, worldSize] like SteeringAgent::TrimToWorld
+	bool trimWorld = false;
+	float worldSize = 100.f;
+};
+
+// Data-oriented flock: boid positions, velocities and speeds in contiguous arrays (structure of arrays) instead of agents with
+// rigid bodies. Every update the boids are counting sorted into a uniform grid, copying their position and velocity along, so
+// the neighbors of a boid are read from a few contiguous ranges by an SSE (or AVX when compiled with /arch:AVX) kernel.
+// The steering follows Flock's behaviors: Evade before the blend of Cohesion, Separation, VelocityMatch, Seek and Wander.
+class FlockSoA final
+{
+public:
+	FlockSoA() = default;
+	FlockSoA(float worldSize, float cellSize);
+
+	void AddBoid(const Elite::Vector2& position, const Elite::Vector2& velocity, float maxLinearSpeed);
+	void Clear();
+
+	void Update(float deltaT, const FlockSoASettings& settings);
+
+	int GetNrOfBoids() const { return static_cast<int>(m_PositionsX.size()); }
+	Elite::Vector2 GetPosition(int boid) const { return { m_PositionsX[boid], m_PositionsY[boid] }; }
+	Elite::Vector2 GetLinearVelocity(int boid) const { return { m_VelocitiesX[boid], m_VelocitiesY[boid] }; }
+
+	// Scalar neighbor accumulation instead of the SIMD kernel, to compare both
+	void SetUseSimd(bool useSimd) { m_UseSimd = useSimd; }
+
+private:
+	// Sums over the neighbors of one boid
+	struct NeighborSums
+	{
+		float count = 0.f;
+		float positionX = 0.f, positionY = 0.f;
+		float velocityX = 0.f, velocityY = 0.f;
+		float separationX = 0.f, separationY = 0.f;
+	};
+
+	void SortIntoCells();
+	void AccumulateNeighbors(int boid, float radiusSquared, NeighborSums& sums) const;
+	void AccumulateRange(float x, float y, float radiusSquared, int begin, int end, NeighborSums& sums) const;
+	void AccumulateRangeSimd(float x, float y, float radiusSquared, int begin, int end, NeighborSums& sums) const;
+	int ConvertPositionToIndex(float pos, int nrOfCells) const;
+	float RandomClamped();
+
+	// Boids, in the order they were added
+	std::vector<float> m_PositionsX, m_PositionsY;
+	std::vector<float> m_VelocitiesX, m_VelocitiesY;
+	std::vector<float> m_MaxLinearSpeeds;
+	std::vector<float> m_WanderAngles;
+
+	// Grid, the boids of cell c are [m_CellStartIndices[c], m_CellStartIndices[c + 1]) in the sorted arrays
+	float m_CellSize = 10.f;
+	int m_NrOfCols = 1;
+	int m_NrOfRows = 1;
+	std::vector<int> m_CellStartIndices;
+	std::vector<int> m_BoidCellIndices;
+	std::vector<float> m_SortedPositionsX, m_SortedPositionsY;
+	std::vector<float> m_SortedVelocitiesX, m_SortedVelocitiesY;
+
+	bool m_UseSimd = true;
+	unsigned int m_RandomState = 0x9E3779B9u;
+};
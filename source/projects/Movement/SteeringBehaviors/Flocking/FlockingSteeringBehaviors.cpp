@@ -27,7 +27,7 @@ SteeringOutput Separation::CalculateSteering(float deltaT, SteeringAgent* pAgent
 
 	SteeringOutput steering{};
 	Elite::Vector2 totalForce{};
-	const std::vector<SteeringAgent*> neighbors{ m_pFlock->GetNeighbors() };
+	const std::vector<SteeringAgent*>& neighbors{ m_pFlock->GetNeighbors() };
 	const int nrOfNeighbors{ m_pFlock->GetNrOfNeighbors() };
 
 	for (int i {0}; i < nrOfNeighbors; ++i)
@@ -53,3 +53,17 @@ SteeringOutput VelocityMatch::CalculateSteering(float deltaT, SteeringAgent* pAg
 	steering.LinearVelocity = m_pFlock->GetAverageNeighborVel() * pAgent->GetMaxLinearSpeed();
 	return steering;
 }
+
+//*****************
+//WANDER (FLOCKING)
+SteeringOutput FlockWander::CalculateSteering(float deltaT, SteeringAgent* pAgent)
+{
+	//Seeks the point on the wander circle without storing it in m_Target, the behavior is shared by the whole flock
+	SteeringOutput steering{};
+	const float wanderAngle{ m_pFlock->UpdateWanderAngle(m_MaxAngleChange) };
+	const Elite::Vector2 circleCenter{ pAgent->GetPosition() + pAgent->GetDirection() * m_OffsetDistance };
+	const Elite::Vector2 desiredLocation{ cosf(wanderAngle) * m_Radius + circleCenter.x, sinf(wanderAngle) * m_Radius + circleCenter.y };
+
+	steering.LinearVelocity = (desiredLocation - pAgent->GetPosition()).GetNormalized() * pAgent->GetMaxLinearSpeed();
+	return steering;
+}
@@ -45,3 +45,18 @@ public:
 private:
 	Flock* m_pFlock = nullptr;
 };
+
+//WANDER - FLOCKING
+//*****************
+//Wander with an angle per agent, kept by the flock, so agents can be evaluated in any order and on any thread
+class FlockWander : public Wander
+{
+public:
+	FlockWander(Flock* pFlock) :m_pFlock(pFlock) {};
+
+	//Wander Behavior
+	SteeringOutput CalculateSteering(float deltaT, SteeringAgent* pAgent) override;
+
+private:
+	Flock* m_pFlock = nullptr;
+};
@@ -38,14 +38,16 @@ CellSpace::CellSpace(float width, float height, int rows, int cols, int maxEntit
 	, m_NrOfCols(cols)
 	, m_CellWidth(width / static_cast<float>(cols))
 	, m_CellHeight(height / static_cast<float>(rows))
+	, m_CellStartIndices(rows * cols + 1, 0)
 	, m_Neighbors(maxEntities)
 	, m_NrOfNeighbors(0)
 {
-	for (int x{0}; x < m_NrOfRows; ++x)
+	//Cell index = row * cols + col, the layout PositionToIndex computes
+	for (int row{0}; row < m_NrOfRows; ++row)
 	{
-		for (int y{0}; y < m_NrOfCols; ++y)
+		for (int col{0}; col < m_NrOfCols; ++col)
 		{
-			m_Cells.emplace_back(Cell(m_CellWidth * x, m_CellHeight * y, m_CellWidth, m_CellHeight));
+			m_Cells.emplace_back(Cell(m_CellWidth * col, m_CellHeight * row, m_CellWidth, m_CellHeight));
 		}
 	}
 }
@@ -53,64 +55,76 @@ CellSpace::CellSpace(float width, float height, int rows, int cols, int maxEntit
 void CellSpace::AddAgent(SteeringAgent* agent)
 {
 	const int index{ Elite::randomInt(m_Cells.size()) };
-
-	
-	m_Cells[0].agents.emplace_back(agent);
 	agent->SetPosition(m_Cells[index].GetRectPoints()[0]);
 }
 
-void CellSpace::UpdateAgentCell(SteeringAgent* agent, Elite::Vector2 oldPos)
+void CellSpace::UpdateCells(const std::vector<SteeringAgent*>& agents)
 {
-	const int currentPosIndex{ PositionToIndex(agent->GetPosition()) };
-	const int oldPosIndex{ PositionToIndex(oldPos) };
+	const int nrOfAgents{ static_cast<int>(agents.size()) };
+	m_AgentCellIndices.resize(nrOfAgents);
+	m_CellAgents.resize(nrOfAgents);
 
-	if (currentPosIndex == oldPosIndex) return;
+	//Counting sort on cell index: count the agents per cell...
+	std::fill(m_CellStartIndices.begin(), m_CellStartIndices.end(), 0);
+	for (int i{0}; i < nrOfAgents; ++i)
+	{
+		m_AgentCellIndices[i] = PositionToIndex(agents[i]->GetPosition());
+		++m_CellStartIndices[m_AgentCellIndices[i]];
+	}
 
-	m_Cells[oldPosIndex].agents.remove(agent);
-	m_Cells[currentPosIndex].agents.emplace_back(agent);
-}
+	//...turn the counts into the end of every cell's range...
+	for (size_t c{1}; c < m_Cells.size(); ++c)
+		m_CellStartIndices[c] += m_CellStartIndices[c - 1];
+	m_CellStartIndices[m_Cells.size()] = nrOfAgents;
 
-int CellSpace::RegisterNeighbors(SteeringAgent* pAgent, float queryRadius, std::vector<SteeringAgent*>& neighbors)
-{
-	RegisterNeighbors(pAgent, queryRadius);
-	neighbors = m_Neighbors;
-	return m_NrOfNeighbors;
+	//...and fill every range back to front, which leaves the start of the range behind
+	for (int i{nrOfAgents - 1}; i >= 0; --i)
+		m_CellAgents[--m_CellStartIndices[m_AgentCellIndices[i]]] = agents[i];
 }
 
-void CellSpace::RegisterNeighbors(SteeringAgent* agent, float queryRadius)
+int CellSpace::RegisterNeighbors(SteeringAgent* pAgent, float queryRadius, std::vector<SteeringAgent*>& neighbors) const
 {
-	m_NrOfNeighbors = 0;
+	int nrOfNeighbors{ 0 };
 
-	const Elite::Vector2 agentPos{ agent->GetPosition() };
-	const Elite::Rect radiusBB
-	{
-		{agentPos.x - queryRadius, agentPos.y - queryRadius},
-		queryRadius,
-		queryRadius
-	};
+	const Elite::Vector2 agentPos{ pAgent->GetPosition() };
+	const float queryRadiusSquared{ Elite::Square(queryRadius) };
+
+	//Only the cells overlapping the bounding box of the query radius
+	const int firstCol{ ConvertPositionToIndex(agentPos.x - queryRadius, m_CellWidth, m_NrOfCols) };
+	const int lastCol{ ConvertPositionToIndex(agentPos.x + queryRadius, m_CellWidth, m_NrOfCols) };
+	const int firstRow{ ConvertPositionToIndex(agentPos.y - queryRadius, m_CellHeight, m_NrOfRows) };
+	const int lastRow{ ConvertPositionToIndex(agentPos.y + queryRadius, m_CellHeight, m_NrOfRows) };
 
-	for(const Cell& cell : m_Cells)
+	for (int row{firstRow}; row <= lastRow; ++row)
 	{
-		if(IsOverlapping(radiusBB, cell.boundingBox))
+		//The cells of one row are next to each other, so are their agents
+		const int begin{ m_CellStartIndices[row * m_NrOfCols + firstCol] };
+		const int end{ m_CellStartIndices[row * m_NrOfCols + lastCol + 1] };
+		for (int i{begin}; i < end; ++i)
 		{
-			for(SteeringAgent* neighbor : cell.agents)
-			{
-				if (neighbor == agent) continue;
+			SteeringAgent* const neighbor{ m_CellAgents[i] };
+			if (neighbor == pAgent) continue;
 
-				if(DistanceSquared(agentPos, neighbor->GetPosition()) < Elite::Square(queryRadius))
-				{
-					m_Neighbors[m_NrOfNeighbors] = neighbor;
-					++m_NrOfNeighbors;
-				}
+			if (DistanceSquared(agentPos, neighbor->GetPosition()) < queryRadiusSquared)
+			{
+				neighbors[nrOfNeighbors] = neighbor;
+				++nrOfNeighbors;
 			}
 		}
 	}
+	return nrOfNeighbors;
+}
+
+void CellSpace::RegisterNeighbors(SteeringAgent* agent, float queryRadius)
+{
+	m_NrOfNeighbors = RegisterNeighbors(agent, queryRadius, m_Neighbors);
 }
 
 void CellSpace::EmptyCells()
 {
-	for (Cell& c : m_Cells)
-		c.agents.clear();
+	std::fill(m_CellStartIndices.begin(), m_CellStartIndices.end(), 0);
+	m_CellAgents.clear();
+	m_AgentCellIndices.clear();
 }
 
 void CellSpace::RenderCells(const SteeringAgent* pAgent, float queryRadius) const
@@ -119,14 +133,15 @@ void CellSpace::RenderCells(const SteeringAgent* pAgent, float queryRadius) cons
 	const Elite::Rect radiusBB
 	{
 		{agentPos.x - queryRadius, agentPos.y - queryRadius},
-		queryRadius,
-		queryRadius
+		queryRadius * 2.f,
+		queryRadius * 2.f
 	};
 
-	for (Cell _cell : m_Cells)
+	for (int i{0}; i < static_cast<int>(m_Cells.size()); ++i)
 	{
+		const Cell& _cell{ m_Cells[i] };
 		auto* poly = new Elite::Polygon(_cell.GetRectPoints());
-		std::string s = std::to_string(_cell.agents.size());
+		std::string s = std::to_string(GetNrOfAgentsInCell(i));
 
 		if (IsOverlapping(radiusBB, _cell.boundingBox))
 			DEBUGRENDERER2D->DrawPolygon(poly, {0.f, 0.f, 1.f}, 0.f);
@@ -146,23 +161,19 @@ void CellSpace::RenderCells(const SteeringAgent* pAgent, float queryRadius) cons
 }
 
 int CellSpace::PositionToIndex(const Elite::Vector2 pos) const
-{;
-	for(int i{0}; i < m_Cells.size(); ++i)
-	{
-		if(
-			pos.x >= m_Cells[i].boundingBox.bottomLeft.x &&
-			pos.x <= m_Cells[i].boundingBox.bottomLeft.x + m_Cells[i].boundingBox.width &&
-			pos.y >= m_Cells[i].boundingBox.bottomLeft.y &&
-			pos.y <= m_Cells[i].boundingBox.bottomLeft.y + m_Cells[i].boundingBox.height
-			)
-		{
-			return i;
-		}
-	}
-	return 0;
+{
+	const int col{ ConvertPositionToIndex(pos.x, m_CellWidth, m_NrOfCols) };
+	const int row{ ConvertPositionToIndex(pos.y, m_CellHeight, m_NrOfRows) };
+	return row * m_NrOfCols + col;
+}
+
+int CellSpace::ConvertPositionToIndex(const float pos, const float cellSize, const int nrOfCells) const
+{
+	//Positions outside of the space end up in the border cells
+	return Elite::Clamp(static_cast<int>(floorf(pos / cellSize)), 0, nrOfCells - 1);
 }
 
-int CellSpace::ConvertPositionToIndex(const float pos, const float CellSize, const int nrOfCells) const
+int CellSpace::GetNrOfAgentsInCell(int cellIndex) const
 {
-	return 0;
+	return m_CellStartIndices[cellIndex + 1] - m_CellStartIndices[cellIndex];
 }
\ No newline at end of file
@@ -26,23 +26,28 @@ struct Cell
 
 	std::vector<Elite::Vector2> GetRectPoints() const;
 	
-	// all the agents currently in this cell
-	std::list<SteeringAgent*> agents;
 	Elite::Rect boundingBox;
 };
 
 // --- Partitioned Space ---
 // -------------------------
+// Uniform grid over [0, width] x [0, height], positions outside of it belong to the closest border cell.
+// The agents are bucketed once per frame with a counting sort (UpdateCells): the agents of cell i are
+// m_CellAgents[m_CellStartIndices[i], m_CellStartIndices[i + 1]), so a query only reads the contiguous
+// ranges of the cells covered by its radius.
 class CellSpace
 {
 public:
 	CellSpace() = default;
 	CellSpace(float width, float height, int rows, int cols, int maxEntities);
 
+	// Spawns the agent at a random cell, it's bucketed on the next UpdateCells
 	void AddAgent(SteeringAgent* agent);
-	void UpdateAgentCell(SteeringAgent* agent, Elite::Vector2 oldPos);
+	// Buckets all agents by their current position, call once per frame before the queries
+	void UpdateCells(const std::vector<SteeringAgent*>& agents);
 
-	int RegisterNeighbors(SteeringAgent* pAgent, float queryRadius, std::vector<SteeringAgent*>& neighbors);
+	// Writes the neighbors into the given buffer (sized for all entities), returns how many were found
+	int RegisterNeighbors(SteeringAgent* pAgent, float queryRadius, std::vector<SteeringAgent*>& neighbors) const;
 	void RegisterNeighbors(SteeringAgent* agent, float queryRadius);
 	const std::vector<SteeringAgent*>& GetNeighbors() const { return m_Neighbors; }
 	int GetNrOfNeighbors() const { return m_NrOfNeighbors; }
@@ -65,6 +70,11 @@ private:
 	float m_CellWidth;
 	float m_CellHeight;
 
+	// Agents sorted per cell, rebuilt every frame
+	std::vector<int> m_CellStartIndices;
+	std::vector<SteeringAgent*> m_CellAgents;
+	std::vector<int> m_AgentCellIndices;
+
 	// Members to avoid memory allocation on every frame
 	std::vector<SteeringAgent*> m_Neighbors;
 	int m_NrOfNeighbors;
@@ -72,4 +82,5 @@ private:
 	// Helper functions
 	int PositionToIndex(const Elite::Vector2 pos) const;
 	int ConvertPositionToIndex(const float pos, const float cellSize, const int nrOfCells) const;
-};
+	int GetNrOfAgentsInCell(int cellIndex) const;
+};
\ No newline at end of file
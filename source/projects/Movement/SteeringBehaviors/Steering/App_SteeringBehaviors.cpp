@@ -6,8 +6,10 @@
 #include "../SteeringAgent.h"
 #include "SteeringBehaviors.h"
 #include "../Obstacle.h"
+#include "framework/EliteInterfaces/EAppRegistry.h"
 
 using namespace Elite;
+REGISTER_APP(App_SteeringBehaviors, "Steering")
 
 //Destructor
 App_SteeringBehaviors::~App_SteeringBehaviors()
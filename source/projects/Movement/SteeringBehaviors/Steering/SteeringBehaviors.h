@@ -94,6 +94,9 @@ public:
 	void SetWanderOffset(float offset) { m_OffsetDistance = offset; }
 	void SetWanderRadius(float radius) { m_Radius = radius; }
 	void SetMaxAngleChange(float rad) { m_MaxAngleChange = rad; }
+	float GetWanderOffset() const { return m_OffsetDistance; }
+	float GetWanderRadius() const { return m_Radius; }
+	float GetMaxAngleChange() const { return m_MaxAngleChange; }
 
 protected:
 	float m_OffsetDistance = 6.f;
@@ -119,6 +122,7 @@ public:
 
 	SteeringOutput CalculateSteering(float deltaT, SteeringAgent* pAgent) override;
 	void SetEvadeRadius(float evadeRadius) { m_EvadeRadius = evadeRadius; }
+	float GetEvadeRadius() const { return m_EvadeRadius; }
 
 protected:
 	float m_EvadeRadius = 10.f;
@@ -26,6 +26,11 @@ public:
 	void Update(float dt) override;
 	void Render(float dt) override;
 
+	//Update in two steps: calculating the steering only reads the agent and its surroundings,
+	//applying it moves the agent. Lets a group calculate all steering before any agent moves.
+	SteeringOutput CalculateSteering(float dt);
+	void ApplySteering(float dt, SteeringOutput output);
+
 	float GetMaxLinearSpeed() const { return m_MaxLinearSpeed; }
 	void SetMaxLinearSpeed(float maxLinSpeed) { m_MaxLinearSpeed = maxLinSpeed; }
 
@@ -43,7 +43,7 @@ void AgarioAgent::Update(float dt)
 		m_ToUpgrade = 0.0f;
 	}
 
-	if(m_DecisionMaking)
+	if(m_DecisionMaking && m_AutoUpdateDecisionMaking)
 		m_DecisionMaking->Update(dt);
 
 	SteeringAgent::Update(dt);
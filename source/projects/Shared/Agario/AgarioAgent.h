@@ -33,6 +33,9 @@ public:
 	void MarkForDestroy();
 	bool CanBeDestroyed();
 	void SetDecisionMaking(Elite::IDecisionMaking* decisionMakingStructure);
+	Elite::IDecisionMaking* GetDecisionMaking() const { return m_DecisionMaking; }
+	//Disable when the decision making is updated outside of the agent (for instance in a batch)
+	void SetAutoUpdateDecisionMaking(bool autoUpdate) { m_AutoUpdateDecisionMaking = autoUpdate; }
 	
 	void SetToWander();
 	void SetToSeek(Elite::Vector2 seekPos);
@@ -41,6 +44,7 @@ public:
 
 private:
 	Elite::IDecisionMaking* m_DecisionMaking = nullptr;
+	bool m_AutoUpdateDecisionMaking = true;
 	float m_ToUpgrade = 0.0f;
 	bool m_ToDestroy = false;
 	float m_SpeedBase = 25.f;
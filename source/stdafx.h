@@ -64,11 +64,11 @@ struct Elite_Exception
 #define ALIGN_16 __declspec(align(16))
 #define ALIGN_32 __declspec(align(32))
 #define ALIGN_64 __declspec(align(64))
-#elif
-#define ELITE_ALIGN_8 
-#define ELITE_ALIGN_16
-#define ELITE_ALIGN_32
-#define ELITE_ALIGN_64
+#else
+#define ALIGN_8  __attribute__((aligned(8)))
+#define ALIGN_16 __attribute__((aligned(16)))
+#define ALIGN_32 __attribute__((aligned(32)))
+#define ALIGN_64 __attribute__((aligned(64)))
 #endif
 
 //=== Function that returns a FNV-1a compile-time hash of a literal string, using template to fix size based on input ===
@@ -121,12 +121,19 @@ extern bool gRequestShutdown;
 /* --- DEFINES --- */
 #define USE_BOX2D
 #define USE_VLD
+//Remove to compile the ELITE_PROFILE_SCOPE zones out (see EProfiler.h)
+#define USE_PROFILER
+//Define ELITE_HEADLESS in the build (/D ELITE_HEADLESS, -DELITE_HEADLESS) for the headless platform:
+//no window, SDL or OpenGL, main runs an app for a number of fixed timesteps and reports its update times (see EHeadlessRunner.h)
 
 /* --- PLATFORMS --- */
 #define PLATFORM_WINDOWS 0
 #define PLATFORM_PS4 1
+#define PLATFORM_HEADLESS 2
 
-#ifdef _WIN32
+#ifdef ELITE_HEADLESS
+#define PLATFORM_ID PLATFORM_HEADLESS
+#elif _WIN32
 #define PLATFORM_ID PLATFORM_WINDOWS
 #elif _ORBIS
 #define PLATFORM_ID PLATFORM_PS4
@@ -148,12 +155,15 @@ extern bool gRequestShutdown;
 #pragma warning(pop)
 #endif
 
-#ifdef _WIN32
+#if (PLATFORM_ID == PLATFORM_WINDOWS)
 //OpenGl
 #include <GL/gl3w.h>
 //SDL Window
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_syswm.h>
+#endif
+
+#if (PLATFORM_ID == PLATFORM_WINDOWS) || (PLATFORM_ID == PLATFORM_HEADLESS)
 //ImGUI
 #pragma warning(push)
 #pragma warning(disable: 26495)
@@ -168,6 +178,7 @@ extern bool gRequestShutdown;
 ===========================================================================*/
 #pragma region FrameworkIncludes
 #include "framework/EliteHelpers/ESingleton.h"
+#include "framework/EliteProfiling/EProfiler.h"
 #include "framework/EliteMath/EMath.h"
 #include "framework/ElitePhysics/EPhysics.h"
 #include "framework/EliteInput/EInputCodes.h"
@@ -178,6 +189,8 @@ extern bool gRequestShutdown;
 #include "framework/EliteRendering/ERendering.h"
 #include "framework/EliteUI/EImmediateUI.h"
 #include "framework/EliteAI/EliteDecisionMaking/EDecisionMaking.h"
+#include "framework/EliteThreading/EThreadPool.h"
+#include "framework/EliteThreading/EJobSystem.h"
 #pragma endregion //FrameworkIncludes
 
 /* --- FRAMEWORK MACROS ---- */
@@ -186,6 +199,10 @@ extern bool gRequestShutdown;
 #define DEBUGRENDERER2D EliteDebugRenderer2D::GetInstance()
 #define PHYSICSWORLD PhysicsWorld::GetInstance()
 #define LEVELLOADER LevelLoader::GetInstance()
+#define THREADPOOL Elite::ThreadPool::GetInstance()
+#define JOBSYSTEM Elite::EJobSystem::GetInstance()
+#define APPREGISTRY Elite::AppRegistry::GetInstance()
+#define PROFILER Elite::Profiler::GetInstance()
 
 /* --- PLATFORM SPECIFIC INCLUDES --- */
 #pragma region PlatformIncludes